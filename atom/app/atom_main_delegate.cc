@@ -13,6 +13,7 @@
 #include "atom/browser/relauncher.h"
 #include "atom/common/google_api_key.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "atom/renderer/atom_renderer_client.h"
 #include "atom/renderer/atom_sandboxed_renderer_client.h"
 #include "atom/utility/atom_content_utility_client.h"
@@ -67,6 +68,8 @@ AtomMainDelegate::AtomMainDelegate() {}
 AtomMainDelegate::~AtomMainDelegate() {}
 
 bool AtomMainDelegate::BasicStartupComplete(int* exit_code) {
+  StartupTimeline::GetInstance()->AddMark("main-delegate");
+
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
   logging::LoggingSettings settings;
@@ -16,6 +16,7 @@
 #include "atom/browser/login_handler.h"
 #include "atom/browser/relauncher.h"
 #include "atom/common/atom_command_line.h"
+#include "atom/common/memory_usage.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
@@ -49,6 +50,7 @@
 #include "net/ssl/client_cert_identity.h"
 #include "net/ssl/ssl_cert_request_info.h"
 #include "services/network/public/cpp/network_switches.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
 #include "services/service_manager/sandbox/switches.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/gfx/image/image.h"
@@ -549,6 +551,40 @@ void OnIconDataAvailable(v8::Isolate* isolate,
   }
 }
 
+using ProcessMemoryMap =
+    std::unordered_map<base::ProcessId, std::unique_ptr<base::DictionaryValue>>;
+
+void OnProcessMemoryDump(
+    scoped_refptr<util::Promise> promise,
+    std::unique_ptr<ProcessMemoryMap> processes,
+    bool success,
+    std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump) {
+  v8::Isolate* isolate = promise->isolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  if (!success || !dump) {
+    promise->RejectWithErrorMessage("Failed to dump the memory of processes");
+    return;
+  }
+
+  base::ListValue result;
+  for (const auto& process_dump : dump->process_dumps()) {
+    auto iter = processes->find(process_dump.pid());
+    if (iter == processes->end())
+      continue;
+    base::DictionaryValue* memory = nullptr;
+    if (!iter->second->GetDictionary("memory", &memory))
+      continue;
+    const auto& os_dump = process_dump.os_dump();
+    memory->SetInteger("residentSet", os_dump.resident_set_kb);
+    memory->SetInteger("private", os_dump.private_footprint_kb);
+    memory->SetInteger("shared", os_dump.shared_footprint_kb);
+    result.Append(std::move(iter->second));
+  }
+  promise->Resolve(result);
+}
+
 }  // namespace
 
 App::App(v8::Isolate* isolate) {
@@ -592,6 +628,9 @@ void App::OnQuit() {
   int exitCode = AtomBrowserMainParts::Get()->GetExitCode();
   Emit("quit", exitCode);
 
+  // The watchdog observes the message loop, which is about to go away.
+  main_thread_watchdog_.reset();
+
   if (process_singleton_) {
     process_singleton_->Cleanup();
     process_singleton_.reset();
@@ -1157,6 +1196,88 @@ std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+v8::Local<v8::Promise> App::GetProcessMemoryInfo(v8::Isolate* isolate) {
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+  auto* instrumentation =
+      memory_instrumentation::MemoryInstrumentation::GetInstance();
+  if (!Browser::Get()->is_ready() || !instrumentation) {
+    promise->RejectWithErrorMessage(
+        "Memory info is only available after app is ready");
+    return promise->GetHandle();
+  }
+
+  // The OS memory of every process comes from a single global dump, the rest
+  // is known before requesting it.
+  auto processes = std::make_unique<ProcessMemoryMap>();
+  for (const auto& process_metric : app_metrics_) {
+    auto process = std::make_unique<base::DictionaryValue>();
+    process->SetInteger("pid", process_metric.second->pid);
+    process->SetString("type", content::GetProcessTypeNameInEnglish(
+                                   process_metric.second->type));
+
+    auto memory = std::make_unique<base::DictionaryValue>();
+#if defined(OS_LINUX)
+    memory->SetDouble(
+        "swapped",
+        static_cast<double>(process_metric.second->metrics->GetVmSwapBytes() >>
+                            10));
+#endif
+    process->Set("memory", std::move(memory));
+
+    if (process_metric.second->type == content::PROCESS_TYPE_BROWSER)
+      process->Set("v8", GetV8MemoryUsage(isolate));
+
+    (*processes)[process_metric.first] = std::move(process);
+  }
+
+  instrumentation->RequestGlobalDump(
+      std::vector<std::string>(),
+      base::Bind(&OnProcessMemoryDump, promise, base::Passed(&processes)));
+  return promise->GetHandle();
+}
+
+void App::StartMainThreadWatchdog(mate::Arguments* args) {
+  int threshold = 500;
+  int crash_dump_threshold = 0;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("threshold", &threshold);
+    options.Get("crashDumpThreshold", &crash_dump_threshold);
+  }
+  if (threshold <= 0 || crash_dump_threshold < 0) {
+    args->ThrowError("Thresholds must be positive");
+    return;
+  }
+
+  main_thread_watchdog_.reset();
+  main_thread_watchdog_ = std::make_unique<MainThreadWatchdog>(
+      isolate(), base::TimeDelta::FromMilliseconds(threshold),
+      base::TimeDelta::FromMilliseconds(crash_dump_threshold),
+      base::Bind(&App::OnMainThreadLongTask, base::Unretained(this)));
+}
+
+void App::StopMainThreadWatchdog() {
+  main_thread_watchdog_.reset();
+}
+
+void App::OnMainThreadLongTask(const MainThreadWatchdog::LongTask& task) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  const base::Location& location = task.posted_from;
+  mate::Dictionary posted_from = mate::Dictionary::CreateEmpty(isolate());
+  posted_from.Set("functionName",
+                  location.function_name() ? location.function_name() : "");
+  posted_from.Set("fileName", location.file_name() ? location.file_name() : "");
+  posted_from.Set("lineNumber", location.line_number());
+
+  mate::Dictionary details = mate::Dictionary::CreateEmpty(isolate());
+  details.Set("duration", task.duration.InMillisecondsF());
+  details.Set("postedFrom", posted_from);
+  details.Set("stack", task.stack);
+  details.Set("crashDumped", task.dumped);
+  Emit("main-thread-long-task", details);
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   auto status = content::GetFeatureStatus();
   base::DictionaryValue temp;
@@ -1325,6 +1446,9 @@ void App::BuildPrototype(v8::Isolate* isolate,
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("_getProcessMemoryInfo", &App::GetProcessMemoryInfo)
+      .SetMethod("startMainThreadWatchdog", &App::StartMainThreadWatchdog)
+      .SetMethod("stopMainThreadWatchdog", &App::StopMainThreadWatchdog)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 // TODO(juturu): Remove in 2.0, deprecate before then with warnings
@@ -15,6 +15,7 @@
 #include "atom/browser/atom_browser_client.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/browser_observer.h"
+#include "atom/browser/main_thread_watchdog.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/promise_util.h"
 #include "base/process/process_iterator.h"
@@ -200,6 +201,10 @@ class App : public AtomBrowserClient::Delegate,
   void GetFileIcon(const base::FilePath& path, mate::Arguments* args);
 
   std::vector<mate::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
+  void StartMainThreadWatchdog(mate::Arguments* args);
+  void StopMainThreadWatchdog();
+  void OnMainThreadLongTask(const MainThreadWatchdog::LongTask& task);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -238,6 +243,8 @@ class App : public AtomBrowserClient::Delegate,
       std::unordered_map<base::ProcessId, std::unique_ptr<atom::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  std::unique_ptr<MainThreadWatchdog> main_thread_watchdog_;
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
@@ -16,7 +16,9 @@
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
@@ -33,6 +35,9 @@ BrowserWindow::BrowserWindow(v8::Isolate* isolate,
                              v8::Local<v8::Object> wrapper,
                              const mate::Dictionary& options)
     : TopLevelWindow(isolate, options), weak_factory_(this) {
+  StartupTimeline::GetInstance()->AddMarkOnce("first-window-created");
+  TRACE_EVENT_ASYNC_BEGIN0("electron", "BrowserWindow::OpenToFirstPaint", this);
+
   mate::Handle<class WebContents> web_contents;
 
   // Use options.webPreferences in WebContents.
@@ -137,6 +142,16 @@ void BrowserWindow::RenderViewCreated(
 }
 
 void BrowserWindow::DidFirstVisuallyNonEmptyPaint() {
+  // Startup ends with the first paint of the first window.
+  StartupTimeline* timeline = StartupTimeline::GetInstance();
+  timeline->AddMarkOnce("first-paint");
+  timeline->WriteTraceFileIfRequested();
+
+  if (!first_paint_traced_) {
+    first_paint_traced_ = true;
+    TRACE_EVENT_ASYNC_END0("electron", "BrowserWindow::OpenToFirstPaint", this);
+  }
+
   if (window()->IsVisible())
     return;
 
@@ -115,6 +115,9 @@ class BrowserWindow : public TopLevelWindow,
   v8::Global<v8::Value> web_contents_;
   api::WebContents* api_web_contents_;
 
+  // Whether the time from opening to the first paint has been traced.
+  bool first_paint_traced_ = false;
+
   base::WeakPtrFactory<BrowserWindow> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(BrowserWindow);
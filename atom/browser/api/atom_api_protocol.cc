@@ -13,11 +13,13 @@
 #include "atom/browser/net/url_request_stream_job.h"
 #include "atom/browser/net/url_request_string_job.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_includes.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
 #include "base/strings/string_util.h"
+#include "base/task_scheduler/post_task.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "native_mate/dictionary.h"
 #include "url/url_util.h"
@@ -79,6 +81,66 @@ void Protocol::RegisterServiceWorkerSchemes(
   atom::AtomBrowserClient::SetCustomServiceWorkerSchemes(schemes);
 }
 
+void Protocol::RegisterDirectoryProtocol(const std::string& scheme,
+                                         const mate::Dictionary& options,
+                                         mate::Arguments* args) {
+  DirectoryProtocolHandler::Options handler_options;
+  if (!options.Get("root", &handler_options.root) ||
+      !handler_options.root.IsAbsolute()) {
+    args->ThrowError("root must be an absolute path");
+    return;
+  }
+
+  std::vector<mate::Dictionary> rewrites;
+  options.Get("rewrites", &rewrites);
+  for (const auto& rewrite : rewrites) {
+    std::string from, to;
+    if (!rewrite.Get("from", &from) || !rewrite.Get("to", &to) ||
+        from.empty()) {
+      args->ThrowError("rewrites must have non-empty from and to strings");
+      return;
+    }
+    handler_options.rewrites.emplace_back(from, to);
+  }
+
+  std::map<std::string, std::string> mime_types;
+  options.Get("mimeTypes", &mime_types);
+  for (const auto& mime_type : mime_types) {
+    std::string extension = base::ToLowerASCII(mime_type.first);
+    if (base::StartsWith(extension, ".", base::CompareCase::SENSITIVE))
+      extension.erase(0, 1);
+    handler_options.mime_types[extension] = mime_type.second;
+  }
+
+  CompletionCallback callback;
+  args->GetNext(&callback);
+  auto* getter = static_cast<URLRequestContextGetter*>(
+      browser_context_->GetRequestContext());
+  content::BrowserThread::PostTaskAndReplyWithResult(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&Protocol::RegisterDirectoryProtocolInIO,
+                     base::RetainedRef(getter), scheme, handler_options),
+      base::BindOnce(&Protocol::OnIOCompleted, GetWeakPtr(), callback));
+}
+
+// static
+Protocol::ProtocolError Protocol::RegisterDirectoryProtocolInIO(
+    scoped_refptr<URLRequestContextGetter> request_context_getter,
+    const std::string& scheme,
+    const DirectoryProtocolHandler::Options& options) {
+  auto* job_factory = request_context_getter->job_factory();
+  if (job_factory->IsHandledProtocol(scheme))
+    return PROTOCOL_REGISTERED;
+  auto protocol_handler = std::make_unique<DirectoryProtocolHandler>(
+      options, base::CreateTaskRunnerWithTraits(
+                   {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+                    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+  if (job_factory->SetProtocolHandler(scheme, std::move(protocol_handler)))
+    return PROTOCOL_OK;
+  else
+    return PROTOCOL_FAIL;
+}
+
 void Protocol::UnregisterProtocol(const std::string& scheme,
                                   mate::Arguments* args) {
   CompletionCallback callback;
@@ -200,6 +262,8 @@ void Protocol::BuildPrototype(v8::Isolate* isolate,
                  &Protocol::RegisterProtocol<URLRequestFetchJob>)
       .SetMethod("registerStreamProtocol",
                  &Protocol::RegisterProtocol<URLRequestStreamJob>)
+      .SetMethod("registerDirectoryProtocol",
+                 &Protocol::RegisterDirectoryProtocol)
       .SetMethod("unregisterProtocol", &Protocol::UnregisterProtocol)
       .SetMethod("isProtocolHandled", &Protocol::IsProtocolHandled)
       .SetMethod("interceptStringProtocol",
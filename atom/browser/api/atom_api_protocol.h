@@ -14,6 +14,8 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/net/atom_url_request_job_factory.h"
+#include "atom/browser/net/directory_protocol_handler.h"
+#include "atom/browser/net/protocol_response_cache.h"
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/browser_thread.h"
@@ -73,7 +75,9 @@ class Protocol : public mate::TrackableObject<Protocol> {
                           const Handler& handler)
         : isolate_(isolate),
           request_context_(request_context),
-          handler_(handler) {}
+          handler_(handler),
+          response_cache_(
+              new ProtocolResponseCache(kMaxResponseCacheSize)) {}
     ~CustomProtocolHandler() override {}
 
     net::URLRequestJob* MaybeCreateJob(
@@ -81,13 +85,18 @@ class Protocol : public mate::TrackableObject<Protocol> {
         net::NetworkDelegate* network_delegate) const override {
       RequestJob* request_job = new RequestJob(request, network_delegate);
       request_job->SetHandlerInfo(isolate_, request_context_, handler_);
+      request_job->set_response_cache(response_cache_);
       return request_job;
     }
 
    private:
+    // Upper bound of the memory used to cache the handler's responses.
+    static constexpr size_t kMaxResponseCacheSize = 32 * 1024 * 1024;
+
     v8::Isolate* isolate_;
     net::URLRequestContextGetter* request_context_;
     Protocol::Handler handler_;
+    scoped_refptr<ProtocolResponseCache> response_cache_;
 
     DISALLOW_COPY_AND_ASSIGN(CustomProtocolHandler);
   };
@@ -127,6 +136,15 @@ class Protocol : public mate::TrackableObject<Protocol> {
       return PROTOCOL_FAIL;
   }
 
+  // Register the protocol that serves the files under a directory.
+  void RegisterDirectoryProtocol(const std::string& scheme,
+                                 const mate::Dictionary& options,
+                                 mate::Arguments* args);
+  static ProtocolError RegisterDirectoryProtocolInIO(
+      scoped_refptr<URLRequestContextGetter> request_context_getter,
+      const std::string& scheme,
+      const DirectoryProtocolHandler::Options& options);
+
   // Unregister the protocol handler that handles |scheme|.
   void UnregisterProtocol(const std::string& scheme, mate::Arguments* args);
   static ProtocolError UnregisterProtocolInIO(
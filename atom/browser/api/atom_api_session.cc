@@ -21,7 +21,12 @@
 #include "atom/browser/browser.h"
 #include "atom/browser/media/media_device_id_salt.h"
 #include "atom/browser/net/atom_cert_verifier.h"
+#include "atom/browser/net/atom_network_delegate.h"
+#include "atom/browser/net/network_metrics_collector.h"
+#include "atom/browser/net/url_request_context_getter.h"
 #include "atom/browser/session_preferences.h"
+#include "atom/browser/spare_renderer_pool.h"
+#include "atom/browser/web_contents_preferences.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
@@ -196,6 +201,22 @@ struct Converter<atom::VerifyRequestParams> {
   }
 };
 
+template <>
+struct Converter<atom::URLRequestScheduler::Metrics> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const atom::URLRequestScheduler::Metrics& val) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("activeRequests", val.active_requests);
+    dict.Set("queuedRequests", val.queued_requests);
+    dict.Set("startedRequests", val.started_requests);
+    dict.Set("delayedRequests", val.delayed_requests);
+    dict.Set("totalQueueTime", val.total_queue_time.InMillisecondsF());
+    dict.Set("maxQueueTime", val.max_queue_time.InMillisecondsF());
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace mate
 
 namespace atom {
@@ -327,6 +348,80 @@ void AllowNTLMCredentialsForDomainsInIO(
   }
 }
 
+URLRequestScheduler* GetRequestScheduler(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter) {
+  return static_cast<URLRequestContextGetter*>(context_getter.get())
+      ->request_scheduler();
+}
+
+void SetRequestLimitsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const URLRequestScheduler::Limits& limits) {
+  GetRequestScheduler(context_getter)->SetLimits(limits);
+}
+
+void GetRequestQueueMetricsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const base::Callback<void(URLRequestScheduler::Metrics)>& callback) {
+  RunCallbackInUI(callback, GetRequestScheduler(context_getter)->GetMetrics());
+}
+
+NetworkMetricsCollector* GetMetricsCollector(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter) {
+  auto* getter = static_cast<URLRequestContextGetter*>(context_getter.get());
+  // Force creating network delegate.
+  if (!getter->GetURLRequestContext())
+    return nullptr;
+  return getter->network_delegate()->metrics_collector();
+}
+
+void EnableNetworkMetricsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    size_t record_buffer_size) {
+  auto* getter = static_cast<URLRequestContextGetter*>(context_getter.get());
+  if (getter->GetURLRequestContext())
+    getter->network_delegate()->EnableMetricsInIO(record_buffer_size);
+}
+
+void DisableNetworkMetricsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter) {
+  auto* getter = static_cast<URLRequestContextGetter*>(context_getter.get());
+  if (getter->GetURLRequestContext())
+    getter->network_delegate()->DisableMetricsInIO();
+}
+
+std::unique_ptr<base::Value> GetNetworkMetricsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter) {
+  auto* collector = GetMetricsCollector(context_getter);
+  if (!collector)
+    return std::make_unique<base::Value>();
+  return collector->GetMetrics();
+}
+
+std::vector<char> TakeNetworkMetricsRecordsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter) {
+  auto* collector = GetMetricsCollector(context_getter);
+  if (!collector)
+    return std::vector<char>();
+  return collector->TakeRecords();
+}
+
+void OnGetNetworkMetrics(
+    const base::Callback<void(const base::Value&)>& callback,
+    std::unique_ptr<base::Value> metrics) {
+  callback.Run(*metrics);
+}
+
+void OnTakeNetworkMetricsRecords(
+    const base::Callback<void(v8::Local<v8::Value>)>& callback,
+    std::vector<char> records) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  callback.Run(node::Buffer::Copy(isolate, records.data(), records.size())
+                   .ToLocalChecked());
+}
+
 void OnClearStorageDataDone(const base::Closure& callback) {
   if (!callback.is_null())
     callback.Run();
@@ -598,6 +693,78 @@ void Session::AllowNTLMCredentialsForDomains(const std::string& domains) {
                      domains));
 }
 
+void Session::SetRequestLimits(const mate::Dictionary& options,
+                               mate::Arguments* args) {
+  URLRequestScheduler::Limits limits;
+  int max_requests = 0;
+  int max_requests_per_host = 0;
+  options.Get("maxRequests", &max_requests);
+  options.Get("maxRequestsPerHost", &max_requests_per_host);
+  if (max_requests < 0 || max_requests_per_host < 0) {
+    args->ThrowError("Request limits must not be negative");
+    return;
+  }
+  limits.max_requests = max_requests;
+  limits.max_requests_per_host = max_requests_per_host;
+
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&SetRequestLimitsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext()),
+                     limits));
+}
+
+void Session::GetRequestQueueMetrics(
+    const base::Callback<void(URLRequestScheduler::Metrics)>& callback) {
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&GetRequestQueueMetricsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext()),
+                     callback));
+}
+
+void Session::EnableNetworkMetrics(mate::Arguments* args) {
+  int record_buffer_size = 0;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("recordBufferSize", &record_buffer_size);
+  if (record_buffer_size < 0) {
+    args->ThrowError("recordBufferSize must not be negative");
+    return;
+  }
+
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&EnableNetworkMetricsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext()),
+                     static_cast<size_t>(record_buffer_size)));
+}
+
+void Session::DisableNetworkMetrics() {
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&DisableNetworkMetricsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext())));
+}
+
+void Session::GetNetworkMetrics(
+    const base::Callback<void(const base::Value&)>& callback) {
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&GetNetworkMetricsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext())),
+      base::BindOnce(&OnGetNetworkMetrics, callback));
+}
+
+void Session::TakeNetworkMetricsRecords(
+    const base::Callback<void(v8::Local<v8::Value>)>& callback) {
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&TakeNetworkMetricsRecordsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext())),
+      base::BindOnce(&OnTakeNetworkMetricsRecords, callback));
+}
+
 void Session::SetUserAgent(const std::string& user_agent,
                            mate::Arguments* args) {
   browser_context_->SetUserAgent(user_agent);
@@ -672,6 +839,35 @@ std::vector<base::FilePath::StringType> Session::GetPreloads() const {
   return prefs->preloads();
 }
 
+void Session::SetSpareRendererCount(mate::Arguments* args) {
+  int count;
+  if (!args->GetNext(&count) || count < 0) {
+    args->ThrowError("count must be a non-negative integer");
+    return;
+  }
+  mate::Dictionary web_preferences = mate::Dictionary::CreateEmpty(isolate());
+  if (args->Length() > 1 && !args->GetNext(&web_preferences)) {
+    args->ThrowError("webPreferences must be an object");
+    return;
+  }
+
+  auto* pool = SpareRendererPool::FromBrowserContext(browser_context());
+  if (!pool) {
+    if (count == 0)
+      return;
+    pool = new SpareRendererPool(browser_context());
+  }
+  std::unique_ptr<WebContentsPreferences> profile;
+  if (count > 0)
+    profile = std::make_unique<WebContentsPreferences>(web_preferences);
+  pool->SetProfile(count, std::move(profile));
+}
+
+int Session::GetSpareRendererCount() const {
+  auto* pool = SpareRendererPool::FromBrowserContext(browser_context());
+  return pool ? static_cast<int>(pool->spare_count()) : 0;
+}
+
 v8::Local<v8::Value> Session::Cookies(v8::Isolate* isolate) {
   if (cookies_.IsEmpty()) {
     auto handle = Cookies::Create(isolate, browser_context());
@@ -764,6 +960,13 @@ void Session::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("clearAuthCache", &Session::ClearAuthCache)
       .SetMethod("allowNTLMCredentialsForDomains",
                  &Session::AllowNTLMCredentialsForDomains)
+      .SetMethod("setRequestLimits", &Session::SetRequestLimits)
+      .SetMethod("getRequestQueueMetrics", &Session::GetRequestQueueMetrics)
+      .SetMethod("enableNetworkMetrics", &Session::EnableNetworkMetrics)
+      .SetMethod("disableNetworkMetrics", &Session::DisableNetworkMetrics)
+      .SetMethod("getNetworkMetrics", &Session::GetNetworkMetrics)
+      .SetMethod("takeNetworkMetricsRecords",
+                 &Session::TakeNetworkMetricsRecords)
       .SetMethod("setUserAgent", &Session::SetUserAgent)
       .SetMethod("getUserAgent", &Session::GetUserAgent)
       .SetMethod("getBlobData", &Session::GetBlobData)
@@ -771,6 +974,8 @@ void Session::BuildPrototype(v8::Isolate* isolate,
                  &Session::CreateInterruptedDownload)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
+      .SetMethod("setSpareRendererCount", &Session::SetSpareRendererCount)
+      .SetMethod("getSpareRendererCount", &Session::GetSpareRendererCount)
       .SetProperty("cookies", &Session::Cookies)
       .SetProperty("netLog", &Session::NetLog)
       .SetProperty("protocol", &Session::Protocol)
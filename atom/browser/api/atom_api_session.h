@@ -11,6 +11,7 @@
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/atom_blob_reader.h"
 #include "atom/browser/net/resolve_proxy_helper.h"
+#include "atom/browser/net/url_request_scheduler.h"
 #include "base/values.h"
 #include "content/public/browser/download_manager.h"
 #include "native_mate/handle.h"
@@ -80,6 +81,15 @@ class Session : public mate::TrackableObject<Session>,
   void ClearHostResolverCache(mate::Arguments* args);
   void ClearAuthCache(mate::Arguments* args);
   void AllowNTLMCredentialsForDomains(const std::string& domains);
+  void SetRequestLimits(const mate::Dictionary& options, mate::Arguments* args);
+  void GetRequestQueueMetrics(
+      const base::Callback<void(URLRequestScheduler::Metrics)>& callback);
+  void EnableNetworkMetrics(mate::Arguments* args);
+  void DisableNetworkMetrics();
+  void GetNetworkMetrics(
+      const base::Callback<void(const base::Value&)>& callback);
+  void TakeNetworkMetricsRecords(
+      const base::Callback<void(v8::Local<v8::Value>)>& callback);
   void SetUserAgent(const std::string& user_agent, mate::Arguments* args);
   std::string GetUserAgent();
   void GetBlobData(const std::string& uuid,
@@ -87,6 +97,8 @@ class Session : public mate::TrackableObject<Session>,
   void CreateInterruptedDownload(const mate::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath::StringType>& preloads);
   std::vector<base::FilePath::StringType> GetPreloads() const;
+  void SetSpareRendererCount(mate::Arguments* args);
+  int GetSpareRendererCount() const;
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
   v8::Local<v8::Value> WebRequest(v8::Isolate* isolate);
@@ -5,17 +5,25 @@
 #include "atom/browser/api/atom_api_url_request.h"
 
 #include <string>
+#include <utility>
 
 #include "atom/browser/api/atom_api_session.h"
 #include "atom/browser/net/atom_url_request.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/node_includes.h"
+#include "base/files/file.h"
+#include "base/macros.h"
 #include "native_mate/dictionary.h"
 
+#if defined(OS_WIN)
+#include <io.h>
+#endif
+
 namespace mate {
 
 template <>
@@ -162,6 +170,8 @@ mate::WrappableBase* URLRequest::New(mate::Arguments* args) {
   dict.Get("url", &url);
   std::string redirect_policy;
   dict.Get("redirect", &redirect_policy);
+  net::RequestPriority priority = net::DEFAULT_PRIORITY;
+  dict.Get("priority", &priority);
   std::string partition;
   mate::Handle<api::Session> session;
   if (dict.Get("session", &session)) {
@@ -174,7 +184,7 @@ mate::WrappableBase* URLRequest::New(mate::Arguments* args) {
   auto* browser_context = session->browser_context();
   auto* api_url_request = new URLRequest(args->isolate(), args->GetThis());
   auto atom_url_request = AtomURLRequest::Create(
-      browser_context, method, url, redirect_policy, api_url_request);
+      browser_context, method, url, redirect_policy, priority, api_url_request);
 
   api_url_request->atom_request_ = atom_url_request;
 
@@ -189,12 +199,15 @@ void URLRequest::BuildPrototype(v8::Isolate* isolate,
       // Request API
       .MakeDestroyable()
       .SetMethod("write", &URLRequest::Write)
+      .SetMethod("writeFile", &URLRequest::WriteFile)
+      .SetMethod("writeFileDescriptor", &URLRequest::WriteFileDescriptor)
       .SetMethod("cancel", &URLRequest::Cancel)
       .SetMethod("setExtraHeader", &URLRequest::SetExtraHeader)
       .SetMethod("removeExtraHeader", &URLRequest::RemoveExtraHeader)
       .SetMethod("setChunkedUpload", &URLRequest::SetChunkedUpload)
       .SetMethod("followRedirect", &URLRequest::FollowRedirect)
       .SetMethod("_setLoadFlags", &URLRequest::SetLoadFlags)
+      .SetMethod("setPriority", &URLRequest::SetPriority)
       .SetMethod("getUploadProgress", &URLRequest::GetUploadProgress)
       .SetProperty("notStarted", &URLRequest::NotStarted)
       .SetProperty("finished", &URLRequest::Finished)
@@ -218,18 +231,26 @@ bool URLRequest::Canceled() const {
   return request_state_.Canceled();
 }
 
-bool URLRequest::Write(scoped_refptr<const net::IOBufferWithSize> buffer,
-                       bool is_last) {
-  if (request_state_.Canceled() || request_state_.Failed() ||
-      request_state_.Finished() || request_state_.Closed()) {
-    return false;
-  }
+bool URLRequest::CanWrite() const {
+  return !(request_state_.Canceled() || request_state_.Failed() ||
+           request_state_.Finished() || request_state_.Closed());
+}
 
+void URLRequest::MarkStarted() {
   if (request_state_.NotStarted()) {
     request_state_.SetFlag(RequestStateFlags::kStarted);
     // Pin on first write.
     Pin();
   }
+}
+
+bool URLRequest::Write(scoped_refptr<const net::IOBufferWithSize> buffer,
+                       bool is_last) {
+  if (!CanWrite()) {
+    return false;
+  }
+
+  MarkStarted();
 
   if (is_last) {
     request_state_.SetFlag(RequestStateFlags::kFinished);
@@ -243,6 +264,52 @@ bool URLRequest::Write(scoped_refptr<const net::IOBufferWithSize> buffer,
   return false;
 }
 
+bool URLRequest::WriteFile(const base::FilePath& path,
+                           uint64_t offset,
+                           uint64_t length) {
+  if (!CanWrite()) {
+    return false;
+  }
+
+  MarkStarted();
+
+  DCHECK(atom_request_);
+  if (atom_request_) {
+    return atom_request_->WriteFile(base::File(), path, offset, length);
+  }
+  return false;
+}
+
+bool URLRequest::WriteFileDescriptor(int fd, uint64_t offset, uint64_t length) {
+  if (!CanWrite()) {
+    return false;
+  }
+
+#if defined(OS_WIN)
+  base::PlatformFile platform_file =
+      reinterpret_cast<base::PlatformFile>(_get_osfhandle(fd));
+#else
+  base::PlatformFile platform_file = fd;
+#endif
+  // Duplicate the descriptor so the caller keeps ownership of |fd| and can
+  // close it as soon as this call returns.
+  base::File borrowed(platform_file);
+  base::File file = borrowed.Duplicate();
+  ignore_result(borrowed.TakePlatformFile());
+  if (!file.IsValid()) {
+    return false;
+  }
+
+  MarkStarted();
+
+  DCHECK(atom_request_);
+  if (atom_request_) {
+    return atom_request_->WriteFile(std::move(file), base::FilePath(), offset,
+                                    length);
+  }
+  return false;
+}
+
 void URLRequest::Cancel() {
   if (request_state_.Canceled() || request_state_.Closed()) {
     // Cancel only once.
@@ -311,7 +378,8 @@ void URLRequest::RemoveExtraHeader(const std::string& name) {
   }
 }
 
-void URLRequest::SetChunkedUpload(bool is_chunked_upload) {
+void URLRequest::SetChunkedUpload(bool is_chunked_upload,
+                                  bool is_streaming_upload) {
   // State must be equal to not started.
   if (!request_state_.NotStarted()) {
     // Cannot change headers after send.
@@ -319,7 +387,19 @@ void URLRequest::SetChunkedUpload(bool is_chunked_upload) {
   }
   DCHECK(atom_request_);
   if (atom_request_) {
-    atom_request_->SetChunkedUpload(is_chunked_upload);
+    atom_request_->SetChunkedUpload(is_chunked_upload, is_streaming_upload);
+  }
+}
+
+void URLRequest::SetPriority(net::RequestPriority priority) {
+  // The priority can still change while the request is queued or running.
+  if (request_state_.Finished() || request_state_.Canceled() ||
+      request_state_.Failed()) {
+    return;
+  }
+  DCHECK(atom_request_);
+  if (atom_request_) {
+    atom_request_->SetPriority(priority);
   }
 }
 
@@ -394,6 +474,14 @@ void URLRequest::OnResponseData(
   Emit("data", buffer);
 }
 
+void URLRequest::OnUploadDataConsumed(int bytes_consumed) {
+  if (request_state_.Canceled() || request_state_.Closed() ||
+      request_state_.Failed()) {
+    return;
+  }
+  Emit("upload-data-consumed", bytes_consumed);
+}
+
 void URLRequest::OnResponseCompleted() {
   if (request_state_.Canceled() || request_state_.Closed() ||
       request_state_.Failed() || response_state_.Failed()) {
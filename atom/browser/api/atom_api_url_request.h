@@ -10,12 +10,14 @@
 
 #include "atom/browser/api/event_emitter.h"
 #include "atom/browser/api/trackable_object.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "native_mate/dictionary.h"
 #include "native_mate/handle.h"
 #include "native_mate/wrappable_base.h"
 #include "net/base/auth.h"
 #include "net/base/io_buffer.h"
+#include "net/base/request_priority.h"
 #include "net/http/http_response_headers.h"
 #include "net/url_request/url_request_context.h"
 
@@ -110,6 +112,7 @@ class URLRequest : public mate::EventEmitter<URLRequest> {
   void OnResponseStarted(
       scoped_refptr<net::HttpResponseHeaders> response_headers);
   void OnResponseData(scoped_refptr<const net::IOBufferWithSize> data);
+  void OnUploadDataConsumed(int bytes_consumed);
   void OnResponseCompleted();
   void OnError(const std::string& error, bool isRequestError);
   mate::Dictionary GetUploadProgress(v8::Isolate* isolate);
@@ -175,13 +178,18 @@ class URLRequest : public mate::EventEmitter<URLRequest> {
   bool Finished() const;
   bool Canceled() const;
   bool Failed() const;
+  bool CanWrite() const;
+  void MarkStarted();
   bool Write(scoped_refptr<const net::IOBufferWithSize> buffer, bool is_last);
+  bool WriteFile(const base::FilePath& path, uint64_t offset, uint64_t length);
+  bool WriteFileDescriptor(int fd, uint64_t offset, uint64_t length);
   void Cancel();
   void FollowRedirect();
   bool SetExtraHeader(const std::string& name, const std::string& value);
   void RemoveExtraHeader(const std::string& name);
-  void SetChunkedUpload(bool is_chunked_upload);
+  void SetChunkedUpload(bool is_chunked_upload, bool is_streaming_upload);
   void SetLoadFlags(int flags);
+  void SetPriority(net::RequestPriority priority);
 
   int StatusCode() const;
   std::string StatusMessage() const;
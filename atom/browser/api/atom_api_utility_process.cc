@@ -0,0 +1,176 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/atom_api_utility_process.h"
+
+#include <utility>
+
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/node_message_serializer.h"
+#include "base/bind.h"
+#include "base/guid.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "content/public/common/service_manager_connection.h"
+#include "native_mate/arguments.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/object_template_builder.h"
+#include "services/service_manager/public/cpp/connector.h"
+#include "services/service_manager/public/mojom/constants.mojom.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace api {
+
+UtilityProcess::UtilityProcess(v8::Isolate* isolate,
+                               const std::string& service_name,
+                               const base::FilePath& module_path,
+                               const std::vector<std::string>& args)
+    : binding_(this), weak_factory_(this) {
+  Init(isolate);
+
+  // Every fork gets its own instance of the service, and so its own process.
+  service_manager::Identity identity(service_name,
+                                     service_manager::mojom::kInheritUserID,
+                                     base::GenerateGUID());
+  content::ServiceManagerConnection::GetForProcess()
+      ->GetConnector()
+      ->BindInterface(identity, &node_service_);
+  node_service_.set_connection_error_handler(base::BindOnce(
+      &UtilityProcess::OnConnectionError, base::Unretained(this)));
+
+  mojom::NodeMessagePortPtr client;
+  binding_.Bind(mojo::MakeRequest(&client));
+  binding_.set_connection_error_handler(base::BindOnce(
+      &UtilityProcess::OnConnectionError, base::Unretained(this)));
+
+  auto params = mojom::NodeServiceParams::New();
+  params->module_path = module_path;
+  params->args = args;
+  node_service_->Initialize(std::move(params), mojo::MakeRequest(&port_),
+                            std::move(client));
+}
+
+UtilityProcess::~UtilityProcess() {}
+
+// static
+mate::Handle<UtilityProcess> UtilityProcess::Fork(mate::Arguments* args) {
+  base::FilePath module_path;
+  if (!args->GetNext(&module_path) || !module_path.IsAbsolute()) {
+    args->ThrowError("modulePath must be an absolute path");
+    return mate::Handle<UtilityProcess>();
+  }
+
+  std::vector<std::string> fork_args;
+  if (!args->GetNext(&fork_args)) {
+    args->ThrowError("args must be an array of strings");
+    return mate::Handle<UtilityProcess>();
+  }
+
+  if (!content::ServiceManagerConnection::GetForProcess()) {
+    args->ThrowError("utilityProcess can not be used before the app is ready");
+    return mate::Handle<UtilityProcess>();
+  }
+
+  v8::Isolate* isolate = args->isolate();
+  auto handle = mate::CreateHandle(
+      isolate, new UtilityProcess(isolate, mojom::kNodeServiceName,
+                                  module_path, fork_args));
+  handle->Pin();
+  return handle;
+}
+
+void UtilityProcess::PostMessage(mojom::NodeMessagePtr message) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Value> value;
+  if (!DeserializeNodeMessage(isolate(), *message).ToLocal(&value))
+    return;
+  Emit("message", value);
+}
+
+void UtilityProcess::PostMessageToChild(mate::Arguments* args) {
+  if (!IsRunning()) {
+    args->ThrowError("The utility process has exited");
+    return;
+  }
+  mojom::NodeMessagePtr message = SerializeNodeMessage(args);
+  if (message)
+    port_->PostMessage(std::move(message));
+}
+
+void UtilityProcess::Kill() {
+  if (!IsRunning())
+    return;
+  Close();
+  // Emit "exit" asynchronously like the connection errors do.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&UtilityProcess::OnExit, weak_factory_.GetWeakPtr()));
+}
+
+bool UtilityProcess::IsRunning() const {
+  return node_service_.is_bound();
+}
+
+void UtilityProcess::Close() {
+  binding_.Close();
+  port_.reset();
+  node_service_.reset();
+}
+
+void UtilityProcess::OnConnectionError() {
+  if (!IsRunning())
+    return;
+  Close();
+  OnExit();
+}
+
+void UtilityProcess::OnExit() {
+  Emit("exit");
+  Unpin();
+}
+
+void UtilityProcess::Pin() {
+  if (wrapper_.IsEmpty())
+    wrapper_.Reset(isolate(), GetWrapper());
+}
+
+void UtilityProcess::Unpin() {
+  wrapper_.Reset();
+}
+
+// static
+void UtilityProcess::BuildPrototype(v8::Isolate* isolate,
+                                    v8::Local<v8::FunctionTemplate> prototype) {
+  prototype->SetClassName(mate::StringToV8(isolate, "UtilityProcess"));
+  mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("postMessage", &UtilityProcess::PostMessageToChild)
+      .SetMethod("kill", &UtilityProcess::Kill)
+      .SetMethod("isRunning", &UtilityProcess::IsRunning);
+}
+
+}  // namespace api
+
+}  // namespace atom
+
+namespace {
+
+using atom::api::UtilityProcess;
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  mate::Dictionary dict(isolate, exports);
+  dict.SetMethod("fork", &UtilityProcess::Fork);
+  dict.Set("UtilityProcess",
+           UtilityProcess::GetConstructor(isolate)->GetFunction());
+}
+
+}  // namespace
+
+NODE_BUILTIN_MODULE_CONTEXT_AWARE(atom_browser_utility_process, Initialize)
@@ -0,0 +1,76 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_ATOM_API_UTILITY_PROCESS_H_
+#define ATOM_BROWSER_API_ATOM_API_UTILITY_PROCESS_H_
+
+#include <string>
+#include <vector>
+
+#include "atom/browser/api/event_emitter.h"
+#include "atom/common/node_service.mojom.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "mojo/public/cpp/bindings/binding.h"
+#include "native_mate/handle.h"
+
+namespace mate {
+class Arguments;
+}
+
+namespace atom {
+
+namespace api {
+
+// A Node environment running a module in a utility process, created with
+// utilityProcess.fork().
+class UtilityProcess : public mate::EventEmitter<UtilityProcess>,
+                       public mojom::NodeMessagePort {
+ public:
+  static mate::Handle<UtilityProcess> Fork(mate::Arguments* args);
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Local<v8::FunctionTemplate> prototype);
+
+  // mojom::NodeMessagePort:
+  void PostMessage(mojom::NodeMessagePtr message) override;
+
+ protected:
+  UtilityProcess(v8::Isolate* isolate,
+                 const std::string& service_name,
+                 const base::FilePath& module_path,
+                 const std::vector<std::string>& args);
+  ~UtilityProcess() override;
+
+ private:
+  // utilityProcess.postMessage(message[, transfer]).
+  void PostMessageToChild(mate::Arguments* args);
+  void Kill();
+  bool IsRunning() const;
+
+  // Closes the pipes, which makes the utility process quit.
+  void Close();
+  void OnConnectionError();
+  void OnExit();
+
+  // Keeps the JavaScript object alive while the process is running.
+  void Pin();
+  void Unpin();
+
+  mojom::NodeServicePtr node_service_;
+  mojom::NodeMessagePortPtr port_;
+  mojo::Binding<mojom::NodeMessagePort> binding_;
+
+  v8::Global<v8::Object> wrapper_;
+
+  base::WeakPtrFactory<UtilityProcess> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(UtilityProcess);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_ATOM_API_UTILITY_PROCESS_H_
@@ -19,6 +19,7 @@
 #include "atom/browser/atom_navigation_throttle.h"
 #include "atom/browser/child_web_contents_tracker.h"
 #include "atom/browser/lib/bluetooth_chooser.h"
+#include "atom/browser/media/video_encoder.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/net/atom_network_delegate.h"
 #include "atom/browser/ui/drag_util.h"
@@ -86,6 +87,8 @@
 #include "ui/events/base_event_utils.h"
 
 #if BUILDFLAG(ENABLE_OSR)
+#include "atom/browser/osr/osr_damage.h"
+#include "atom/browser/osr/osr_frame_ring.h"
 #include "atom/browser/osr/osr_output_device.h"
 #include "atom/browser/osr/osr_render_widget_host_view.h"
 #include "atom/browser/osr/osr_web_contents_view.h"
@@ -286,6 +289,15 @@ void OnCapturePageDone(const base::Callback<void(const gfx::Image&)>& callback,
   callback.Run(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+#if BUILDFLAG(ENABLE_OSR)
+// Maximum number of shared memory buffers of an offscreen view.
+const int kMaxSharedMemoryBuffers = 16;
+
+void ReleaseSharedMemoryFrameBuffer(char* data, void* hint) {
+  static_cast<OffScreenFrameRing::Buffer*>(hint)->Release();
+}
+#endif
+
 }  // namespace
 
 struct WebContents::FrameDispatchHelper {
@@ -1701,23 +1713,170 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
 }
 
 void WebContents::BeginFrameSubscription(mate::Arguments* args) {
-  bool only_dirty = false;
+  FrameSubscriber::Options options;
   FrameSubscriber::FrameCaptureCallback callback;
 
-  args->GetNext(&only_dirty);
+  mate::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    int max_in_flight_copies = options.max_in_flight_copies;
+    int buffer_pool_size = 0;
+    dict.Get("onlyDirty", &options.only_dirty);
+    dict.Get("maxInFlightCopies", &max_in_flight_copies);
+    dict.Get("frameRate", &options.frame_rate);
+    dict.Get("bufferPoolSize", &buffer_pool_size);
+    if (max_in_flight_copies < 0 || options.frame_rate < 0 ||
+        buffer_pool_size < 0) {
+      args->ThrowError(
+          "maxInFlightCopies, frameRate and bufferPoolSize must be "
+          "non-negative integers");
+      return;
+    }
+    options.max_in_flight_copies = max_in_flight_copies;
+    options.buffer_pool_size = buffer_pool_size;
+  } else {
+    args->GetNext(&options.only_dirty);
+  }
+
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
   }
 
   frame_subscriber_.reset(
-      new FrameSubscriber(isolate(), web_contents(), callback, only_dirty));
+      new FrameSubscriber(isolate(), web_contents(), callback, options));
 }
 
 void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
 
+bool WebContents::ReleaseFrameBuffer(v8::Local<v8::Value> buffer) {
+  return frame_subscriber_ && frame_subscriber_->ReleaseBuffer(buffer);
+}
+
+v8::Local<v8::Value> WebContents::GetFrameSubscriptionMetrics() const {
+  if (!frame_subscriber_)
+    return v8::Null(isolate());
+
+  auto metrics = frame_subscriber_->GetMetrics();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("deliveredFrames", static_cast<double>(metrics.delivered_frames));
+  dict.Set("droppedFrames", static_cast<double>(metrics.dropped_frames));
+  dict.Set("throttledFrames", static_cast<double>(metrics.throttled_frames));
+  dict.Set("inFlightCopies", metrics.in_flight_copies);
+  dict.Set("freeBuffers", metrics.free_buffers);
+  return dict.GetHandle();
+}
+
+void WebContents::StartRecording(const mate::Dictionary& options,
+                                 mate::Arguments* args) {
+  VideoEncoder::Options encoder_options;
+  options.Get("path", &encoder_options.path);
+
+  std::string codec = "vp8";
+  options.Get("codec", &codec);
+  if (codec == "vp8") {
+    encoder_options.codec = VideoEncoder::Codec::VP8;
+  } else if (codec == "vp9") {
+    encoder_options.codec = VideoEncoder::Codec::VP9;
+  } else {
+    args->ThrowError("codec must be either 'vp8' or 'vp9'");
+    return;
+  }
+
+  int bitrate = encoder_options.bitrate;
+  int keyframe_interval = encoder_options.keyframe_interval;
+  int max_queued_frames = encoder_options.max_queued_frames;
+  int frame_rate = 0;
+  options.Get("bitrate", &bitrate);
+  options.Get("keyframeInterval", &keyframe_interval);
+  options.Get("maxQueuedFrames", &max_queued_frames);
+  options.Get("frameRate", &frame_rate);
+  if (bitrate <= 0 || keyframe_interval <= 0 || max_queued_frames <= 0 ||
+      frame_rate < 0) {
+    args->ThrowError(
+        "bitrate, keyframeInterval and maxQueuedFrames must be positive "
+        "integers and frameRate must not be negative");
+    return;
+  }
+  encoder_options.bitrate = bitrate;
+  encoder_options.keyframe_interval = keyframe_interval;
+  encoder_options.max_queued_frames = max_queued_frames;
+  encoder_options.frame_rate = frame_rate;
+
+  recording_subscriber_.reset();
+  video_encoder_.reset(new VideoEncoder(
+      encoder_options,
+      base::Bind(&WebContents::OnRecordingData, GetWeakPtr()),
+      base::Bind(&WebContents::OnRecordingError, GetWeakPtr())));
+
+  // Offscreen frames are passed to the encoder when they are painted, which
+  // skips the frames above the frame rate. Other pages are not captured more
+  // often than that in the first place.
+  if (!IsOffScreen()) {
+    FrameSubscriber::Options subscriber_options;
+    subscriber_options.frame_rate = frame_rate;
+    recording_subscriber_.reset(new FrameSubscriber(
+        web_contents(),
+        base::Bind(base::IgnoreResult(&VideoEncoder::EncodeFrame),
+                   base::Unretained(video_encoder_.get())),
+        subscriber_options));
+  }
+  Invalidate();
+}
+
+void WebContents::StopRecording(mate::Arguments* args) {
+  base::Closure callback;
+  args->GetNext(&callback);
+
+  recording_subscriber_.reset();
+  if (!video_encoder_) {
+    if (!callback.is_null())
+      callback.Run();
+    return;
+  }
+
+  // The encoder stays alive until the end of the stream was written.
+  VideoEncoder* encoder = video_encoder_.get();
+  encoder->Stop(base::BindOnce(
+      [](std::unique_ptr<VideoEncoder> encoder, const base::Closure& callback) {
+        if (!callback.is_null())
+          callback.Run();
+      },
+      std::move(video_encoder_), callback));
+}
+
+v8::Local<v8::Value> WebContents::GetRecordingStats() const {
+  if (!video_encoder_)
+    return v8::Null(isolate());
+
+  auto stats = video_encoder_->GetStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("encodedFrames", static_cast<double>(stats.encoded_frames));
+  dict.Set("droppedFrames", static_cast<double>(stats.dropped_frames));
+  dict.Set("keyframes", static_cast<double>(stats.keyframes));
+  dict.Set("bytesWritten", static_cast<double>(stats.bytes_written));
+  dict.Set("queuedFrames", stats.queued_frames);
+  dict.Set("bitrate", stats.bitrate);
+  dict.Set("averageLatency", stats.average_latency.InMillisecondsF());
+  dict.Set("maxLatency", stats.max_latency.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+void WebContents::OnRecordingData(const std::vector<uint8_t>& data) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  Emit("recording-data",
+       node::Buffer::Copy(isolate(), reinterpret_cast<const char*>(data.data()),
+                          data.size())
+           .ToLocalChecked());
+}
+
+void WebContents::OnRecordingError(const std::string& error) {
+  recording_subscriber_.reset();
+  Emit("recording-error", error);
+}
+
 void WebContents::StartDrag(const mate::Dictionary& item,
                             mate::Arguments* args) {
   base::FilePath file;
@@ -1824,8 +1983,208 @@ bool WebContents::IsOffScreen() const {
 }
 
 #if BUILDFLAG(ENABLE_OSR)
-void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
-  Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
+void WebContents::OnPaint(const OffScreenDamage& damage,
+                          const SkBitmap& bitmap) {
+  if (video_encoder_)
+    video_encoder_->EncodeFrame(bitmap);
+
+  if (shared_memory_buffer_count_ > 0) {
+    OnSharedMemoryPaint(damage, bitmap);
+    return;
+  }
+
+  mate::Dictionary details = mate::Dictionary::CreateEmpty(isolate());
+  SetDamageDetails(damage, gfx::Size(bitmap.width(), bitmap.height()),
+                   &details);
+  auto image =
+      NativeImage::Create(isolate(), gfx::Image::CreateFrom1xBitmap(bitmap));
+  // Only released when the consumer hands it back to acknowledgeFrame().
+  image->set_producer(this);
+  Emit("paint", damage.bounds(), image, details);
+}
+
+void WebContents::OnSharedMemoryPaint(const OffScreenDamage& damage,
+                                      const SkBitmap& bitmap) {
+  gfx::Size size(bitmap.width(), bitmap.height());
+  bool buffers_changed = false;
+  if (!frame_ring_ || frame_ring_->frame_size() != size) {
+    // Buffers of the previous size stay valid for as long as they are
+    // referenced, but are no longer written to.
+    frame_ring_ =
+        OffScreenFrameRing::Create(shared_memory_buffer_count_, size);
+    if (!frame_ring_)
+      return;
+    buffers_changed = true;
+  }
+
+  OffScreenFrameRing::Frame frame;
+  if (!frame_ring_->WriteFrame(damage, bitmap, &frame))
+    return;
+
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("bufferIndex", static_cast<uint32_t>(frame.index));
+  dict.Set("sequence", static_cast<double>(frame.sequence));
+  dict.Set("dirtyRect", frame.damage.bounds());
+  SetDamageDetails(frame.damage, size, &dict);
+  dict.Set("size", size);
+  dict.Set("buffersChanged", buffers_changed);
+  Emit("shared-memory-paint", dict);
+}
+
+void WebContents::BeginSharedMemoryPainting(mate::Arguments* args) {
+  int buffer_count = 3;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("bufferCount", &buffer_count);
+  if (buffer_count < 1 || buffer_count > kMaxSharedMemoryBuffers) {
+    args->ThrowError("bufferCount must be between 1 and 16");
+    return;
+  }
+
+  shared_memory_buffer_count_ = buffer_count;
+  frame_ring_.reset();
+  Invalidate();
+}
+
+void WebContents::EndSharedMemoryPainting() {
+  shared_memory_buffer_count_ = 0;
+  frame_ring_.reset();
+}
+
+v8::Local<v8::Value> WebContents::GetSharedMemoryBuffers() {
+  v8::Local<v8::Array> result = v8::Array::New(isolate());
+  if (!frame_ring_)
+    return result;
+
+  const gfx::Size& size = frame_ring_->frame_size();
+  for (size_t i = 0; i < frame_ring_->buffer_count(); ++i) {
+    auto* buffer = frame_ring_->buffer(i).get();
+    // The node::Buffer keeps the mapping alive until it is collected.
+    buffer->AddRef();
+    char* data = static_cast<char*>(buffer->memory());
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+    dict.Set("buffer",
+             node::Buffer::New(isolate(), data, buffer->size(),
+                               &ReleaseSharedMemoryFrameBuffer, buffer)
+                 .ToLocalChecked());
+#if defined(OS_LINUX)
+    dict.Set("fd", buffer->fd());
+#endif
+    dict.Set("width", size.width());
+    dict.Set("height", size.height());
+    dict.Set("stride", static_cast<uint32_t>(frame_ring_->stride()));
+    result->Set(static_cast<uint32_t>(i), dict.GetHandle());
+  }
+  return result;
+}
+
+void WebContents::ReleaseSharedMemoryBuffer(uint32_t index) {
+  if (!frame_ring_ || !frame_ring_->ReleaseBuffer(index))
+    return;
+
+  // Produce the frame that was dropped while all buffers were held.
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (osr_rwhv) {
+    for (const auto& rect : frame_ring_->pending_damage().rects())
+      osr_rwhv->InvalidateBounds(rect);
+  }
+}
+
+void WebContents::SetPaintTileSize(mate::Arguments* args) {
+  int tile_size;
+  if (!args->GetNext(&tile_size) || tile_size < 0) {
+    args->ThrowError("tileSize must be a non-negative integer");
+    return;
+  }
+  paint_tile_size_ = tile_size;
+
+  // Finding the changed tiles costs a copy of the previous frame, only pay
+  // for it when the tiles are read.
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SetCompareFrames(tile_size > 0);
+}
+
+int WebContents::GetPaintTileSize() const {
+  return paint_tile_size_;
+}
+
+void WebContents::SetFramePacing(const mate::Dictionary& options,
+                                 mate::Arguments* args) {
+  std::string mode_name = "fixed";
+  options.Get("mode", &mode_name);
+  OffScreenFramePacer::Mode mode;
+  if (mode_name == "fixed") {
+    mode = OffScreenFramePacer::Mode::FIXED;
+  } else if (mode_name == "adaptive") {
+    mode = OffScreenFramePacer::Mode::ADAPTIVE;
+  } else {
+    args->ThrowError("mode must be either 'fixed' or 'adaptive'");
+    return;
+  }
+
+  int max_pending_frames = 0;
+  options.Get("maxPendingFrames", &max_pending_frames);
+  if (max_pending_frames < 0) {
+    args->ThrowError("maxPendingFrames must be a non-negative integer");
+    return;
+  }
+
+  auto* osr_wcv = GetOffScreenWebContentsView();
+  if (osr_wcv)
+    osr_wcv->SetFramePacing(mode, max_pending_frames);
+}
+
+void WebContents::AcknowledgeFrame(mate::Arguments* args) {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (osr_rwhv)
+    osr_rwhv->AcknowledgeFrame();
+
+  // The image of the acknowledged frame is released only when the consumer
+  // passes it, other images are left to the GC.
+  mate::Handle<NativeImage> image;
+  if (args->GetNext(&image) && !image.IsEmpty() && image->IsProducedBy(this))
+    image->Release();
+}
+
+v8::Local<v8::Value> WebContents::GetFramePacingMetrics() const {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (!osr_rwhv)
+    return v8::Null(isolate());
+
+  auto metrics = osr_rwhv->GetFramePacingMetrics();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("beginFrames", static_cast<double>(metrics.begin_frames));
+  dict.Set("paintedFrames", static_cast<double>(metrics.painted_frames));
+  dict.Set("droppedFrames", static_cast<double>(metrics.dropped_frames));
+  dict.Set("lateFrames", static_cast<double>(metrics.late_frames));
+  dict.Set("idleFrames", static_cast<double>(metrics.idle_frames));
+  dict.Set("pendingFrames", metrics.pending_frames);
+  dict.Set("frameInterval", metrics.frame_interval.InMillisecondsF());
+  dict.Set("averagePaintTime", metrics.average_paint_time.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+void WebContents::SetDamageDetails(const OffScreenDamage& damage,
+                                   const gfx::Size& size,
+                                   mate::Dictionary* dict) {
+  dict->Set("dirtyRects", damage.rects());
+  if (paint_tile_size_ <= 0)
+    return;
+
+  std::vector<uint8_t> tiles = damage.GetDirtyTiles(size, paint_tile_size_);
+  mate::Dictionary dirty_tiles = mate::Dictionary::CreateEmpty(isolate());
+  dirty_tiles.Set("tileSize", paint_tile_size_);
+  dirty_tiles.Set(
+      "columns", (size.width() + paint_tile_size_ - 1) / paint_tile_size_);
+  dirty_tiles.Set(
+      "rows", (size.height() + paint_tile_size_ - 1) / paint_tile_size_);
+  dirty_tiles.Set("dirty",
+                  node::Buffer::Copy(isolate(),
+                                     reinterpret_cast<char*>(tiles.data()),
+                                     tiles.size())
+                      .ToLocalChecked());
+  dict->Set("dirtyTiles", dirty_tiles);
 }
 
 void WebContents::StartPainting() {
@@ -1855,6 +2214,19 @@ int WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+v8::Local<v8::Value> WebContents::GetPaintMetrics() const {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (!osr_rwhv)
+    return v8::Null(isolate());
+
+  const auto& metrics = osr_rwhv->paint_metrics();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("frames", static_cast<double>(metrics.frames));
+  dict.Set("bytesCopied", static_cast<double>(metrics.bytes_copied));
+  dict.Set("allocations", static_cast<double>(metrics.allocations));
+  return dict.GetHandle();
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -2044,6 +2416,15 @@ bool WebContents::TakeHeapSnapshot(const base::FilePath& file_path,
       IPC::TakePlatformFileForTransit(std::move(file)), channel));
 }
 
+bool WebContents::GetMemoryUsage(const std::string& channel) {
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive())
+    return false;
+
+  return frame_host->Send(
+      new AtomFrameMsg_GetMemoryUsage(frame_host->GetRoutingID(), channel));
+}
+
 // static
 void WebContents::BuildPrototype(v8::Isolate* isolate,
                                  v8::Local<v8::FunctionTemplate> prototype) {
@@ -2102,6 +2483,12 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("releaseFrameBuffer", &WebContents::ReleaseFrameBuffer)
+      .SetMethod("getFrameSubscriptionMetrics",
+                 &WebContents::GetFrameSubscriptionMetrics)
+      .SetMethod("startRecording", &WebContents::StartRecording)
+      .SetMethod("stopRecording", &WebContents::StopRecording)
+      .SetMethod("getRecordingStats", &WebContents::GetRecordingStats)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("isGuest", &WebContents::IsGuest)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
@@ -2112,6 +2499,19 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("isPainting", &WebContents::IsPainting)
       .SetMethod("setFrameRate", &WebContents::SetFrameRate)
       .SetMethod("getFrameRate", &WebContents::GetFrameRate)
+      .SetMethod("getPaintMetrics", &WebContents::GetPaintMetrics)
+      .SetMethod("beginSharedMemoryPainting",
+                 &WebContents::BeginSharedMemoryPainting)
+      .SetMethod("endSharedMemoryPainting",
+                 &WebContents::EndSharedMemoryPainting)
+      .SetMethod("getSharedMemoryBuffers", &WebContents::GetSharedMemoryBuffers)
+      .SetMethod("releaseSharedMemoryBuffer",
+                 &WebContents::ReleaseSharedMemoryBuffer)
+      .SetMethod("setPaintTileSize", &WebContents::SetPaintTileSize)
+      .SetMethod("getPaintTileSize", &WebContents::GetPaintTileSize)
+      .SetMethod("setFramePacing", &WebContents::SetFramePacing)
+      .SetMethod("acknowledgeFrame", &WebContents::AcknowledgeFrame)
+      .SetMethod("getFramePacingMetrics", &WebContents::GetFramePacingMetrics)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("setZoomLevel", &WebContents::SetZoomLevel)
@@ -2146,6 +2546,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("_takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("_getMemoryUsage", &WebContents::GetMemoryUsage)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -43,11 +43,14 @@ namespace atom {
 class AtomBrowserContext;
 class AtomJavaScriptDialogManager;
 class InspectableWebContents;
+class VideoEncoder;
 class WebContentsZoomController;
 class WebViewGuestDelegate;
 class FrameSubscriber;
 
 #if BUILDFLAG(ENABLE_OSR)
+class OffScreenDamage;
+class OffScreenFrameRing;
 class OffScreenWebContentsView;
 #endif
 
@@ -204,6 +207,13 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Subscribe to the frame updates.
   void BeginFrameSubscription(mate::Arguments* args);
   void EndFrameSubscription();
+  bool ReleaseFrameBuffer(v8::Local<v8::Value> buffer);
+  v8::Local<v8::Value> GetFrameSubscriptionMetrics() const;
+
+  // Encode the frames to a WebM stream.
+  void StartRecording(const mate::Dictionary& options, mate::Arguments* args);
+  void StopRecording(mate::Arguments* args);
+  v8::Local<v8::Value> GetRecordingStats() const;
 
   // Dragging native items.
   void StartDrag(const mate::Dictionary& item, mate::Arguments* args);
@@ -220,12 +230,22 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Methods for offscreen rendering
   bool IsOffScreen() const;
 #if BUILDFLAG(ENABLE_OSR)
-  void OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap);
+  void OnPaint(const OffScreenDamage& damage, const SkBitmap& bitmap);
   void StartPainting();
   void StopPainting();
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  v8::Local<v8::Value> GetPaintMetrics() const;
+  void BeginSharedMemoryPainting(mate::Arguments* args);
+  void EndSharedMemoryPainting();
+  v8::Local<v8::Value> GetSharedMemoryBuffers();
+  void ReleaseSharedMemoryBuffer(uint32_t index);
+  void SetPaintTileSize(mate::Arguments* args);
+  int GetPaintTileSize() const;
+  void SetFramePacing(const mate::Dictionary& options, mate::Arguments* args);
+  void AcknowledgeFrame(mate::Arguments* args);
+  v8::Local<v8::Value> GetFramePacingMetrics() const;
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) const override;
@@ -269,6 +289,10 @@ class WebContents : public mate::TrackableObject<WebContents>,
   bool TakeHeapSnapshot(const base::FilePath& file_path,
                         const std::string& channel);
 
+  // Asks the renderer for the memory used by V8 and Blink, which replies on
+  // the internal |channel|.
+  bool GetMemoryUsage(const std::string& channel);
+
   // Properties.
   int32_t ID() const;
   v8::Local<v8::Value> Session(v8::Isolate* isolate);
@@ -438,11 +462,26 @@ class WebContents : public mate::TrackableObject<WebContents>,
   uint32_t GetNextRequestId() { return ++request_id_; }
 
 #if BUILDFLAG(ENABLE_OSR)
+  // Writes the frame to the shared memory buffers instead of emitting it
+  // with the paint event.
+  void OnSharedMemoryPaint(const OffScreenDamage& damage,
+                           const SkBitmap& bitmap);
+
+  // Adds the dirty rects and, when a tile size is set, the dirty tiles of a
+  // frame to |dict|.
+  void SetDamageDetails(const OffScreenDamage& damage,
+                        const gfx::Size& size,
+                        mate::Dictionary* dict);
+
   OffScreenWebContentsView* GetOffScreenWebContentsView() const;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView()
       const override;
 #endif
 
+  // Called by the video encoder on the UI thread.
+  void OnRecordingData(const std::vector<uint8_t>& data);
+  void OnRecordingError(const std::string& error);
+
   // Called when we receive a CursorChange message from chromium.
   void OnCursorChange(const content::WebCursor& cursor);
 
@@ -488,6 +527,20 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
   std::unique_ptr<FrameSubscriber> frame_subscriber_;
 
+  std::unique_ptr<VideoEncoder> video_encoder_;
+  // Captures the frames for |video_encoder_| when not painting offscreen.
+  std::unique_ptr<FrameSubscriber> recording_subscriber_;
+
+#if BUILDFLAG(ENABLE_OSR)
+  // Number of shared memory buffers frames are written to, 0 when frames are
+  // emitted with the paint event.
+  int shared_memory_buffer_count_ = 0;
+  std::unique_ptr<OffScreenFrameRing> frame_ring_;
+
+  // Size of the tiles the damage of a frame is reported for, 0 when disabled.
+  int paint_tile_size_ = 0;
+#endif
+
   // The host webcontents that may contain this webcontents.
   WebContents* embedder_ = nullptr;
 
@@ -4,14 +4,16 @@
 
 #include "atom/browser/api/frame_subscriber.h"
 
+#include <algorithm>
+
 #include "atom/common/native_mate_converters/gfx_converter.h"
+#include "atom/common/pixel_pipeline.h"
 #include "components/viz/common/frame_sinks/copy_output_request.h"
 #include "components/viz/service/frame_sinks/frame_sink_manager_impl.h"
 #include "components/viz/service/surfaces/surface_manager.h"
 #include "content/browser/compositor/surface_utils.h"
 #include "content/browser/renderer_host/render_widget_host_view_base.h"
 #include "ui/gfx/geometry/rect_conversions.h"
-#include "ui/gfx/skbitmap_operations.h"
 
 #include "atom/common/node_includes.h"
 
@@ -22,12 +24,27 @@ namespace api {
 FrameSubscriber::FrameSubscriber(v8::Isolate* isolate,
                                  content::WebContents* web_contents,
                                  const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 const Options& options)
     : content::WebContentsObserver(web_contents),
       isolate_(isolate),
       callback_(callback),
-      only_dirty_(only_dirty),
-      weak_ptr_factory_(this) {}
+      options_(options),
+      buffers_(options.buffer_pool_size),
+      buffers_in_use_(options.buffer_pool_size, false),
+      weak_ptr_factory_(this) {
+  if (options_.frame_rate > 0)
+    frame_interval_ = base::TimeDelta::FromSeconds(1) / options_.frame_rate;
+}
+
+FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+                                 const FrameSinkCallback& callback,
+                                 const Options& options)
+    : FrameSubscriber(nullptr,
+                      web_contents,
+                      FrameCaptureCallback(),
+                      options) {
+  sink_callback_ = callback;
+}
 
 FrameSubscriber::~FrameSubscriber() = default;
 
@@ -58,43 +75,142 @@ gfx::Rect FrameSubscriber::GetDamageRect() {
   }
 }
 
+bool FrameSubscriber::ReleaseBuffer(v8::Local<v8::Value> buffer) {
+  v8::Local<v8::ArrayBuffer> array_buffer;
+  if (buffer->IsArrayBufferView())
+    array_buffer = buffer.As<v8::ArrayBufferView>()->Buffer();
+  else if (buffer->IsArrayBuffer())
+    array_buffer = buffer.As<v8::ArrayBuffer>();
+  else
+    return false;
+
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    if (buffers_in_use_[i] && buffers_[i] == array_buffer) {
+      buffers_in_use_[i] = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+FrameSubscriber::Metrics FrameSubscriber::GetMetrics() const {
+  Metrics metrics = metrics_;
+  metrics.in_flight_copies = in_flight_copies_;
+  metrics.free_buffers = GetFreeBufferCount();
+  return metrics;
+}
+
 void FrameSubscriber::DidReceiveCompositorFrame() {
   auto* view = web_contents()->GetRenderWidgetHostView();
   if (view == nullptr)
     return;
 
+  // Skipped frames keep their damage so that the next captured frame
+  // covers everything that changed since the last one.
+  pending_damage_.Union(GetDamageRect());
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (!frame_interval_.is_zero() && !last_capture_time_.is_null() &&
+      now - last_capture_time_ < frame_interval_) {
+    ++metrics_.throttled_frames;
+    return;
+  }
+
+  // Every copy in flight has a pooled buffer reserved for its result.
+  if ((options_.max_in_flight_copies &&
+       in_flight_copies_ >= options_.max_in_flight_copies) ||
+      (!buffers_.empty() && GetFreeBufferCount() <= in_flight_copies_)) {
+    ++metrics_.dropped_frames;
+    return;
+  }
+
+  last_capture_time_ = now;
+  ++in_flight_copies_;
+  gfx::Rect damage = pending_damage_;
+  pending_damage_ = gfx::Rect();
+
   view->CopyFromSurface(
       gfx::Rect(), view->GetViewBounds().size(),
       base::BindOnce(&FrameSubscriber::Done, weak_ptr_factory_.GetWeakPtr(),
-                     GetDamageRect()));
+                     damage));
 }
 
 void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
+  DCHECK_GT(in_flight_copies_, 0u);
+  --in_flight_copies_;
+
   if (frame.drawsNothing())
     return;
 
+  if (!sink_callback_.is_null()) {
+    ++metrics_.delivered_frames;
+    sink_callback_.Run(frame);
+    return;
+  }
+
   v8::Locker locker(isolate_);
   v8::HandleScope handle_scope(isolate_);
 
   const_cast<SkBitmap&>(frame).setAlphaType(kPremul_SkAlphaType);
-  const SkBitmap& bitmap = only_dirty_ ? SkBitmapOperations::CreateTiledBitmap(
-                                             frame, damage.x(), damage.y(),
-                                             damage.width(), damage.height())
-                                       : frame;
+  SkPixmap pixmap;
+  if (!frame.peekPixels(&pixmap))
+    return;
+
+  // Copy the dirty part straight into the buffer handed to the callback.
+  gfx::Rect rect(frame.width(), frame.height());
+  if (options_.only_dirty)
+    rect.Intersect(damage);
+
+  // Every byte handed to the callback is written by the pipeline, frames it
+  // can not convert are dropped rather than delivered uninitialized.
+  PixelPipelineOptions options;
+  options.source_rect = rect;
+  if (rect.IsEmpty() || !ResolvePixelPipelineOptions(pixmap, &options)) {
+    ++metrics_.dropped_frames;
+    return;
+  }
 
-  size_t rgb_row_size = bitmap.width() * bitmap.bytesPerPixel();
-  auto* source = static_cast<const char*>(bitmap.getPixels());
+  size_t size = rect.size().GetArea() * frame.bytesPerPixel();
+  v8::Local<v8::Object> local_buffer;
+  if (buffers_.empty())
+    local_buffer = node::Buffer::New(isolate_, size).ToLocalChecked();
+  else
+    local_buffer = AcquireBuffer(size);
+  if (local_buffer.IsEmpty()) {
+    ++metrics_.dropped_frames;
+    return;
+  }
 
-  v8::MaybeLocal<v8::Object> buffer =
-      node::Buffer::Copy(isolate_, source, rgb_row_size * bitmap.height());
-  auto local_buffer = buffer.ToLocalChecked();
+  auto* data = reinterpret_cast<uint8_t*>(node::Buffer::Data(local_buffer));
+  RunPixelPipeline(pixmap, options, data);
 
   v8::Local<v8::Value> damage_rect =
       mate::Converter<gfx::Rect>::ToV8(isolate_, damage);
 
+  ++metrics_.delivered_frames;
   callback_.Run(local_buffer, damage_rect);
 }
 
+v8::Local<v8::Object> FrameSubscriber::AcquireBuffer(size_t size) {
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    if (buffers_in_use_[i])
+      continue;
+
+    v8::Local<v8::ArrayBuffer> buffer = buffers_[i].Get(isolate_);
+    if (buffer.IsEmpty() || buffer->ByteLength() < size) {
+      buffer = v8::ArrayBuffer::New(isolate_, size);
+      buffers_[i].Reset(isolate_, buffer);
+    }
+    buffers_in_use_[i] = true;
+    return v8::Uint8Array::New(buffer, 0, size);
+  }
+  return v8::Local<v8::Object>();
+}
+
+uint32_t FrameSubscriber::GetFreeBufferCount() const {
+  return std::count(buffers_in_use_.begin(), buffers_in_use_.end(), false);
+}
+
 }  // namespace api
 
 }  // namespace atom
@@ -5,10 +5,13 @@
 #ifndef ATOM_BROWSER_API_FRAME_SUBSCRIBER_H_
 #define ATOM_BROWSER_API_FRAME_SUBSCRIBER_H_
 
+#include <vector>
+
 #include "content/public/browser/web_contents.h"
 
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "components/viz/common/frame_sinks/copy_output_result.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "ui/gfx/image/image.h"
@@ -24,21 +27,73 @@ class FrameSubscriber : public content::WebContentsObserver {
  public:
   using FrameCaptureCallback =
       base::Callback<void(v8::Local<v8::Value>, v8::Local<v8::Value>)>;
+  using FrameSinkCallback = base::Callback<void(const SkBitmap&)>;
+
+  struct Options {
+    bool only_dirty = false;
+    // Maximum number of copies from the surface that may be pending at the
+    // same time, 0 means unlimited.
+    uint32_t max_in_flight_copies = 3;
+    // Maximum number of frames captured per second, 0 means every
+    // compositor frame is captured.
+    int frame_rate = 0;
+    // Number of ArrayBuffers that are reused for the frames, 0 means a new
+    // Buffer is allocated for every frame.
+    uint32_t buffer_pool_size = 0;
+  };
+
+  struct Metrics {
+    uint64_t delivered_frames = 0;
+    // Frames skipped because too many copies were in flight or no pooled
+    // buffer was free.
+    uint64_t dropped_frames = 0;
+    // Frames skipped to stay below the frame rate.
+    uint64_t throttled_frames = 0;
+    uint32_t in_flight_copies = 0;
+    uint32_t free_buffers = 0;
+  };
 
   FrameSubscriber(v8::Isolate* isolate,
                   content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  const Options& options);
+  // Passes the captured frames to |callback| without entering JavaScript.
+  FrameSubscriber(content::WebContents* web_contents,
+                  const FrameSinkCallback& callback,
+                  const Options& options);
   ~FrameSubscriber() override;
 
+  // Returns the pooled |buffer|, or a view of it, to the pool. Returns false
+  // when it is not a pooled buffer that is in use.
+  bool ReleaseBuffer(v8::Local<v8::Value> buffer);
+
+  Metrics GetMetrics() const;
+
  private:
   gfx::Rect GetDamageRect();
   void DidReceiveCompositorFrame() override;
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
 
+  // Returns a view of |size| bytes over a free pooled buffer, which is
+  // grown when needed.
+  v8::Local<v8::Object> AcquireBuffer(size_t size);
+  uint32_t GetFreeBufferCount() const;
+
   v8::Isolate* isolate_;
   FrameCaptureCallback callback_;
-  bool only_dirty_;
+  FrameSinkCallback sink_callback_;
+  Options options_;
+  base::TimeDelta frame_interval_;
+
+  base::TimeTicks last_capture_time_;
+  // Damage of the frames that were skipped since the last capture.
+  gfx::Rect pending_damage_;
+  uint32_t in_flight_copies_ = 0;
+
+  std::vector<v8::Global<v8::ArrayBuffer>> buffers_;
+  std::vector<bool> buffers_in_use_;
+
+  Metrics metrics_;
 
   base::WeakPtrFactory<FrameSubscriber> weak_ptr_factory_;
 
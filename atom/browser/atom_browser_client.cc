@@ -27,11 +27,13 @@
 #include "atom/browser/notifications/notification_presenter.h"
 #include "atom/browser/notifications/platform_notification_service.h"
 #include "atom/browser/session_preferences.h"
+#include "atom/browser/spare_renderer_pool.h"
 #include "atom/browser/ui/devtools_manager_delegate.h"
 #include "atom/browser/web_contents_permission_helper.h"
 #include "atom/browser/web_contents_preferences.h"
 #include "atom/browser/window_list.h"
 #include "atom/common/google_api_key.h"
+#include "atom/common/node_service.mojom.h"
 #include "atom/common/options_switches.h"
 #include "atom/common/platform_util.h"
 #include "base/command_line.h"
@@ -121,6 +123,10 @@ bool IsSameWebSite(content::BrowserContext* browser_context,
              src_url;
 }
 
+base::string16 GetNodeServiceDisplayName() {
+  return base::ASCIIToUTF16("Electron Node Service");
+}
+
 }  // namespace
 
 // static
@@ -229,6 +235,8 @@ void AtomBrowserClient::RenderProcessWillLaunch(
   ProcessPreferences prefs;
   auto* web_preferences =
       WebContentsPreferences::From(GetWebContentsFromProcessID(process_id));
+  if (!web_preferences)
+    web_preferences = SpareRendererPool::GetPreferencesForSpare(process_id);
   if (web_preferences) {
     prefs.sandbox = web_preferences->IsEnabled(options::kSandbox);
     prefs.native_window_open =
@@ -323,9 +331,14 @@ void AtomBrowserClient::OverrideSiteInstanceForNavigation(
       return;
     }
 
-    *new_instance = candidate_instance;
+    // Use a renderer that was launched ahead of time if there is one.
+    auto* spare_renderers = SpareRendererPool::FromBrowserContext(
+        browser_context);
+    content::SiteInstance* spare_instance =
+        spare_renderers ? spare_renderers->Take(web_contents) : nullptr;
+    *new_instance = spare_instance ? spare_instance : candidate_instance;
     // Remember the original web contents for the pending renderer process.
-    auto* pending_process = candidate_instance->GetProcess();
+    auto* pending_process = (*new_instance)->GetProcess();
     pending_processes_[pending_process->GetID()] = web_contents;
   }
 }
@@ -381,6 +394,17 @@ void AtomBrowserClient::AppendExtraCommandLineSwitches(
       web_preferences->AppendCommandLineSwitches(command_line);
     SessionPreferences::AppendExtraCommandLineSwitches(
         web_contents->GetBrowserContext(), command_line);
+  } else {
+    // Spare renderers are launched before their WebContents exists.
+    auto* web_preferences =
+        SpareRendererPool::GetPreferencesForSpare(process_id);
+    if (web_preferences) {
+      web_preferences->AppendCommandLineSwitches(command_line);
+      command_line->AppendSwitch(switches::kSpareRenderer);
+      SessionPreferences::AppendExtraCommandLineSwitches(
+          content::RenderProcessHost::FromID(process_id)->GetBrowserContext(),
+          command_line);
+    }
   }
 }
 
@@ -551,6 +575,8 @@ void AtomBrowserClient::RegisterOutOfProcessServices(
   (*services)[proxy_resolver::mojom::kProxyResolverServiceName] =
       base::BindRepeating(&l10n_util::GetStringUTF16,
                           IDS_UTILITY_PROCESS_PROXY_RESOLVER_NAME);
+  (*services)[mojom::kNodeServiceName] =
+      base::BindRepeating(&GetNodeServiceDisplayName);
 
 #if BUILDFLAG(ENABLE_PRINTING)
   (*services)[printing::mojom::kChromePrintingServiceName] =
@@ -14,6 +14,7 @@
 #include "atom/browser/cookie_change_notifier.h"
 #include "atom/browser/net/resolve_proxy_helper.h"
 #include "atom/browser/pref_store_delegate.h"
+#include "atom/browser/spare_renderer_pool.h"
 #include "atom/browser/special_storage_policy.h"
 #include "atom/browser/ui/inspectable_web_contents_impl.h"
 #include "atom/browser/web_view_manager.h"
@@ -126,6 +127,10 @@ AtomBrowserContext::AtomBrowserContext(const std::string& partition,
 
 AtomBrowserContext::~AtomBrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Shut down the spare renderers while their hosts are still around.
+  auto* spare_renderers = SpareRendererPool::FromBrowserContext(this);
+  if (spare_renderers)
+    spare_renderers->SetProfile(0, nullptr);
   NotifyWillBeDestroyed(this);
   ShutdownStoragePartitions();
   io_handle_->ShutdownOnUIThread();
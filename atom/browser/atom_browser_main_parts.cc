@@ -12,6 +12,7 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/atom_web_ui_controller_factory.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/idle_gc_scheduler.h"
 #include "atom/browser/io_thread.h"
 #include "atom/browser/javascript_environment.h"
 #include "atom/browser/media/media_capture_devices_dispatcher.h"
@@ -20,7 +21,10 @@
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/asar/asar_util.h"
 #include "atom/common/node_bindings.h"
+#include "atom/common/sampling_profiler.h"
+#include "atom/common/startup_timeline.h"
 #include "base/command_line.h"
+#include "base/message_loop/message_loop_current.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/browser_process_impl.h"
 #include "chrome/browser/icon_manager.h"
@@ -121,6 +125,7 @@ void AtomBrowserMainParts::RegisterDestructionCallback(
 }
 
 int AtomBrowserMainParts::PreEarlyInitialization() {
+  StartupTimeline::GetInstance()->AddMark("pre-early-initialization");
   const int result = brightray::BrowserMainParts::PreEarlyInitialization();
   if (result != service_manager::RESULT_CODE_NORMAL_EXIT)
     return result;
@@ -172,6 +177,7 @@ void AtomBrowserMainParts::PostEarlyInitialization() {
 }
 
 int AtomBrowserMainParts::PreCreateThreads() {
+  StartupTimeline::GetInstance()->AddMark("pre-create-threads");
   const int result = brightray::BrowserMainParts::PreCreateThreads();
   if (!result) {
     fake_browser_process_->SetApplicationLocale(
@@ -221,6 +227,8 @@ void AtomBrowserMainParts::ToolkitInitialized() {
 }
 
 void AtomBrowserMainParts::PreMainMessageLoopRun() {
+  StartupTimeline::GetInstance()->AddMark("pre-main-message-loop-run");
+
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareMessageLoop();
@@ -231,9 +239,13 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
 #endif
 
   // Start idle gc.
-  gc_timer_.Start(FROM_HERE, base::TimeDelta::FromMinutes(1),
-                  base::Bind(&v8::Isolate::LowMemoryNotification,
-                             base::Unretained(js_env_->isolate())));
+  gc_scheduler_ = std::make_unique<IdleGCScheduler>(js_env_->isolate(),
+                                                    js_env_->platform());
+  base::MessageLoopCurrent::Get()->AddTaskObserver(gc_scheduler_.get());
+
+  // --sampling-profiler-dir
+  sampling_profiler_ =
+      SamplingProfiler::CreateFromCommandLine(js_env_->isolate(), "browser");
 
   content::WebUIControllerFactory::RegisterFactory(
       AtomWebUIControllerFactory::GetInstance());
@@ -278,6 +290,13 @@ void AtomBrowserMainParts::PostMainMessageLoopStart() {
 void AtomBrowserMainParts::PostMainMessageLoopRun() {
   brightray::BrowserMainParts::PostMainMessageLoopRun();
 
+  base::MessageLoopCurrent::Get()->RemoveTaskObserver(gc_scheduler_.get());
+  gc_scheduler_.reset();
+  sampling_profiler_.reset();
+
+  // Apps that quit before painting still get their timeline.
+  StartupTimeline::GetInstance()->WriteTraceFileIfRequested();
+
   js_env_->OnMessageLoopDestroying();
 
 #if defined(OS_MACOSX)
@@ -10,7 +10,6 @@
 #include <string>
 
 #include "base/callback.h"
-#include "base/timer/timer.h"
 #include "brightray/browser/browser_main_parts.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/common/main_function_params.h"
@@ -27,11 +26,13 @@ namespace atom {
 
 class AtomBindings;
 class Browser;
+class IdleGCScheduler;
 class IOThread;
 class JavascriptEnvironment;
 class NodeBindings;
 class NodeDebugger;
 class NodeEnvironment;
+class SamplingProfiler;
 class BridgeTaskRunner;
 
 #if defined(TOOLKIT_VIEWS)
@@ -120,7 +121,8 @@ class AtomBrowserMainParts : public brightray::BrowserMainParts {
   std::unique_ptr<net_log::ChromeNetLog> net_log_;
   std::unique_ptr<IconManager> icon_manager_;
 
-  base::RepeatingTimer gc_timer_;
+  std::unique_ptr<IdleGCScheduler> gc_scheduler_;
+  std::unique_ptr<SamplingProfiler> sampling_profiler_;
 
   // List of callbacks should be executed before destroying JS env.
   std::list<base::OnceClosure> destructors_;
@@ -13,6 +13,7 @@
 #include "atom/browser/login_handler.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/window_list.h"
+#include "atom/common/startup_timeline.h"
 #include "base/files/file_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/no_destructor.h"
@@ -153,6 +154,8 @@ void Browser::WillFinishLaunching() {
 }
 
 void Browser::DidFinishLaunching(const base::DictionaryValue& launch_info) {
+  StartupTimeline::GetInstance()->AddMark("ready");
+
   // Make sure the userData directory is created.
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::FilePath user_data;
@@ -0,0 +1,109 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/idle_gc_scheduler.h"
+
+#include "base/bind.h"
+#include "base/trace_event/trace_event.h"
+#include "v8/include/v8-platform.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+namespace {
+
+// How often the thread is checked for idleness while V8 has work left.
+const int kIdleCheckIntervalMs = 1000;
+
+// How long the thread must be without tasks to be considered idle.
+const int kQuietPeriodMs = 300;
+
+// Length of one idle period given to V8.
+const double kIdlePeriodSeconds = 0.01;
+
+// A busy thread still gets an idle period after this long, it is short
+// enough to not be noticed.
+const int kMaxDeferralSeconds = 60;
+
+}  // namespace
+
+IdleGCScheduler::IdleGCScheduler(v8::Isolate* isolate, v8::Platform* platform)
+    : isolate_(isolate), platform_(platform) {
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      base::Bind(&IdleGCScheduler::OnMemoryPressure, base::Unretained(this)));
+}
+
+IdleGCScheduler::~IdleGCScheduler() {}
+
+void IdleGCScheduler::WillProcessTask(const base::PendingTask& pending_task) {}
+
+void IdleGCScheduler::DidProcessTask(const base::PendingTask& pending_task) {
+  if (in_idle_check_) {
+    in_idle_check_ = false;
+    return;
+  }
+
+  last_activity_ = base::TimeTicks::Now();
+  if (!idle_timer_.IsRunning()) {
+    idle_timer_.Start(
+        FROM_HERE, base::TimeDelta::FromMilliseconds(kIdleCheckIntervalMs),
+        base::Bind(&IdleGCScheduler::OnIdleCheck, base::Unretained(this)));
+  }
+}
+
+void IdleGCScheduler::OnIdleCheck() {
+  in_idle_check_ = true;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (now - last_activity_ <
+      base::TimeDelta::FromMilliseconds(kQuietPeriodMs)) {
+    if (deferred_since_.is_null())
+      deferred_since_ = now;
+    if (now - deferred_since_ <
+        base::TimeDelta::FromSeconds(kMaxDeferralSeconds)) {
+      TRACE_COUNTER1("electron", "IdleGCScheduler::DeferredChecks",
+                     ++deferred_checks_);
+      return;
+    }
+  }
+  deferred_since_ = base::TimeTicks();
+
+  bool done;
+  {
+    TRACE_EVENT0("electron", "IdleGCScheduler::IdlePeriod");
+    v8::Isolate::Scope isolate_scope(isolate_);
+    done = isolate_->IdleNotificationDeadline(
+        platform_->MonotonicallyIncreasingTime() + kIdlePeriodSeconds);
+  }
+  TRACE_COUNTER1("electron", "IdleGCScheduler::IdlePeriods", ++idle_periods_);
+
+  if (done) {
+    // Wait for activity before giving V8 more time.
+    idle_timer_.Stop();
+    TRACE_COUNTER1("electron", "IdleGCScheduler::CompletedCycles",
+                   ++completed_cycles_);
+  }
+}
+
+void IdleGCScheduler::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  TRACE_EVENT1("electron", "IdleGCScheduler::OnMemoryPressure", "level",
+               static_cast<int>(level));
+  v8::Isolate::Scope isolate_scope(isolate_);
+  switch (level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kNone);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      isolate_->MemoryPressureNotification(
+          v8::MemoryPressureLevel::kModerate);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      isolate_->MemoryPressureNotification(
+          v8::MemoryPressureLevel::kCritical);
+      break;
+  }
+}
+
+}  // namespace atom
@@ -0,0 +1,69 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
+#define ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace v8 {
+class Isolate;
+class Platform;
+}  // namespace v8
+
+namespace atom {
+
+// Gives V8 time for garbage collection while the main thread is idle.
+//
+// Every task run on the main thread counts as activity, which includes input
+// and IPC. Once the thread has been quiet for a while, V8 gets short idle
+// periods with IdleNotificationDeadline, so it can do incremental marking and
+// sweeping without blocking the thread for long. The periods stop once V8
+// reports it has nothing left to do and resume on the next activity. Memory
+// pressure is forwarded to V8 immediately.
+class IdleGCScheduler : public base::MessageLoop::TaskObserver {
+ public:
+  IdleGCScheduler(v8::Isolate* isolate, v8::Platform* platform);
+  ~IdleGCScheduler() override;
+
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  // Gives V8 an idle period when the thread has been quiet long enough.
+  void OnIdleCheck();
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  v8::Isolate* isolate_;
+  v8::Platform* platform_;
+
+  base::RepeatingTimer idle_timer_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  // Time the last task other than the idle check finished.
+  base::TimeTicks last_activity_;
+  // Time the first idle check was deferred because of activity.
+  base::TimeTicks deferred_since_;
+  bool in_idle_check_ = false;
+
+  // Counters reported to tracing.
+  int64_t idle_periods_ = 0;
+  int64_t deferred_checks_ = 0;
+  int64_t completed_cycles_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleGCScheduler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
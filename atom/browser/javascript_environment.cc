@@ -7,6 +7,7 @@
 #include <string>
 
 #include "atom/browser/microtasks_runner.h"
+#include "atom/common/startup_timeline.h"
 #include "base/command_line.h"
 #include "base/message_loop/message_loop.h"
 #include "base/task_scheduler/initialization_util.h"
@@ -36,6 +37,8 @@ JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop)
 JavascriptEnvironment::~JavascriptEnvironment() = default;
 
 v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
+  StartupTimeline::GetInstance()->AddMark("javascript-environment");
+
   auto* cmd = base::CommandLine::ForCurrentProcess();
 
   // --js-flags.
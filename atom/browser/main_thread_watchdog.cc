@@ -0,0 +1,268 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/main_thread_watchdog.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "atom/common/crash_reporter/crash_reporter.h"
+#include "base/bind.h"
+#include "base/message_loop/message_loop_current.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "native_mate/converter.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+namespace {
+
+const int kMaxStackFrames = 20;
+
+// Checking the main thread a few times per threshold keeps the stack and the
+// minidump close to the moment the task went past it.
+const int kChecksPerThreshold = 4;
+
+std::string ToString(v8::Isolate* isolate, v8::Local<v8::String> value) {
+  std::string result;
+  if (!value.IsEmpty())
+    mate::ConvertFromV8(isolate, value, &result);
+  return result;
+}
+
+// Formats the stack the way V8 formats Error.stack.
+std::string GetJavaScriptStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> stack_trace =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string stack;
+  for (int i = 0; i < stack_trace->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = stack_trace->GetFrame(isolate, i);
+    std::string function_name = ToString(isolate, frame->GetFunctionName());
+    std::string script_name = ToString(isolate, frame->GetScriptName());
+    if (!stack.empty())
+      stack += "\n";
+    if (function_name.empty()) {
+      base::StringAppendF(&stack, "    at %s:%d:%d", script_name.c_str(),
+                          frame->GetLineNumber(), frame->GetColumn());
+    } else {
+      base::StringAppendF(&stack, "    at %s (%s:%d:%d)",
+                          function_name.c_str(), script_name.c_str(),
+                          frame->GetLineNumber(), frame->GetColumn());
+    }
+  }
+  return stack;
+}
+
+}  // namespace
+
+// Passed to the interrupt, which may only run once the work is over or the
+// watchdog is gone.
+struct MainThreadWatchdog::StackRequest {
+  base::WeakPtr<MainThreadWatchdog> watchdog;
+  int work_id;
+};
+
+// Checks the work of the main thread a few times per threshold on a task
+// scheduler sequence. The watchdog does not wait for the sequence when it
+// goes away, it clears |isolate_| and the next check stops.
+class MainThreadWatchdog::Monitor
+    : public base::RefCountedThreadSafe<Monitor> {
+ public:
+  Monitor(v8::Isolate* isolate,
+          base::TimeDelta threshold,
+          base::TimeDelta dump_threshold,
+          base::WeakPtr<MainThreadWatchdog> watchdog)
+      : isolate_(isolate),
+        threshold_(threshold),
+        dump_threshold_(dump_threshold),
+        watchdog_(watchdog),
+        task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+            {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
+    base::TimeDelta shortest = dump_threshold_.is_zero()
+                                   ? threshold_
+                                   : std::min(threshold_, dump_threshold_);
+    check_interval_ = std::max(shortest / kChecksPerThreshold,
+                               base::TimeDelta::FromMilliseconds(1));
+    ScheduleCheck();
+  }
+
+  // Called on the main thread.
+  void WorkStarted(base::TimeTicks start, int work_id) {
+    base::AutoLock auto_lock(lock_);
+    work_start_ = start;
+    work_id_ = work_id;
+  }
+
+  // Returns whether a minidump was written while the work was running.
+  bool WorkFinished() {
+    base::AutoLock auto_lock(lock_);
+    work_start_ = base::TimeTicks();
+    return dumped_id_ == work_id_;
+  }
+
+  void Shutdown() {
+    base::AutoLock auto_lock(lock_);
+    isolate_ = nullptr;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Monitor>;
+
+  ~Monitor() {}
+
+  void Check() {
+    int work_id = 0;
+    bool dump = false;
+    {
+      base::AutoLock auto_lock(lock_);
+      if (!isolate_)
+        return;
+      if (!work_start_.is_null()) {
+        work_id = work_id_;
+        base::TimeDelta elapsed = base::TimeTicks::Now() - work_start_;
+        if (elapsed >= threshold_ && stack_requested_id_ != work_id) {
+          stack_requested_id_ = work_id;
+          // V8 runs the interrupt on the main thread the next time it checks
+          // its stack guard, which only happens while JavaScript is running.
+          isolate_->RequestInterrupt(&MainThreadWatchdog::CaptureStack,
+                                     new StackRequest{watchdog_, work_id});
+        }
+        if (!dump_threshold_.is_zero() && elapsed >= dump_threshold_ &&
+            dump_requested_id_ != work_id) {
+          dump_requested_id_ = work_id;
+          dump = true;
+        }
+      }
+    }
+
+    // The minidump has the stacks of all threads, including the blocked main
+    // thread.
+    if (dump &&
+        crash_reporter::CrashReporter::GetInstance()->DumpWithoutCrashing()) {
+      base::AutoLock auto_lock(lock_);
+      dumped_id_ = work_id;
+    }
+
+    ScheduleCheck();
+  }
+
+  void ScheduleCheck() {
+    task_runner_->PostDelayedTask(FROM_HERE,
+                                  base::BindOnce(&Monitor::Check, this),
+                                  check_interval_);
+  }
+
+  base::Lock lock_;
+  // Guarded by |lock_|, null once the watchdog is gone.
+  v8::Isolate* isolate_;
+  // Guarded by |lock_|, written on the main thread. |work_start_| is null
+  // when no work is watched.
+  base::TimeTicks work_start_;
+  int work_id_ = 0;
+  // Guarded by |lock_|, written on the monitor's sequence.
+  int dumped_id_ = 0;
+
+  // Only used on the monitor's sequence.
+  int stack_requested_id_ = 0;
+  int dump_requested_id_ = 0;
+
+  base::TimeDelta threshold_;
+  base::TimeDelta dump_threshold_;
+  base::TimeDelta check_interval_;
+  // Copied by the monitor, only dereferenced on the main thread.
+  base::WeakPtr<MainThreadWatchdog> watchdog_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(Monitor);
+};
+
+MainThreadWatchdog::MainThreadWatchdog(v8::Isolate* isolate,
+                                       base::TimeDelta threshold,
+                                       base::TimeDelta dump_threshold,
+                                       const LongTaskCallback& callback)
+    : threshold_(threshold), callback_(callback), weak_factory_(this) {
+  monitor_ = new Monitor(isolate, threshold, dump_threshold,
+                         weak_factory_.GetWeakPtr());
+  base::MessageLoopCurrent::Get()->AddTaskObserver(this);
+  NodeBindings::AddUvWorkObserver(this);
+}
+
+MainThreadWatchdog::~MainThreadWatchdog() {
+  NodeBindings::RemoveUvWorkObserver(this);
+  base::MessageLoopCurrent::Get()->RemoveTaskObserver(this);
+  monitor_->Shutdown();
+}
+
+void MainThreadWatchdog::WillProcessTask(
+    const base::PendingTask& pending_task) {
+  WillRunWork(pending_task.posted_from);
+}
+
+void MainThreadWatchdog::DidProcessTask(const base::PendingTask& pending_task) {
+  DidRunWork();
+}
+
+void MainThreadWatchdog::WillRunUvWork() {
+  // Node.js callbacks are not posted from anywhere.
+  WillRunWork(base::Location("uv_run", "", 0, nullptr));
+}
+
+void MainThreadWatchdog::DidRunUvWork() {
+  DidRunWork();
+}
+
+void MainThreadWatchdog::WillRunWork(const base::Location& posted_from) {
+  ++work_depth_;
+  posted_from_ = posted_from;
+  stack_.clear();
+  work_start_ = base::TimeTicks::Now();
+  monitor_->WorkStarted(work_start_, ++work_id_);
+}
+
+void MainThreadWatchdog::DidRunWork() {
+  // The work that created the watchdog was not seen starting.
+  if (work_depth_ == 0)
+    return;
+  --work_depth_;
+  // The outer work of a nested message loop, the work run by the loop was
+  // watched instead.
+  if (work_start_.is_null())
+    return;
+  LongTask task;
+  task.duration = base::TimeTicks::Now() - work_start_;
+  task.dumped = monitor_->WorkFinished();
+  work_start_ = base::TimeTicks();
+  if (task.duration < threshold_)
+    return;
+
+  task.posted_from = posted_from_;
+  task.stack = std::move(stack_);
+  // Not reported from inside the observer, the callback runs JavaScript.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&MainThreadWatchdog::ReportLongTask,
+                                weak_factory_.GetWeakPtr(), task));
+}
+
+// static
+void MainThreadWatchdog::CaptureStack(v8::Isolate* isolate, void* data) {
+  std::unique_ptr<StackRequest> request(static_cast<StackRequest*>(data));
+  MainThreadWatchdog* self = request->watchdog.get();
+  if (!self || self->work_id_ != request->work_id ||
+      self->work_start_.is_null())
+    return;
+  self->stack_ = GetJavaScriptStack(isolate);
+}
+
+void MainThreadWatchdog::ReportLongTask(const LongTask& task) {
+  callback_.Run(task);
+}
+
+}  // namespace atom
@@ -0,0 +1,99 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_MAIN_THREAD_WATCHDOG_H_
+#define ATOM_BROWSER_MAIN_THREAD_WATCHDOG_H_
+
+#include <string>
+
+#include "atom/common/node_bindings.h"
+#include "base/callback.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace atom {
+
+// Watches the work of the browser process's main thread from a task scheduler
+// sequence, and reports the work that ran longer than a threshold together
+// with where it was posted from and the JavaScript stack it was blocked in.
+// The watched work is the tasks and the runs of the libuv loop, native events
+// dispatched outside of a task are not watched.
+//
+// The innermost work is watched, a task that runs a nested message loop, like
+// a synchronous dialog, is not reported but the work run by the loop is.
+class MainThreadWatchdog : public base::MessageLoop::TaskObserver,
+                           public NodeBindings::UvWorkObserver {
+ public:
+  struct LongTask {
+    base::TimeDelta duration;
+    base::Location posted_from;
+    // The JavaScript stack of the main thread once the task was past the
+    // threshold, empty when it was not running JavaScript.
+    std::string stack;
+    // Whether a minidump was written while the task was running.
+    bool dumped = false;
+  };
+
+  using LongTaskCallback = base::RepeatingCallback<void(const LongTask&)>;
+
+  // Writes a minidump through the crash reporter once a task is running for
+  // |dump_threshold|, a zero |dump_threshold| never writes one.
+  MainThreadWatchdog(v8::Isolate* isolate,
+                     base::TimeDelta threshold,
+                     base::TimeDelta dump_threshold,
+                     const LongTaskCallback& callback);
+  ~MainThreadWatchdog() override;
+
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+  // NodeBindings::UvWorkObserver:
+  void WillRunUvWork() override;
+  void DidRunUvWork() override;
+
+ private:
+  class Monitor;
+  struct StackRequest;
+
+  void WillRunWork(const base::Location& posted_from);
+  void DidRunWork();
+
+  // Runs on the main thread when V8 handles the interrupt requested by the
+  // monitor.
+  static void CaptureStack(v8::Isolate* isolate, void* data);
+
+  void ReportLongTask(const LongTask& task);
+
+  base::TimeDelta threshold_;
+  LongTaskCallback callback_;
+
+  // Shared with the monitor's sequence, which outlives the watchdog until
+  // its next check.
+  scoped_refptr<Monitor> monitor_;
+
+  // Start of the innermost work running on the main thread, null once it is
+  // over.
+  base::TimeTicks work_start_;
+  int work_depth_ = 0;
+  int work_id_ = 0;
+  base::Location posted_from_;
+  std::string stack_;
+
+  base::WeakPtrFactory<MainThreadWatchdog> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(MainThreadWatchdog);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_MAIN_THREAD_WATCHDOG_H_
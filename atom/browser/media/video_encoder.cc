@@ -0,0 +1,404 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/media/video_encoder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/single_thread_task_runner.h"
+#include "base/sys_info.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "third_party/libvpx/source/libvpx/vpx/vp8cx.h"
+#include "third_party/libvpx/source/libvpx/vpx/vpx_encoder.h"
+#include "third_party/libwebm/source/mkvmuxer/mkvmuxer.h"
+#include "third_party/libyuv/include/libyuv.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace atom {
+
+namespace {
+
+// Speed settings for realtime encoding, higher is faster.
+const int kVp8CpuUsed = 8;
+const int kVp9CpuUsed = 6;
+
+const int kMaxEncoderThreads = 4;
+
+// Writes the muxed stream to a file, or collects it for the data callback.
+class WebmWriter : public mkvmuxer::IMkvWriter {
+ public:
+  explicit WebmWriter(base::File file) : file_(std::move(file)) {}
+  WebmWriter() {}
+  ~WebmWriter() override {}
+
+  bool is_file() const { return file_.IsValid(); }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+  // mkvmuxer::IMkvWriter:
+  mkvmuxer::int32 Write(const void* buffer, mkvmuxer::uint32 length) override {
+    const char* bytes = static_cast<const char*>(buffer);
+    if (is_file()) {
+      if (file_.Write(position_, bytes, length) != static_cast<int>(length))
+        return -1;
+    } else {
+      data_.insert(data_.end(), bytes, bytes + length);
+    }
+    position_ += length;
+    return 0;
+  }
+
+  mkvmuxer::int64 Position() const override { return position_; }
+
+  mkvmuxer::int32 Position(mkvmuxer::int64 position) override {
+    if (!is_file())
+      return -1;
+    position_ = position;
+    return 0;
+  }
+
+  bool Seekable() const override { return is_file(); }
+
+  void ElementStartNotify(mkvmuxer::uint64 element_id,
+                          mkvmuxer::int64 position) override {}
+
+ private:
+  base::File file_;
+  std::vector<uint8_t> data_;
+  int64_t position_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(WebmWriter);
+};
+
+}  // namespace
+
+// Lives on the encoder sequence, except for the stats which are guarded by
+// |lock_|.
+class VideoEncoder::Core {
+ public:
+  Core(const Options& options,
+       scoped_refptr<base::SingleThreadTaskRunner> origin_task_runner,
+       base::WeakPtr<VideoEncoder> encoder)
+      : options_(options),
+        origin_task_runner_(origin_task_runner),
+        encoder_(encoder) {}
+
+  ~Core() {
+    Finish();
+    if (codec_initialized_)
+      vpx_codec_destroy(&codec_);
+  }
+
+  // Called on the origin thread, returns whether there is room for another
+  // frame in a queue of |max_queued_frames|.
+  bool QueueFrame(uint32_t max_queued_frames) {
+    base::AutoLock lock(lock_);
+    if (stats_.queued_frames >= max_queued_frames) {
+      ++stats_.dropped_frames;
+      return false;
+    }
+    ++stats_.queued_frames;
+    return true;
+  }
+
+  Stats GetStats() const {
+    base::AutoLock lock(lock_);
+    return stats_;
+  }
+
+  void Encode(std::vector<uint8_t> pixels,
+              const gfx::Size& frame_size,
+              bool rgba,
+              base::TimeTicks timestamp) {
+    {
+      base::AutoLock lock(lock_);
+      --stats_.queued_frames;
+    }
+    if (failed_ || finished_)
+      return;
+    if (!codec_initialized_ && !Initialize(frame_size)) {
+      Fail("Failed to initialize the video encoder");
+      return;
+    }
+
+    // The stream keeps the size of the first frame.
+    const uint8_t* argb = pixels.data();
+    int argb_stride = frame_size.width() * 4;
+    if (frame_size != size_) {
+      scaled_.resize(size_.GetArea() * 4);
+      libyuv::ARGBScale(argb, argb_stride, frame_size.width(),
+                        frame_size.height(), scaled_.data(),
+                        size_.width() * 4, size_.width(), size_.height(),
+                        libyuv::kFilterBilinear);
+      argb = scaled_.data();
+      argb_stride = size_.width() * 4;
+    }
+
+    int width = size_.width();
+    int height = size_.height();
+    uint8_t* y = i420_.data();
+    uint8_t* u = y + width * height;
+    uint8_t* v = u + (width / 2) * (height / 2);
+    auto convert = rgba ? &libyuv::ABGRToI420 : &libyuv::ARGBToI420;
+    convert(argb, argb_stride, y, width, u, width / 2, v, width / 2, width,
+            height);
+
+    vpx_image_t image;
+    vpx_img_wrap(&image, VPX_IMG_FMT_I420, width, height, 1, i420_.data());
+
+    if (first_timestamp_.is_null())
+      first_timestamp_ = timestamp;
+    int64_t pts = (timestamp - first_timestamp_).InMilliseconds();
+    if (pts <= last_pts_)
+      pts = last_pts_ + 1;
+    last_pts_ = pts;
+
+    if (vpx_codec_encode(&codec_, &image, pts, 1, 0, VPX_DL_REALTIME) !=
+            VPX_CODEC_OK ||
+        !WritePackets()) {
+      Fail("Failed to encode a frame");
+      return;
+    }
+
+    base::TimeDelta latency = base::TimeTicks::Now() - timestamp;
+    {
+      base::AutoLock lock(lock_);
+      ++stats_.encoded_frames;
+      total_latency_ += latency;
+      stats_.average_latency = total_latency_ / stats_.encoded_frames;
+      stats_.max_latency = std::max(stats_.max_latency, latency);
+    }
+    FlushData();
+  }
+
+  // Drains the encoder and finishes the stream.
+  void Finish() {
+    if (finished_)
+      return;
+    finished_ = true;
+    if (!codec_initialized_ || failed_)
+      return;
+
+    if (vpx_codec_encode(&codec_, nullptr, -1, 1, 0, VPX_DL_REALTIME) !=
+            VPX_CODEC_OK ||
+        !WritePackets() || !segment_.Finalize()) {
+      Fail("Failed to finish the video stream");
+      return;
+    }
+    FlushData();
+  }
+
+ private:
+  bool Initialize(const gfx::Size& frame_size) {
+    // I420 needs even dimensions.
+    size_.SetSize(std::max(2, frame_size.width() & ~1),
+                  std::max(2, frame_size.height() & ~1));
+    i420_.resize(size_.GetArea() * 3 / 2);
+
+    if (options_.path.empty()) {
+      writer_.reset(new WebmWriter());
+    } else {
+      base::File file(options_.path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+      if (!file.IsValid())
+        return false;
+      writer_.reset(new WebmWriter(std::move(file)));
+    }
+
+    bool vp9 = options_.codec == Codec::VP9;
+    vpx_codec_iface_t* codec_interface =
+        vp9 ? vpx_codec_vp9_cx() : vpx_codec_vp8_cx();
+    vpx_codec_enc_cfg_t config;
+    if (vpx_codec_enc_config_default(codec_interface, &config, 0) !=
+        VPX_CODEC_OK)
+      return false;
+    config.g_w = size_.width();
+    config.g_h = size_.height();
+    config.g_timebase.num = 1;
+    config.g_timebase.den = base::Time::kMillisecondsPerSecond;
+    config.g_lag_in_frames = 0;
+    config.g_threads =
+        std::min(base::SysInfo::NumberOfProcessors(), kMaxEncoderThreads);
+    config.rc_end_usage = VPX_VBR;
+    config.rc_target_bitrate = options_.bitrate;
+    config.kf_mode = VPX_KF_AUTO;
+    config.kf_min_dist = 0;
+    config.kf_max_dist = options_.keyframe_interval;
+    if (vpx_codec_enc_init(&codec_, codec_interface, &config, 0) !=
+        VPX_CODEC_OK)
+      return false;
+    codec_initialized_ = true;
+    vpx_codec_control(&codec_, VP8E_SET_CPUUSED,
+                      vp9 ? kVp9CpuUsed : kVp8CpuUsed);
+
+    if (!segment_.Init(writer_.get()))
+      return false;
+    segment_.set_mode(writer_->is_file() ? mkvmuxer::Segment::kFile
+                                         : mkvmuxer::Segment::kLive);
+    segment_.OutputCues(writer_->is_file());
+    segment_.GetSegmentInfo()->set_writing_app(ATOM_PRODUCT_NAME);
+    track_number_ = segment_.AddVideoTrack(size_.width(), size_.height(), 0);
+    auto* track = static_cast<mkvmuxer::VideoTrack*>(
+        segment_.GetTrackByNumber(track_number_));
+    if (!track)
+      return false;
+    track->set_codec_id(vp9 ? mkvmuxer::Tracks::kVp9CodecId
+                            : mkvmuxer::Tracks::kVp8CodecId);
+    return true;
+  }
+
+  bool WritePackets() {
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t* packet;
+    while ((packet = vpx_codec_get_cx_data(&codec_, &iter))) {
+      if (packet->kind != VPX_CODEC_CX_FRAME_PKT)
+        continue;
+      bool keyframe = packet->data.frame.flags & VPX_FRAME_IS_KEY;
+      uint64_t timestamp =
+          packet->data.frame.pts * base::Time::kNanosecondsPerMillisecond;
+      if (!segment_.AddFrame(
+              static_cast<const uint8_t*>(packet->data.frame.buf),
+              packet->data.frame.sz, track_number_, timestamp, keyframe))
+        return false;
+
+      base::AutoLock lock(lock_);
+      if (keyframe)
+        ++stats_.keyframes;
+      stats_.bytes_written += packet->data.frame.sz;
+      // Bits per millisecond are kilobits per second.
+      if (last_pts_ > 0)
+        stats_.bitrate = stats_.bytes_written * 8.0 / last_pts_;
+    }
+    return true;
+  }
+
+  void FlushData() {
+    if (!writer_ || writer_->is_file())
+      return;
+    std::vector<uint8_t> data = writer_->TakeData();
+    if (!data.empty()) {
+      origin_task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&VideoEncoder::OnData, encoder_,
+                                    std::move(data)));
+    }
+  }
+
+  void Fail(const std::string& error) {
+    failed_ = true;
+    origin_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&VideoEncoder::OnError, encoder_, error));
+  }
+
+  Options options_;
+  scoped_refptr<base::SingleThreadTaskRunner> origin_task_runner_;
+  base::WeakPtr<VideoEncoder> encoder_;
+
+  gfx::Size size_;
+  std::vector<uint8_t> scaled_;
+  std::vector<uint8_t> i420_;
+
+  vpx_codec_ctx_t codec_;
+  bool codec_initialized_ = false;
+  std::unique_ptr<WebmWriter> writer_;
+  mkvmuxer::Segment segment_;
+  uint64_t track_number_ = 0;
+
+  base::TimeTicks first_timestamp_;
+  int64_t last_pts_ = -1;
+  bool failed_ = false;
+  bool finished_ = false;
+
+  mutable base::Lock lock_;
+  Stats stats_;
+  base::TimeDelta total_latency_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+VideoEncoder::Options::Options() {}
+
+VideoEncoder::Options::Options(const Options& other) = default;
+
+VideoEncoder::Options::~Options() {}
+
+// Shutdown waits for the encoder sequence so a stream that is being written
+// is still finalized, the bounded queue keeps the wait short.
+VideoEncoder::VideoEncoder(const Options& options,
+                           const DataCallback& data_callback,
+                           const ErrorCallback& error_callback)
+    : task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      max_queued_frames_(std::max(options.max_queued_frames, 1u)),
+      data_callback_(data_callback),
+      error_callback_(error_callback),
+      weak_factory_(this) {
+  if (options.frame_rate > 0)
+    frame_interval_ = base::TimeDelta::FromSeconds(1) / options.frame_rate;
+  core_.reset(new Core(options, base::ThreadTaskRunnerHandle::Get(),
+                       weak_factory_.GetWeakPtr()));
+}
+
+VideoEncoder::~VideoEncoder() {
+  // Queued frames are still encoded and the stream is finished before the
+  // core goes away.
+  task_runner_->DeleteSoon(FROM_HERE, core_.release());
+}
+
+bool VideoEncoder::EncodeFrame(const SkBitmap& frame) {
+  if (stopped_ || frame.drawsNothing())
+    return false;
+
+  // Skipped frames are not counted as dropped, the encoder is not behind.
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (!last_frame_time_.is_null() && now - last_frame_time_ < frame_interval_)
+    return false;
+  if (!core_->QueueFrame(max_queued_frames_))
+    return false;
+  last_frame_time_ = now;
+
+  int width = frame.width();
+  int height = frame.height();
+  std::vector<uint8_t> pixels(width * height * 4);
+  for (int y = 0; y < height; ++y)
+    memcpy(&pixels[y * width * 4], frame.getAddr32(0, y), width * 4);
+
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Core::Encode, base::Unretained(core_.get()),
+                     std::move(pixels), gfx::Size(width, height),
+                     frame.colorType() == kRGBA_8888_SkColorType, now));
+  return true;
+}
+
+void VideoEncoder::Stop(base::OnceClosure callback) {
+  stopped_ = true;
+  task_runner_->PostTaskAndReply(
+      FROM_HERE, base::BindOnce(&Core::Finish, base::Unretained(core_.get())),
+      std::move(callback));
+}
+
+VideoEncoder::Stats VideoEncoder::GetStats() const {
+  return core_->GetStats();
+}
+
+void VideoEncoder::OnData(const std::vector<uint8_t>& data) {
+  if (!data_callback_.is_null())
+    data_callback_.Run(data);
+}
+
+void VideoEncoder::OnError(const std::string& error) {
+  stopped_ = true;
+  if (!error_callback_.is_null())
+    error_callback_.Run(error);
+}
+
+}  // namespace atom
@@ -0,0 +1,112 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_MEDIA_VIDEO_ENCODER_H_
+#define ATOM_BROWSER_MEDIA_VIDEO_ENCODER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+class SkBitmap;
+
+namespace atom {
+
+// Encodes captured frames to a WebM stream with libvpx.
+//
+// Frames are copied on the calling thread and converted, encoded and muxed
+// on a worker sequence, so the calling thread only pays for one copy per
+// frame. Frames are dropped while |max_queued_frames| frames are waiting for
+// the encoder, and frames arriving faster than |frame_rate| are skipped.
+class VideoEncoder {
+ public:
+  enum class Codec {
+    VP8,
+    VP9,
+  };
+
+  struct Options {
+    Options();
+    Options(const Options& other);
+    ~Options();
+
+    // File the WebM stream is written to, when empty the stream is passed to
+    // the data callback instead.
+    base::FilePath path;
+    Codec codec = Codec::VP8;
+    // Target bitrate in kilobits per second.
+    uint32_t bitrate = 2500;
+    // Maximum number of frames between two keyframes.
+    uint32_t keyframe_interval = 120;
+    uint32_t max_queued_frames = 4;
+    // Maximum number of frames encoded per second, 0 encodes every frame.
+    uint32_t frame_rate = 0;
+  };
+
+  struct Stats {
+    uint64_t encoded_frames = 0;
+    uint64_t dropped_frames = 0;
+    uint64_t keyframes = 0;
+    uint64_t bytes_written = 0;
+    uint32_t queued_frames = 0;
+    // Bitrate of the encoded stream in kilobits per second.
+    double bitrate = 0;
+    // Time from a frame being submitted to it being written.
+    base::TimeDelta average_latency;
+    base::TimeDelta max_latency;
+  };
+
+  using DataCallback = base::Callback<void(const std::vector<uint8_t>&)>;
+  using ErrorCallback = base::Callback<void(const std::string&)>;
+
+  // |data_callback| receives the stream when no path is set, and
+  // |error_callback| is called once the encoder failed. Both are called on
+  // the calling thread.
+  VideoEncoder(const Options& options,
+               const DataCallback& data_callback,
+               const ErrorCallback& error_callback);
+  ~VideoEncoder();
+
+  // Queues |frame| for encoding, returns false when it was dropped or
+  // skipped.
+  bool EncodeFrame(const SkBitmap& frame);
+
+  // Flushes the encoder and finishes the stream, |callback| is called once
+  // everything was written.
+  void Stop(base::OnceClosure callback);
+
+  Stats GetStats() const;
+
+ private:
+  class Core;
+
+  void OnData(const std::vector<uint8_t>& data);
+  void OnError(const std::string& error);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<Core> core_;
+  uint32_t max_queued_frames_;
+  base::TimeDelta frame_interval_;
+  base::TimeTicks last_frame_time_;
+  bool stopped_ = false;
+
+  DataCallback data_callback_;
+  ErrorCallback error_callback_;
+
+  base::WeakPtrFactory<VideoEncoder> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(VideoEncoder);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_MEDIA_VIDEO_ENCODER_H_
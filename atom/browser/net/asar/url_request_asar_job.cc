@@ -13,7 +13,13 @@
 #include "atom/common/atom_constants.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/format_macros.h"
+#include "base/i18n/time_formatting.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/lock.h"
 #include "base/task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -24,6 +30,9 @@
 #include "net/base/mime_util.h"
 #include "net/base/net_errors.h"
 #include "net/filter/gzip_source_stream.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
 #include "net/http/http_util.h"
 #include "net/url_request/url_request_status.h"
 
@@ -102,6 +111,7 @@ void URLRequestAsarJob::Start() {
     file_task_runner_->PostTaskAndReply(
         FROM_HERE,
         base::BindOnce(&URLRequestAsarJob::FetchMetaInfo, file_path_, type_,
+                       conditional_requests_enabled_,
                        base::Unretained(meta_info)),
         base::BindOnce(&URLRequestAsarJob::DidFetchMetaInfo,
                        weak_ptr_factory_.GetWeakPtr(), base::Owned(meta_info)));
@@ -180,6 +190,10 @@ std::unique_ptr<net::SourceStream> URLRequestAsarJob::SetUpSourceStream() {
 }
 
 bool URLRequestAsarJob::GetMimeType(std::string* mime_type) const {
+  if (!mime_type_override_.empty()) {
+    *mime_type = mime_type_override_;
+    return true;
+  }
   if (meta_info_.mime_type_result) {
     *mime_type = meta_info_.mime_type;
     return true;
@@ -199,28 +213,102 @@ void URLRequestAsarJob::SetExtraRequestHeaders(
     if (net::HttpUtil::ParseRangeHeader(range_header, &ranges)) {
       if (ranges.size() == 1) {
         byte_range_ = ranges[0];
+        has_byte_range_ = true;
       } else {
         range_parse_result_ = net::ERR_REQUEST_RANGE_NOT_SATISFIABLE;
       }
     }
   }
+
+  if (conditional_requests_enabled_) {
+    headers.GetHeader(net::HttpRequestHeaders::kIfNoneMatch, &if_none_match_);
+    headers.GetHeader(net::HttpRequestHeaders::kIfModifiedSince,
+                      &if_modified_since_);
+  }
 }
 
 int URLRequestAsarJob::GetResponseCode() const {
+  if (not_modified_)
+    return 304;
+  if (conditional_requests_enabled_ && has_byte_range_)
+    return 206;
   // Request Job gets created only if path exists.
   return 200;
 }
 
 void URLRequestAsarJob::GetResponseInfo(net::HttpResponseInfo* info) {
-  std::string status("HTTP/1.1 200 OK");
+  if (!conditional_requests_enabled_) {
+    std::string status("HTTP/1.1 200 OK");
+    auto* headers = new net::HttpResponseHeaders(status);
+
+    headers->AddHeader(atom::kCORSHeader);
+    info->headers = headers;
+    return;
+  }
+
+  int status_code = GetResponseCode();
+  std::string status("HTTP/1.1 ");
+  status.append(base::IntToString(status_code));
+  status.append(" ");
+  status.append(
+      net::GetHttpReasonPhrase(static_cast<net::HttpStatusCode>(status_code)));
+  status.append("\0\0", 2);
   auto* headers = new net::HttpResponseHeaders(status);
 
   headers->AddHeader(atom::kCORSHeader);
+  headers->AddHeader("Accept-Ranges: bytes");
+  headers->AddHeader("ETag: " + GetETag());
+  if (!meta_info_.last_modified.is_null()) {
+    headers->AddHeader(
+        "Last-Modified: " +
+        base::UTF16ToASCII(base::TimeFormatHTTP(meta_info_.last_modified)));
+  }
+  if (status_code == 206) {
+    headers->AddHeader(base::StringPrintf(
+        "Content-Range: bytes %" PRId64 "-%" PRId64 "/%" PRId64,
+        byte_range_.first_byte_position(), byte_range_.last_byte_position(),
+        meta_info_.file_size));
+  }
   info->headers = headers;
 }
 
+std::string URLRequestAsarJob::GetETag() const {
+  uint64_t offset = type_ == TYPE_ASAR ? file_info_.offset : 0;
+  return base::StringPrintf(
+      "\"%" PRIx64 "-%" PRIx64 "-%" PRIx64 "\"",
+      static_cast<uint64_t>(
+          meta_info_.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds()),
+      offset, static_cast<uint64_t>(meta_info_.file_size));
+}
+
+bool URLRequestAsarJob::IsNotModified() const {
+  // If-None-Match takes precedence over If-Modified-Since.
+  if (!if_none_match_.empty()) {
+    const std::string etag = GetETag();
+    for (base::StringPiece tag :
+         base::SplitStringPiece(if_none_match_, ",", base::TRIM_WHITESPACE,
+                                base::SPLIT_WANT_NONEMPTY)) {
+      // Weak comparison, as for GET requests.
+      if (tag.starts_with("W/"))
+        tag.remove_prefix(2);
+      if (tag == "*" || tag == etag)
+        return true;
+    }
+    return false;
+  }
+
+  base::Time modified_since;
+  if (!if_modified_since_.empty() && !meta_info_.last_modified.is_null() &&
+      base::Time::FromString(if_modified_since_.c_str(), &modified_since)) {
+    // HTTP dates have a resolution of one second.
+    return meta_info_.last_modified.ToTimeT() <= modified_since.ToTimeT();
+  }
+  return false;
+}
+
 void URLRequestAsarJob::FetchMetaInfo(const base::FilePath& file_path,
                                       JobType type,
+                                      bool fetch_last_modified,
                                       FileMetaInfo* meta_info) {
   if (type == TYPE_FILE) {
     base::File::Info file_info;
@@ -229,7 +317,13 @@ void URLRequestAsarJob::FetchMetaInfo(const base::FilePath& file_path,
       meta_info->file_path = file_path;
       meta_info->file_size = file_info.size;
       meta_info->is_directory = file_info.is_directory;
+      meta_info->last_modified = file_info.last_modified;
     }
+  } else if (type == TYPE_ASAR && fetch_last_modified) {
+    // Files in an archive share the modification time of the archive.
+    base::File::Info archive_info;
+    if (base::GetFileInfo(meta_info->file_path, &archive_info))
+      meta_info->last_modified = archive_info.last_modified;
   }
 
   // We use GetWellKnownMimeTypeFromExtension() to ensure that configurations
@@ -255,6 +349,14 @@ void URLRequestAsarJob::DidFetchMetaInfo(const FileMetaInfo* meta_info) {
     return;
   }
 
+  if (conditional_requests_enabled_ && IsNotModified()) {
+    // The client already has the file, send the headers only.
+    not_modified_ = true;
+    set_expected_content_size(0);
+    NotifyHeadersComplete();
+    return;
+  }
+
   int flags =
       base::File::FLAG_OPEN | base::File::FLAG_READ | base::File::FLAG_ASYNC;
   int rv = stream_->Open(
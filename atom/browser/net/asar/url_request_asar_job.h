@@ -13,6 +13,7 @@
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "net/http/http_byte_range.h"
 #include "net/url_request/url_request_job.h"
 
@@ -41,6 +42,15 @@ class URLRequestAsarJob : public net::URLRequestJob {
   void Initialize(const scoped_refptr<base::TaskRunner> file_task_runner,
                   const base::FilePath& file_path);
 
+  // Adds ETag/Last-Modified validators to the response, answers conditional
+  // requests with 304 and range requests with 206.
+  void EnableConditionalRequests() { conditional_requests_enabled_ = true; }
+
+  // Uses |mime_type| instead of the one guessed from the file extension.
+  void set_mime_type_override(const std::string& mime_type) {
+    mime_type_override_ = mime_type;
+  }
+
  protected:
   ~URLRequestAsarJob() override;
 
@@ -89,6 +99,9 @@ class URLRequestAsarJob : public net::URLRequestJob {
     bool is_directory = false;
     // Path to the file.
     base::FilePath file_path;
+    // Last modification time of the file, or of the archive for asar files.
+    // Only fetched when conditional requests are enabled.
+    base::Time last_modified;
 
     FileMetaInfo();
   };
@@ -96,6 +109,7 @@ class URLRequestAsarJob : public net::URLRequestJob {
   // Fetches file info on a background thread.
   static void FetchMetaInfo(const base::FilePath& file_path,
                             JobType type,
+                            bool fetch_last_modified,
                             FileMetaInfo* meta_info);
 
   // Callback after fetching file info on a background thread.
@@ -111,6 +125,13 @@ class URLRequestAsarJob : public net::URLRequestJob {
   // Callback after data is asynchronously read from the file into |buf|.
   void DidRead(scoped_refptr<net::IOBuffer> buf, int result);
 
+  // Returns the entity tag of the file, derived from its size, position and
+  // modification time.
+  std::string GetETag() const;
+
+  // Whether the validators sent with the request match the file.
+  bool IsNotModified() const;
+
   JobType type_ = TYPE_ERROR;
 
   std::shared_ptr<Archive> archive_;
@@ -126,6 +147,13 @@ class URLRequestAsarJob : public net::URLRequestJob {
   int64_t seek_offset_ = 0;
 
   net::Error range_parse_result_ = net::OK;
+  bool has_byte_range_ = false;
+
+  bool conditional_requests_enabled_ = false;
+  std::string if_none_match_;
+  std::string if_modified_since_;
+  bool not_modified_ = false;
+  std::string mime_type_override_;
 
   base::WeakPtrFactory<URLRequestAsarJob> weak_ptr_factory_;
 
@@ -9,6 +9,7 @@
 
 #include "atom/browser/api/atom_api_web_contents.h"
 #include "atom/browser/login_handler.h"
+#include "atom/browser/net/network_metrics_collector.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "atom/common/options_switches.h"
 #include "base/command_line.h"
@@ -267,6 +268,14 @@ void AtomNetworkDelegate::SetResponseListenerInIO(ResponseEvent type,
     response_listeners_[type] = {std::move(patterns), std::move(callback)};
 }
 
+void AtomNetworkDelegate::EnableMetricsInIO(size_t record_buffer_size) {
+  metrics_collector_.reset(new NetworkMetricsCollector(record_buffer_size));
+}
+
+void AtomNetworkDelegate::DisableMetricsInIO() {
+  metrics_collector_.reset();
+}
+
 int AtomNetworkDelegate::OnBeforeURLRequest(
     net::URLRequest* request,
     net::CompletionOnceCallback callback,
@@ -349,6 +358,9 @@ void AtomNetworkDelegate::OnCompleted(net::URLRequest* request,
   // OnCompleted may happen before other events.
   callbacks_.erase(request->identifier());
 
+  if (metrics_collector_ && started)
+    metrics_collector_->RecordRequest(request, net_error);
+
   if (request->status().status() == net::URLRequestStatus::FAILED ||
       request->status().status() == net::URLRequestStatus::CANCELED) {
     // Error event.
@@ -29,6 +29,7 @@ using URLPatterns = std::set<URLPattern>;
 const char* ResourceTypeToString(content::ResourceType type);
 
 class LoginHandler;
+class NetworkMetricsCollector;
 
 class AtomNetworkDelegate : public net::NetworkDelegate {
  public:
@@ -79,6 +80,14 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
                                URLPatterns patterns,
                                ResponseListener callback);
 
+  // Starts collecting the timing and sizes of the completed requests, keeping
+  // a binary record of the last |record_buffer_size| requests.
+  void EnableMetricsInIO(size_t record_buffer_size);
+  void DisableMetricsInIO();
+  NetworkMetricsCollector* metrics_collector() const {
+    return metrics_collector_.get();
+  }
+
  protected:
   // net::NetworkDelegate:
   int OnBeforeURLRequest(net::URLRequest* request,
@@ -171,6 +180,7 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
   std::map<ResponseEvent, ResponseListenerInfo> response_listeners_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::vector<std::string> ignore_connections_limit_domains_;
+  std::unique_ptr<NetworkMetricsCollector> metrics_collector_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomNetworkDelegate);
 };
@@ -12,12 +12,16 @@
 #include "atom/browser/api/atom_api_url_request.h"
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/net/atom_url_request_job_factory.h"
+#include "atom/browser/net/streaming_upload_data_stream.h"
+#include "atom/browser/net/url_request_context_getter.h"
 #include "base/callback.h"
+#include "base/task_scheduler/post_task.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/elements_upload_data_stream.h"
 #include "net/base/io_buffer.h"
 #include "net/base/load_flags.h"
 #include "net/base/upload_bytes_element_reader.h"
+#include "net/base/upload_file_element_reader.h"
 #include "net/url_request/redirect_info.h"
 
 namespace {
@@ -64,6 +68,7 @@ scoped_refptr<AtomURLRequest> AtomURLRequest::Create(
     const std::string& method,
     const std::string& url,
     const std::string& redirect_policy,
+    net::RequestPriority priority,
     api::URLRequest* delegate) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
@@ -81,7 +86,7 @@ scoped_refptr<AtomURLRequest> AtomURLRequest::Create(
           content::BrowserThread::IO, FROM_HERE,
           base::BindOnce(&AtomURLRequest::DoInitialize, atom_url_request,
                          request_context_getter, method, url,
-                         redirect_policy))) {
+                         redirect_policy, priority))) {
     return atom_url_request;
   }
   return nullptr;
@@ -99,7 +104,8 @@ void AtomURLRequest::DoInitialize(
     scoped_refptr<net::URLRequestContextGetter> request_context_getter,
     const std::string& method,
     const std::string& url,
-    const std::string& redirect_policy) {
+    const std::string& redirect_policy,
+    net::RequestPriority priority) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
   DCHECK(request_context_getter);
 
@@ -114,8 +120,7 @@ void AtomURLRequest::DoInitialize(
   }
 
   DCHECK(context);
-  request_ = context->CreateRequest(
-      GURL(url), net::RequestPriority::DEFAULT_PRIORITY, this);
+  request_ = context->CreateRequest(GURL(url), priority, this);
   if (!request_) {
     DoCancelWithError("Failed to create a net::URLRequest.", true);
     return;
@@ -126,11 +131,22 @@ void AtomURLRequest::DoInitialize(
   // Set a flag to stop custom protocol from intercepting this request.
   request_->SetUserData(DisableProtocolInterceptFlagKey(),
                         base::WrapUnique(new base::SupportsUserData::Data()));
+
+  auto* getter =
+      static_cast<URLRequestContextGetter*>(request_context_getter_.get());
+  scheduler_ = getter->request_scheduler();
 }
 
 void AtomURLRequest::DoTerminate() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  chunked_stream_writer_.reset();
+  streaming_stream_ = nullptr;
   request_.reset();
+  if (scheduler_) {
+    // Lets the next queued request start.
+    scheduler_->RemoveRequest(this);
+    scheduler_ = nullptr;
+  }
   if (request_context_getter_) {
     request_context_getter_->RemoveObserver(this);
     request_context_getter_ = nullptr;
@@ -145,13 +161,26 @@ bool AtomURLRequest::Write(scoped_refptr<const net::IOBufferWithSize> buffer,
       base::BindOnce(&AtomURLRequest::DoWriteBuffer, this, buffer, is_last));
 }
 
-void AtomURLRequest::SetChunkedUpload(bool is_chunked_upload) {
+bool AtomURLRequest::WriteFile(base::File file,
+                               const base::FilePath& path,
+                               uint64_t offset,
+                               uint64_t length) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  return content::BrowserThread::PostTask(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&AtomURLRequest::DoWriteFile, this, std::move(file), path,
+                     offset, length));
+}
+
+void AtomURLRequest::SetChunkedUpload(bool is_chunked_upload,
+                                      bool is_streaming_upload) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   // The method can be called only before switching to multi-threaded mode,
   // i.e. before the first call to write.
   // So it is safe to change the object in the UI thread.
   is_chunked_upload_ = is_chunked_upload;
+  is_streaming_upload_ = is_chunked_upload && is_streaming_upload;
 }
 
 void AtomURLRequest::Cancel() {
@@ -205,6 +234,13 @@ void AtomURLRequest::SetLoadFlags(int flags) const {
       base::BindOnce(&AtomURLRequest::DoSetLoadFlags, this, flags));
 }
 
+void AtomURLRequest::SetPriority(net::RequestPriority priority) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  content::BrowserThread::PostTask(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&AtomURLRequest::DoSetPriority, this, priority));
+}
+
 void AtomURLRequest::DoWriteBuffer(
     scoped_refptr<const net::IOBufferWithSize> buffer,
     bool is_last) {
@@ -217,24 +253,43 @@ void AtomURLRequest::DoWriteBuffer(
     // Chunked encoding case.
 
     bool first_call = false;
-    if (!chunked_stream_writer_) {
-      std::unique_ptr<net::ChunkedUploadDataStream> chunked_stream(
-          new net::ChunkedUploadDataStream(0));
-      chunked_stream_writer_ = chunked_stream->CreateWriter();
-      request_->set_upload(std::move(chunked_stream));
-      first_call = true;
+    if (is_streaming_upload_) {
+      if (!streaming_stream_) {
+        // The stream drops chunks as soon as they are sent, and reports the
+        // consumed bytes so that the JS side can apply back-pressure.
+        auto streaming_stream = std::make_unique<StreamingUploadDataStream>(
+            base::BindRepeating(&AtomURLRequest::OnUploadDataConsumed,
+                                base::Unretained(this)));
+        streaming_stream_ = streaming_stream.get();
+        request_->set_upload(std::move(streaming_stream));
+        first_call = true;
+      }
+
+      // Empty buffer and last chunk, i.e. request.end(), is handled by the
+      // stream as well.
+      streaming_stream_->AppendData(std::move(buffer), is_last);
+    } else {
+      // Keeps the whole body so that it can be rewound for redirects and
+      // auth retries.
+      if (!chunked_stream_writer_) {
+        std::unique_ptr<net::ChunkedUploadDataStream> chunked_stream(
+            new net::ChunkedUploadDataStream(0));
+        chunked_stream_writer_ = chunked_stream->CreateWriter();
+        request_->set_upload(std::move(chunked_stream));
+        first_call = true;
+      }
+
+      if (buffer)
+        // Non-empty buffer.
+        chunked_stream_writer_->AppendData(buffer->data(), buffer->size(),
+                                           is_last);
+      else if (is_last)
+        // Empty buffer and last chunk, i.e. request.end().
+        chunked_stream_writer_->AppendData(nullptr, 0, true);
     }
 
-    if (buffer)
-      // Non-empty buffer.
-      chunked_stream_writer_->AppendData(buffer->data(), buffer->size(),
-                                         is_last);
-    else if (is_last)
-      // Empty buffer and last chunk, i.e. request.end().
-      chunked_stream_writer_->AppendData(nullptr, 0, true);
-
     if (first_call) {
-      request_->Start();
+      StartRequest();
     }
   } else {
     if (buffer) {
@@ -251,11 +306,37 @@ void AtomURLRequest::DoWriteBuffer(
           std::move(upload_element_readers_), 0);
       request_->set_upload(
           std::unique_ptr<net::UploadDataStream>(elements_upload_data_stream));
-      request_->Start();
+      StartRequest();
     }
   }
 }
 
+void AtomURLRequest::DoWriteFile(base::File file,
+                                 const base::FilePath& path,
+                                 uint64_t offset,
+                                 uint64_t length) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (!request_) {
+    return;
+  }
+  DCHECK(!is_chunked_upload_);
+
+  // The file is read by the network stack on a blocking task runner, its
+  // content is never copied into the JS heap.
+  auto task_runner = base::CreateTaskRunnerWithTraits(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  std::unique_ptr<net::UploadElementReader> element_reader;
+  if (file.IsValid()) {
+    element_reader = std::make_unique<net::UploadFileElementReader>(
+        task_runner.get(), std::move(file), path, offset, length, base::Time());
+  } else {
+    element_reader = std::make_unique<net::UploadFileElementReader>(
+        task_runner.get(), path, offset, length, base::Time());
+  }
+  upload_element_readers_.push_back(std::move(element_reader));
+}
+
 void AtomURLRequest::DoCancel() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
   if (request_) {
@@ -323,6 +404,26 @@ void AtomURLRequest::DoSetLoadFlags(int flags) const {
   request_->SetLoadFlags(request_->load_flags() | flags);
 }
 
+void AtomURLRequest::DoSetPriority(net::RequestPriority priority) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (!request_) {
+    return;
+  }
+  request_->SetPriority(priority);
+  if (scheduler_)
+    scheduler_->SetPriority(this, priority);
+}
+
+void AtomURLRequest::StartRequest() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  // The session may delay the request when it has too many requests running.
+  if (!scheduler_ ||
+      scheduler_->ScheduleRequest(this, request_->url().host(),
+                                  request_->priority())) {
+    request_->Start();
+  }
+}
+
 void AtomURLRequest::OnReceivedRedirect(net::URLRequest* request,
                                         const net::RedirectInfo& info,
                                         bool* defer_redirect) {
@@ -381,6 +482,14 @@ void AtomURLRequest::OnResponseStarted(net::URLRequest* request,
   // We don't report an error is the request is canceled.
 }
 
+void AtomURLRequest::OnUploadDataConsumed(int bytes_consumed) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  content::BrowserThread::PostTask(
+      content::BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&AtomURLRequest::InformDelegateUploadDataConsumed, this,
+                     bytes_consumed));
+}
+
 void AtomURLRequest::ReadResponse() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
 
@@ -443,6 +552,13 @@ void AtomURLRequest::OnContextShuttingDown() {
   DoCancel();
 }
 
+void AtomURLRequest::StartScheduledRequest() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (request_) {
+    request_->Start();
+  }
+}
+
 bool AtomURLRequest::CopyAndPostBuffer(int bytes_read) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
 
@@ -491,6 +607,14 @@ void AtomURLRequest::InformDelegateResponseData(
     delegate_->OnResponseData(data);
 }
 
+void AtomURLRequest::InformDelegateUploadDataConsumed(
+    int bytes_consumed) const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  if (delegate_)
+    delegate_->OnUploadDataConsumed(bytes_consumed);
+}
+
 void AtomURLRequest::InformDelegateResponseCompleted() const {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
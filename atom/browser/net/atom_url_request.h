@@ -12,11 +12,15 @@
 
 #include "atom/browser/api/atom_api_url_request.h"
 #include "atom/browser/atom_browser_context.h"
+#include "atom/browser/net/url_request_scheduler.h"
 #include "base/memory/ref_counted.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/auth.h"
 #include "net/base/chunked_upload_data_stream.h"
 #include "net/base/io_buffer.h"
+#include "net/base/request_priority.h"
 #include "net/base/upload_element_reader.h"
 #include "net/http/http_response_headers.h"
 #include "net/url_request/url_request.h"
@@ -24,20 +28,30 @@
 
 namespace atom {
 
+class StreamingUploadDataStream;
+
 class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
                        public net::URLRequest::Delegate,
-                       public net::URLRequestContextGetterObserver {
+                       public net::URLRequestContextGetterObserver,
+                       public URLRequestScheduler::Client {
  public:
   static scoped_refptr<AtomURLRequest> Create(
       AtomBrowserContext* browser_context,
       const std::string& method,
       const std::string& url,
       const std::string& redirect_policy,
+      net::RequestPriority priority,
       api::URLRequest* delegate);
   void Terminate();
 
   bool Write(scoped_refptr<const net::IOBufferWithSize> buffer, bool is_last);
-  void SetChunkedUpload(bool is_chunked_upload);
+  bool WriteFile(base::File file,
+                 const base::FilePath& path,
+                 uint64_t offset,
+                 uint64_t length);
+  // A streaming upload drops the chunks once they are sent and reports the
+  // consumed bytes, it can not be rewound for a redirect or an auth retry.
+  void SetChunkedUpload(bool is_chunked_upload, bool is_streaming_upload);
   void Cancel();
   void FollowRedirect();
   void SetExtraHeader(const std::string& name, const std::string& value) const;
@@ -45,6 +59,7 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   void PassLoginInformation(const base::string16& username,
                             const base::string16& password) const;
   void SetLoadFlags(int flags) const;
+  void SetPriority(net::RequestPriority priority);
   void GetUploadProgress(mate::Dictionary* progress) const;
 
  protected:
@@ -60,6 +75,9 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   // Overrides of net::URLRequestContextGetterObserver
   void OnContextShuttingDown() override;
 
+  // Overrides of URLRequestScheduler::Client
+  void StartScheduledRequest() override;
+
  private:
   friend class base::RefCountedThreadSafe<AtomURLRequest>;
 
@@ -69,10 +87,15 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   void DoInitialize(scoped_refptr<net::URLRequestContextGetter>,
                     const std::string& method,
                     const std::string& url,
-                    const std::string& redirect_policy);
+                    const std::string& redirect_policy,
+                    net::RequestPriority priority);
   void DoTerminate();
   void DoWriteBuffer(scoped_refptr<const net::IOBufferWithSize> buffer,
                      bool is_last);
+  void DoWriteFile(base::File file,
+                   const base::FilePath& path,
+                   uint64_t offset,
+                   uint64_t length);
   void DoCancel();
   void DoFollowRedirect();
   void DoSetExtraHeader(const std::string& name,
@@ -83,7 +106,10 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   void DoCancelAuth() const;
   void DoCancelWithError(const std::string& error, bool isRequestError);
   void DoSetLoadFlags(int flags) const;
+  void DoSetPriority(net::RequestPriority priority);
 
+  void StartRequest();
+  void OnUploadDataConsumed(int bytes_consumed);
   void ReadResponse();
   bool CopyAndPostBuffer(int bytes_read);
 
@@ -98,6 +124,7 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
       scoped_refptr<net::HttpResponseHeaders>) const;
   void InformDelegateResponseData(
       scoped_refptr<net::IOBufferWithSize> data) const;
+  void InformDelegateUploadDataConsumed(int bytes_consumed) const;
   void InformDelegateResponseCompleted() const;
   void InformDelegateErrorOccured(const std::string& error,
                                   bool isRequestError) const;
@@ -105,11 +132,15 @@ class AtomURLRequest : public base::RefCountedThreadSafe<AtomURLRequest>,
   api::URLRequest* delegate_;
   std::unique_ptr<net::URLRequest> request_;
   scoped_refptr<net::URLRequestContextGetter> request_context_getter_;
+  // Owned by request_context_getter_.
+  URLRequestScheduler* scheduler_ = nullptr;
 
   bool is_chunked_upload_ = false;
+  bool is_streaming_upload_ = false;
   std::string redirect_policy_;
-  std::unique_ptr<net::ChunkedUploadDataStream> chunked_stream_;
   std::unique_ptr<net::ChunkedUploadDataStream::Writer> chunked_stream_writer_;
+  // Owned by request_ once the streaming upload has started.
+  StreamingUploadDataStream* streaming_stream_ = nullptr;
   std::vector<std::unique_ptr<net::UploadElementReader>>
       upload_element_readers_;
   scoped_refptr<net::IOBuffer> response_read_buffer_;
@@ -0,0 +1,93 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/directory_protocol_handler.h"
+
+#include "atom/browser/net/asar/url_request_asar_job.h"
+#include "base/strings/string_util.h"
+#include "base/task_runner.h"
+#include "net/base/escape.h"
+#include "net/base/net_errors.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_error_job.h"
+
+namespace atom {
+
+DirectoryProtocolHandler::Options::Options() = default;
+
+DirectoryProtocolHandler::Options::Options(const Options& other) = default;
+
+DirectoryProtocolHandler::Options::~Options() = default;
+
+DirectoryProtocolHandler::DirectoryProtocolHandler(
+    const Options& options,
+    const scoped_refptr<base::TaskRunner>& file_task_runner)
+    : options_(options), file_task_runner_(file_task_runner) {}
+
+DirectoryProtocolHandler::~DirectoryProtocolHandler() {}
+
+net::URLRequestJob* DirectoryProtocolHandler::MaybeCreateJob(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate) const {
+  base::FilePath relative_path = GetRelativePath(request->url());
+  if (relative_path.empty())
+    return new net::URLRequestErrorJob(request, network_delegate,
+                                       net::ERR_ACCESS_DENIED);
+
+  auto* job = new asar::URLRequestAsarJob(request, network_delegate);
+  job->EnableConditionalRequests();
+
+  std::string extension =
+      base::FilePath(relative_path.FinalExtension()).AsUTF8Unsafe();
+  if (!extension.empty()) {
+    auto it = options_.mime_types.find(base::ToLowerASCII(extension.substr(1)));
+    if (it != options_.mime_types.end())
+      job->set_mime_type_override(it->second);
+  }
+
+  job->Initialize(file_task_runner_, options_.root.Append(relative_path));
+  return job;
+}
+
+bool DirectoryProtocolHandler::IsSafeRedirectTarget(
+    const GURL& location) const {
+  return false;
+}
+
+base::FilePath DirectoryProtocolHandler::GetRelativePath(
+    const GURL& url) const {
+  std::string path = url.path();
+
+  // Non-standard schemes keep the host in the path, e.g. "//host/index.html".
+  if (!url.IsStandard() &&
+      base::StartsWith(path, "//", base::CompareCase::SENSITIVE)) {
+    size_t host_end = path.find('/', 2);
+    path = host_end == std::string::npos ? "/" : path.substr(host_end);
+  }
+
+  for (const auto& rewrite : options_.rewrites) {
+    if (base::StartsWith(path, rewrite.first, base::CompareCase::SENSITIVE)) {
+      path = rewrite.second + path.substr(rewrite.first.size());
+      break;
+    }
+  }
+
+  if (path.empty() || path.back() == '/')
+    path.append("index.html");
+
+  // Escaped path separators are kept as is, so they can not be used to
+  // address files outside of the root.
+  std::string unescaped = net::UnescapeURLComponent(
+      path, net::UnescapeRule::NORMAL | net::UnescapeRule::SPACES |
+                net::UnescapeRule::URL_SPECIAL_CHARS_EXCEPT_PATH_SEPARATORS);
+  base::TrimString(unescaped, "/", &unescaped);
+
+  base::FilePath relative_path = base::FilePath::FromUTF8Unsafe(unescaped);
+  if (relative_path.empty() || relative_path.IsAbsolute() ||
+      relative_path.ReferencesParent())
+    return base::FilePath();
+  return relative_path.NormalizePathSeparators();
+}
+
+}  // namespace atom
@@ -0,0 +1,66 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_DIRECTORY_PROTOCOL_HANDLER_H_
+#define ATOM_BROWSER_NET_DIRECTORY_PROTOCOL_HANDLER_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "net/url_request/url_request_job_factory.h"
+
+namespace base {
+class TaskRunner;
+}
+
+namespace atom {
+
+// Serves the files under a directory or an asar archive, without asking a
+// JavaScript handler. URLs are mapped to files entirely on the IO thread.
+class DirectoryProtocolHandler
+    : public net::URLRequestJobFactory::ProtocolHandler {
+ public:
+  struct Options {
+    Options();
+    Options(const Options& other);
+    ~Options();
+
+    // Directory or asar archive the files are served from.
+    base::FilePath root;
+    // Pairs of URL path prefixes and their replacements, the first matching
+    // prefix is replaced.
+    std::vector<std::pair<std::string, std::string>> rewrites;
+    // Maps lowercase file extensions, without the dot, to mime types.
+    std::map<std::string, std::string> mime_types;
+  };
+
+  DirectoryProtocolHandler(
+      const Options& options,
+      const scoped_refptr<base::TaskRunner>& file_task_runner);
+  ~DirectoryProtocolHandler() override;
+
+  // net::URLRequestJobFactory::ProtocolHandler:
+  net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const override;
+  bool IsSafeRedirectTarget(const GURL& location) const override;
+
+ private:
+  // Returns the path relative to the root for |url|, or an empty path when
+  // the URL does not map to a file under the root.
+  base::FilePath GetRelativePath(const GURL& url) const;
+
+  const Options options_;
+  const scoped_refptr<base::TaskRunner> file_task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryProtocolHandler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_DIRECTORY_PROTOCOL_HANDLER_H_
@@ -4,6 +4,7 @@
 
 #include "atom/browser/net/js_asker.h"
 
+#include <string>
 #include <utility>
 
 #include "atom/common/native_mate_converters/callback.h"
@@ -23,6 +24,33 @@ void JsAsker::SetHandlerInfo(
   handler_ = handler;
 }
 
+std::unique_ptr<base::Value> JsAsker::GetCachedOptions(
+    const net::URLRequest* request) {
+  if (!response_cache_)
+    return nullptr;
+  auto options = response_cache_->Get(request);
+  served_from_cache_ = !!options;
+  return options;
+}
+
+void JsAsker::OnOptionsReceived(const net::URLRequest* request,
+                                const base::Value& options) {
+  handler_headers_ = new net::HttpResponseHeaders("HTTP/1.1 200 OK");
+  ProtocolResponseCache::ParseHandlerHeaders(options, handler_headers_.get());
+  if (response_cache_ && !served_from_cache_)
+    response_cache_->Put(request, options);
+}
+
+void JsAsker::AddHandlerHeaders(net::HttpResponseHeaders* headers) const {
+  if (!handler_headers_)
+    return;
+  size_t iter = 0;
+  std::string name;
+  std::string value;
+  while (handler_headers_->EnumerateHeaderLines(&iter, &name, &value))
+    headers->AddHeader(name + ": " + value);
+}
+
 // static
 void JsAsker::AskForOptions(
     v8::Isolate* isolate,
@@ -6,13 +6,21 @@
 #define ATOM_BROWSER_NET_JS_ASKER_H_
 
 #include <memory>
+#include <utility>
 
+#include "atom/browser/net/protocol_response_cache.h"
 #include "base/callback.h"
+#include "base/memory/ref_counted.h"
 #include "base/values.h"
 #include "native_mate/arguments.h"
+#include "net/http/http_response_headers.h"
 #include "net/url_request/url_request_context_getter.h"
 #include "v8/include/v8.h"
 
+namespace net {
+class URLRequest;
+}
+
 namespace atom {
 
 using JavaScriptHandler =
@@ -29,6 +37,23 @@ class JsAsker {
                       net::URLRequestContextGetter* request_context_getter,
                       const JavaScriptHandler& handler);
 
+  // Called by |CustomProtocolHandler| to share its response cache.
+  void set_response_cache(scoped_refptr<ProtocolResponseCache> cache) {
+    response_cache_ = std::move(cache);
+  }
+
+  // Returns the cached handler options for |request|, or null if the handler
+  // has to be asked.
+  std::unique_ptr<base::Value> GetCachedOptions(const net::URLRequest* request);
+
+  // Remembers the headers returned by the handler and caches the |options| of
+  // a successful response when they allow it.
+  void OnOptionsReceived(const net::URLRequest* request,
+                         const base::Value& options);
+
+  // Adds the headers returned by the handler to |headers|.
+  void AddHandlerHeaders(net::HttpResponseHeaders* headers) const;
+
   // Ask handler for options in UI thread.
   static void AskForOptions(
       v8::Isolate* isolate,
@@ -50,6 +75,10 @@ class JsAsker {
   net::URLRequestContextGetter* request_context_getter_;
   JavaScriptHandler handler_;
 
+  scoped_refptr<ProtocolResponseCache> response_cache_;
+  scoped_refptr<net::HttpResponseHeaders> handler_headers_;
+  bool served_from_cache_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(JsAsker);
 };
 
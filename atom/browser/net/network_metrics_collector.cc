@@ -0,0 +1,228 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/network_metrics_collector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "base/hash.h"
+#include "base/stl_util.h"
+#include "net/base/load_timing_info.h"
+#include "net/base/net_errors.h"
+#include "net/url_request/url_request.h"
+
+namespace atom {
+
+namespace {
+
+static_assert(sizeof(NetworkMetricsCollector::Record) == 56,
+              "Record layout is part of the public API");
+
+// Maximum number of hosts with their own metrics, the least recently used
+// host is dropped first.
+const size_t kMaxHosts = 100;
+
+// Upper bounds of the histogram buckets in milliseconds, the last bucket
+// holds everything above.
+const int kBucketLimits[] = {1,   2,    5,    10,   20,   50,   100,
+                             200, 500,  1000, 2000, 5000, 10000};
+
+const char* const kPhaseNames[] = {"dns",             "connect",  "ssl",
+                                   "timeToFirstByte", "transfer", "duration"};
+static_assert(arraysize(kPhaseNames) == NetworkMetricsCollector::kPhaseCount,
+              "kPhaseNames does not match Phase");
+
+base::TimeDelta Interval(base::TimeTicks start, base::TimeTicks end) {
+  if (start.is_null() || end.is_null() || end < start)
+    return base::TimeDelta::Min();
+  return end - start;
+}
+
+uint32_t ToMicroseconds(base::TimeDelta delta) {
+  if (delta == base::TimeDelta::Min())
+    return NetworkMetricsCollector::kNotMeasured;
+  return static_cast<uint32_t>(std::min<int64_t>(
+      delta.InMicroseconds(), NetworkMetricsCollector::kNotMeasured - 1));
+}
+
+uint32_t ClampBytes(int64_t bytes) {
+  return static_cast<uint32_t>(std::max<int64_t>(
+      0,
+      std::min<int64_t>(bytes, std::numeric_limits<uint32_t>::max())));
+}
+
+}  // namespace
+
+NetworkMetricsCollector::Histogram::Histogram() {
+  buckets.fill(0);
+}
+
+void NetworkMetricsCollector::Histogram::Add(base::TimeDelta sample) {
+  static_assert(arraysize(kBucketLimits) + 1 == kBucketCount,
+                "kBucketCount does not match kBucketLimits");
+  ++count;
+  sum += sample;
+  max = std::max(max, sample);
+
+  int64_t ms = sample.InMilliseconds();
+  size_t bucket = 0;
+  while (bucket < arraysize(kBucketLimits) && ms >= kBucketLimits[bucket])
+    ++bucket;
+  ++buckets[bucket];
+}
+
+std::unique_ptr<base::DictionaryValue>
+NetworkMetricsCollector::Histogram::ToValue() const {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  dict->SetDouble("count", count);
+  dict->SetDouble("mean", count ? sum.InMillisecondsF() / count : 0);
+  dict->SetDouble("max", max.InMillisecondsF());
+  auto list = std::make_unique<base::ListValue>();
+  for (uint32_t bucket : buckets)
+    list->AppendDouble(bucket);
+  dict->Set("histogram", std::move(list));
+  return dict;
+}
+
+NetworkMetricsCollector::Aggregate::Aggregate() = default;
+
+NetworkMetricsCollector::Aggregate::Aggregate(const Aggregate& other) = default;
+
+NetworkMetricsCollector::Aggregate::~Aggregate() = default;
+
+void NetworkMetricsCollector::Aggregate::Add(const Record& record) {
+  ++requests;
+  if (record.net_error != net::OK)
+    ++errors;
+  if (record.flags & kCached)
+    ++cached_requests;
+  received_bytes += record.received_bytes;
+  sent_bytes += record.sent_bytes;
+  decoded_bytes += record.decoded_bytes;
+  for (size_t i = 0; i < kPhaseCount; ++i) {
+    if (record.timings[i] != kNotMeasured)
+      timings[i].Add(base::TimeDelta::FromMicroseconds(record.timings[i]));
+  }
+}
+
+std::unique_ptr<base::DictionaryValue>
+NetworkMetricsCollector::Aggregate::ToValue() const {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  dict->SetDouble("requests", requests);
+  dict->SetDouble("errors", errors);
+  dict->SetDouble("cachedRequests", cached_requests);
+  dict->SetDouble("receivedBytes", received_bytes);
+  dict->SetDouble("sentBytes", sent_bytes);
+  dict->SetDouble("decodedBytes", decoded_bytes);
+  for (size_t i = 0; i < kPhaseCount; ++i)
+    dict->Set(kPhaseNames[i], timings[i].ToValue());
+  return dict;
+}
+
+NetworkMetricsCollector::NetworkMetricsCollector(size_t record_buffer_size)
+    : hosts_(kMaxHosts), records_(record_buffer_size) {}
+
+NetworkMetricsCollector::~NetworkMetricsCollector() {}
+
+void NetworkMetricsCollector::RecordRequest(const net::URLRequest* request,
+                                            int net_error) {
+  net::LoadTimingInfo timing;
+  request->GetLoadTimingInfo(&timing);
+  const auto& connect = timing.connect_timing;
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  Record record;
+  memset(&record, 0, sizeof(record));
+  record.start_time = timing.request_start_time.ToJsTime();
+  record.host_hash = HashHost(request->url().host());
+  record.net_error = net_error;
+  record.response_code = std::max(0, request->GetResponseCode());
+  if (request->was_cached())
+    record.flags |= kCached;
+  if (timing.socket_reused)
+    record.flags |= kSocketReused;
+  if (request->url().SchemeIsCryptographic())
+    record.flags |= kSecure;
+  if (request->response_info().was_fetched_via_spdy)
+    record.flags |= kHttp2;
+
+  record.timings[kDns] =
+      ToMicroseconds(Interval(connect.dns_start, connect.dns_end));
+  record.timings[kConnect] =
+      ToMicroseconds(Interval(connect.connect_start, connect.connect_end));
+  record.timings[kSsl] =
+      ToMicroseconds(Interval(connect.ssl_start, connect.ssl_end));
+  record.timings[kTimeToFirstByte] =
+      ToMicroseconds(Interval(timing.send_start, timing.receive_headers_end));
+  record.timings[kTransfer] =
+      ToMicroseconds(Interval(timing.receive_headers_end, now));
+  record.timings[kDuration] =
+      ToMicroseconds(Interval(timing.request_start, now));
+
+  record.received_bytes = ClampBytes(request->GetTotalReceivedBytes());
+  record.sent_bytes = ClampBytes(request->GetTotalSentBytes());
+  record.decoded_bytes =
+      ClampBytes(request->received_response_content_length());
+
+  total_.Add(record);
+  const std::string& host = request->url().host();
+  auto it = hosts_.Get(host);
+  if (it == hosts_.end())
+    it = hosts_.Put(host, Aggregate());
+  it->second.Add(record);
+
+  if (records_.empty())
+    return;
+  if (records_size_ == records_.size()) {
+    // Overwrite the oldest record.
+    records_[records_begin_] = record;
+    records_begin_ = (records_begin_ + 1) % records_.size();
+    ++dropped_records_;
+  } else {
+    records_[(records_begin_ + records_size_) % records_.size()] = record;
+    ++records_size_;
+  }
+}
+
+std::unique_ptr<base::DictionaryValue> NetworkMetricsCollector::GetMetrics()
+    const {
+  auto metrics = std::make_unique<base::DictionaryValue>();
+  auto bucket_limits = std::make_unique<base::ListValue>();
+  for (int limit : kBucketLimits)
+    bucket_limits->AppendInteger(limit);
+  metrics->Set("bucketLimits", std::move(bucket_limits));
+  metrics->SetDouble("bufferedRecords", records_size_);
+  metrics->SetDouble("droppedRecords", dropped_records_);
+  metrics->Set("total", total_.ToValue());
+
+  auto hosts = std::make_unique<base::DictionaryValue>();
+  for (const auto& item : hosts_) {
+    auto host = item.second.ToValue();
+    host->SetDouble("hash", HashHost(item.first));
+    hosts->SetWithoutPathExpansion(item.first, std::move(host));
+  }
+  metrics->Set("hosts", std::move(hosts));
+  return metrics;
+}
+
+std::vector<char> NetworkMetricsCollector::TakeRecords() {
+  std::vector<char> data(records_size_ * sizeof(Record));
+  for (size_t i = 0; i < records_size_; ++i) {
+    const Record& record = records_[(records_begin_ + i) % records_.size()];
+    memcpy(data.data() + i * sizeof(Record), &record, sizeof(Record));
+  }
+  records_begin_ = 0;
+  records_size_ = 0;
+  return data;
+}
+
+// static
+uint32_t NetworkMetricsCollector::HashHost(const std::string& host) {
+  return base::PersistentHash(host);
+}
+
+}  // namespace atom
@@ -0,0 +1,127 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_NETWORK_METRICS_COLLECTOR_H_
+#define ATOM_BROWSER_NET_NETWORK_METRICS_COLLECTOR_H_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace net {
+class URLRequest;
+}
+
+namespace atom {
+
+// Aggregates the load timing and transfer sizes of the requests completed in
+// a session, in total and per host.
+//
+// Timings are kept as histograms with fixed buckets so that the cost of a
+// request is constant. When a record buffer size is given, a fixed-size
+// binary Record of each request is also kept in a ring buffer, the oldest
+// records are overwritten when it is full.
+//
+// Must be used on the IO thread.
+class NetworkMetricsCollector {
+ public:
+  enum Phase {
+    kDns,
+    kConnect,
+    kSsl,
+    kTimeToFirstByte,
+    kTransfer,
+    kDuration,
+    kPhaseCount,
+  };
+
+  enum RecordFlags {
+    kCached = 1 << 0,
+    kSocketReused = 1 << 1,
+    kSecure = 1 << 2,
+    kHttp2 = 1 << 3,
+  };
+
+  // Layout of the binary records, all fields are in host byte order.
+  struct Record {
+    double start_time;  // Milliseconds since the UNIX epoch.
+    uint32_t host_hash;
+    int32_t net_error;
+    uint16_t response_code;
+    uint8_t flags;
+    uint8_t reserved;
+    // Microseconds, or kNotMeasured when the phase did not happen.
+    uint32_t timings[kPhaseCount];
+    uint32_t received_bytes;
+    uint32_t sent_bytes;
+    uint32_t decoded_bytes;
+  };
+
+  static const uint32_t kNotMeasured = 0xFFFFFFFF;
+
+  explicit NetworkMetricsCollector(size_t record_buffer_size);
+  ~NetworkMetricsCollector();
+
+  void RecordRequest(const net::URLRequest* request, int net_error);
+
+  std::unique_ptr<base::DictionaryValue> GetMetrics() const;
+
+  // Returns the buffered records, oldest first, and empties the buffer.
+  std::vector<char> TakeRecords();
+
+  static uint32_t HashHost(const std::string& host);
+
+ private:
+  static const size_t kBucketCount = 14;
+
+  struct Histogram {
+    Histogram();
+
+    void Add(base::TimeDelta sample);
+    std::unique_ptr<base::DictionaryValue> ToValue() const;
+
+    uint32_t count = 0;
+    base::TimeDelta sum;
+    base::TimeDelta max;
+    std::array<uint32_t, kBucketCount> buckets;
+  };
+
+  struct Aggregate {
+    Aggregate();
+    Aggregate(const Aggregate& other);
+    ~Aggregate();
+
+    void Add(const Record& record);
+    std::unique_ptr<base::DictionaryValue> ToValue() const;
+
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    uint64_t cached_requests = 0;
+    int64_t received_bytes = 0;
+    int64_t sent_bytes = 0;
+    int64_t decoded_bytes = 0;
+    std::array<Histogram, kPhaseCount> timings;
+  };
+
+  Aggregate total_;
+  base::MRUCache<std::string, Aggregate> hosts_;
+
+  std::vector<Record> records_;
+  // Index of the oldest record and number of records in records_.
+  size_t records_begin_ = 0;
+  size_t records_size_ = 0;
+  uint64_t dropped_records_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(NetworkMetricsCollector);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_NETWORK_METRICS_COLLECTOR_H_
@@ -0,0 +1,181 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/protocol_response_cache.h"
+
+#include <iterator>
+#include <string>
+
+#include "base/strings/string_util.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/url_request/url_request.h"
+
+namespace atom {
+
+namespace {
+
+// Rough estimate of the memory held by a cached value.
+size_t EstimateSize(const base::Value& value) {
+  switch (value.type()) {
+    case base::Value::Type::STRING:
+      return value.GetString().size();
+    case base::Value::Type::BINARY:
+      return value.GetBlob().size();
+    case base::Value::Type::DICTIONARY: {
+      size_t size = 0;
+      for (const auto& item : value.DictItems())
+        size += item.first.size() + EstimateSize(item.second);
+      return size;
+    }
+    case base::Value::Type::LIST: {
+      size_t size = 0;
+      for (const auto& item : value.GetList())
+        size += EstimateSize(item);
+      return size;
+    }
+    default:
+      return sizeof(base::Value);
+  }
+}
+
+// Only the responses of safe methods can be reused, a POST has to reach the
+// handler every time. The method is part of the key so a HEAD never gets the
+// response of a GET.
+bool GetCacheKey(const net::URLRequest* request, std::string* key) {
+  const std::string& method = request->method();
+  if (method != "GET" && method != "HEAD")
+    return false;
+  *key = method + " " + request->url().spec();
+  return true;
+}
+
+}  // namespace
+
+ProtocolResponseCache::Entry::Entry() = default;
+
+ProtocolResponseCache::Entry::~Entry() = default;
+
+ProtocolResponseCache::ProtocolResponseCache(size_t max_size)
+    : entries_(EntryMap::NO_AUTO_EVICT), max_size_(max_size) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() = default;
+
+std::unique_ptr<base::Value> ProtocolResponseCache::Get(
+    const net::URLRequest* request) {
+  std::string key;
+  if (!GetCacheKey(request, &key))
+    return nullptr;
+
+  auto it = entries_.Get(key);
+  if (it == entries_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+
+  const Entry& entry = *it->second;
+  if (base::TimeTicks::Now() >= entry.expiration) {
+    Erase(it);
+    ++misses_;
+    return nullptr;
+  }
+
+  const net::HttpRequestHeaders& request_headers =
+      request->extra_request_headers();
+  for (const auto& header : entry.vary) {
+    std::string value;
+    request_headers.GetHeader(header.first, &value);
+    if (value != header.second) {
+      ++misses_;
+      return nullptr;
+    }
+  }
+
+  ++hits_;
+  return std::make_unique<base::Value>(entry.options->Clone());
+}
+
+void ProtocolResponseCache::Put(const net::URLRequest* request,
+                                const base::Value& options) {
+  std::string key;
+  if (!options.is_dict() || !GetCacheKey(request, &key))
+    return;
+
+  scoped_refptr<net::HttpResponseHeaders> headers(
+      new net::HttpResponseHeaders("HTTP/1.1 200 OK"));
+  ParseHandlerHeaders(options, headers.get());
+
+  if (headers->HasHeaderValue("cache-control", "no-store") ||
+      headers->HasHeaderValue("cache-control", "no-cache"))
+    return;
+
+  base::TimeDelta max_age;
+  if (!headers->GetMaxAgeValue(&max_age) || max_age <= base::TimeDelta())
+    return;
+
+  auto entry = std::make_unique<Entry>();
+  const net::HttpRequestHeaders& request_headers =
+      request->extra_request_headers();
+  size_t iter = 0;
+  std::string name;
+  while (headers->EnumerateHeader(&iter, "vary", &name)) {
+    // Responses varying on everything can never be reused.
+    if (name == "*")
+      return;
+    std::string value;
+    request_headers.GetHeader(name, &value);
+    entry->vary.emplace_back(base::ToLowerASCII(name), value);
+  }
+
+  entry->size = EstimateSize(options);
+  if (entry->size > max_size_)
+    return;
+  entry->options = std::make_unique<base::Value>(options.Clone());
+  entry->expiration = base::TimeTicks::Now() + max_age;
+
+  auto it = entries_.Peek(key);
+  if (it != entries_.end())
+    Erase(it);
+
+  while (total_size_ + entry->size > max_size_ && !entries_.empty())
+    Erase(std::prev(entries_.end()));
+
+  total_size_ += entry->size;
+  entries_.Put(key, std::move(entry));
+}
+
+void ProtocolResponseCache::Clear() {
+  entries_.Clear();
+  total_size_ = 0;
+}
+
+// static
+void ProtocolResponseCache::ParseHandlerHeaders(
+    const base::Value& options,
+    net::HttpResponseHeaders* headers) {
+  if (!options.is_dict())
+    return;
+  const base::Value* dict =
+      options.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+  if (!dict)
+    return;
+
+  for (const auto& item : dict->DictItems()) {
+    if (item.second.is_string()) {
+      headers->AddHeader(item.first + ": " + item.second.GetString());
+    } else if (item.second.is_list()) {
+      for (const auto& value : item.second.GetList()) {
+        if (value.is_string())
+          headers->AddHeader(item.first + ": " + value.GetString());
+      }
+    }
+  }
+}
+
+void ProtocolResponseCache::Erase(EntryMap::iterator it) {
+  total_size_ -= it->second->size;
+  entries_.Erase(it);
+}
+
+}  // namespace atom
@@ -0,0 +1,85 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace net {
+class HttpResponseHeaders;
+class URLRequest;
+}  // namespace net
+
+namespace atom {
+
+// In-memory cache of the options returned by a custom protocol handler.
+//
+// A response is only cached when the handler returns a "Cache-Control" header
+// with a positive max-age, and is then served on the IO thread without asking
+// the JS handler again until it expires. Request headers listed in the "Vary"
+// response header must match for a cached response to be used. Only GET and
+// HEAD requests are cached, each method separately.
+//
+// Each registered protocol handler owns one cache, which is dropped when the
+// protocol is unregistered or unintercepted. Must be used on the IO thread.
+class ProtocolResponseCache : public base::RefCounted<ProtocolResponseCache> {
+ public:
+  explicit ProtocolResponseCache(size_t max_size);
+
+  // Returns a copy of the options cached for |request|, or null.
+  std::unique_ptr<base::Value> Get(const net::URLRequest* request);
+
+  // Caches |options| for |request| if the "headers" it carries allow it.
+  void Put(const net::URLRequest* request, const base::Value& options);
+
+  void Clear();
+
+  size_t size() const { return total_size_; }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+
+  // Parses the "headers" property of handler |options| into |headers|.
+  static void ParseHandlerHeaders(const base::Value& options,
+                                  net::HttpResponseHeaders* headers);
+
+ private:
+  friend class base::RefCounted<ProtocolResponseCache>;
+
+  struct Entry {
+    Entry();
+    ~Entry();
+
+    std::unique_ptr<base::Value> options;
+    base::TimeTicks expiration;
+    // Name and value of the request headers the response varies on.
+    std::vector<std::pair<std::string, std::string>> vary;
+    size_t size = 0;
+  };
+  using EntryMap = base::MRUCache<std::string, std::unique_ptr<Entry>>;
+
+  ~ProtocolResponseCache();
+
+  void Erase(EntryMap::iterator it);
+
+  EntryMap entries_;
+  size_t max_size_;
+  size_t total_size_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolResponseCache);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
@@ -0,0 +1,97 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/streaming_upload_data_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "net/base/net_errors.h"
+
+namespace atom {
+
+StreamingUploadDataStream::StreamingUploadDataStream(
+    const ConsumedCallback& callback)
+    : net::UploadDataStream(true /* is_chunked */, 0 /* identifier */),
+      consumed_callback_(callback) {}
+
+StreamingUploadDataStream::~StreamingUploadDataStream() {}
+
+void StreamingUploadDataStream::AppendData(
+    scoped_refptr<const net::IOBufferWithSize> buffer,
+    bool is_last) {
+  DCHECK(!all_data_appended_);
+  if (buffer && buffer->size() > 0)
+    chunks_.push_back(std::move(buffer));
+  all_data_appended_ = is_last;
+
+  if (!pending_read_buffer_)
+    return;
+
+  int result =
+      ReadChunks(pending_read_buffer_.get(), pending_read_buffer_length_);
+  if (result == net::ERR_IO_PENDING)
+    return;
+  pending_read_buffer_ = nullptr;
+  pending_read_buffer_length_ = 0;
+  OnReadCompleted(result);
+}
+
+int StreamingUploadDataStream::InitInternal(
+    const net::NetLogWithSource& net_log) {
+  // Consumed chunks have been released, so there is nothing to rewind to.
+  if (has_consumed_data_)
+    return net::ERR_UPLOAD_STREAM_REWIND_NOT_SUPPORTED;
+  return net::OK;
+}
+
+int StreamingUploadDataStream::ReadInternal(net::IOBuffer* buf, int buf_len) {
+  DCHECK_LT(0, buf_len);
+  DCHECK(!pending_read_buffer_);
+
+  int result = ReadChunks(buf, buf_len);
+  if (result == net::ERR_IO_PENDING) {
+    pending_read_buffer_ = buf;
+    pending_read_buffer_length_ = buf_len;
+  }
+  return result;
+}
+
+void StreamingUploadDataStream::ResetInternal() {
+  pending_read_buffer_ = nullptr;
+  pending_read_buffer_length_ = 0;
+}
+
+int StreamingUploadDataStream::ReadChunks(net::IOBuffer* buf, int buf_len) {
+  int bytes_read = 0;
+  while (!chunks_.empty() && bytes_read < buf_len) {
+    const auto& chunk = chunks_.front();
+    int bytes_to_copy =
+        std::min(buf_len - bytes_read, chunk->size() - front_offset_);
+    memcpy(buf->data() + bytes_read, chunk->data() + front_offset_,
+           bytes_to_copy);
+    bytes_read += bytes_to_copy;
+    front_offset_ += bytes_to_copy;
+    if (front_offset_ == chunk->size()) {
+      chunks_.pop_front();
+      front_offset_ = 0;
+    }
+  }
+
+  if (chunks_.empty() && all_data_appended_)
+    SetIsFinalChunk();
+
+  if (bytes_read == 0 && !all_data_appended_)
+    return net::ERR_IO_PENDING;
+
+  if (bytes_read > 0) {
+    has_consumed_data_ = true;
+    if (consumed_callback_)
+      consumed_callback_.Run(bytes_read);
+  }
+  return bytes_read;
+}
+
+}  // namespace atom
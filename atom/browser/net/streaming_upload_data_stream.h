@@ -0,0 +1,62 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_STREAMING_UPLOAD_DATA_STREAM_H_
+#define ATOM_BROWSER_NET_STREAMING_UPLOAD_DATA_STREAM_H_
+
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/memory/scoped_refptr.h"
+#include "net/base/io_buffer.h"
+#include "net/base/upload_data_stream.h"
+
+namespace atom {
+
+// A chunked upload stream that releases every chunk as soon as the network
+// stack has read it, and reports how many bytes were consumed.
+//
+// Unlike net::ChunkedUploadDataStream, which keeps a copy of the whole body
+// so that it can be rewound, this stream only holds the chunks that have not
+// been sent yet. The consumed callback allows the caller to implement flow
+// control on top of it. As a consequence the stream cannot be rewound once
+// data has been read from it.
+//
+// All methods must be called on the IO thread.
+class StreamingUploadDataStream : public net::UploadDataStream {
+ public:
+  using ConsumedCallback = base::RepeatingCallback<void(int bytes_consumed)>;
+
+  explicit StreamingUploadDataStream(const ConsumedCallback& callback);
+  ~StreamingUploadDataStream() override;
+
+  // Queues |buffer| for upload, |buffer| may be null when |is_last| is true.
+  void AppendData(scoped_refptr<const net::IOBufferWithSize> buffer,
+                  bool is_last);
+
+ private:
+  // net::UploadDataStream:
+  int InitInternal(const net::NetLogWithSource& net_log) override;
+  int ReadInternal(net::IOBuffer* buf, int buf_len) override;
+  void ResetInternal() override;
+
+  int ReadChunks(net::IOBuffer* buf, int buf_len);
+
+  base::circular_deque<scoped_refptr<const net::IOBufferWithSize>> chunks_;
+  // Offset of the first unread byte in chunks_.front().
+  int front_offset_ = 0;
+  bool all_data_appended_ = false;
+  bool has_consumed_data_ = false;
+
+  // Saved arguments of a ReadInternal call that is waiting for data.
+  scoped_refptr<net::IOBuffer> pending_read_buffer_;
+  int pending_read_buffer_length_ = 0;
+
+  ConsumedCallback consumed_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingUploadDataStream);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_STREAMING_UPLOAD_DATA_STREAM_H_
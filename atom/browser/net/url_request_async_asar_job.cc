@@ -53,6 +53,13 @@ URLRequestAsyncAsarJob::URLRequestAsyncAsarJob(
 URLRequestAsyncAsarJob::~URLRequestAsyncAsarJob() = default;
 
 void URLRequestAsyncAsarJob::Start() {
+  auto cached_options = GetCachedOptions(request());
+  if (cached_options) {
+    // Served from the response cache without a round trip to the UI thread.
+    StartAsync(std::move(cached_options), net::OK);
+    return;
+  }
+
   auto request_details = std::make_unique<base::DictionaryValue>();
   FillRequestDetails(request_details.get(), request());
   content::BrowserThread::PostTask(
@@ -70,6 +77,8 @@ void URLRequestAsyncAsarJob::StartAsync(std::unique_ptr<base::Value> options,
     return;
   }
 
+  OnOptionsReceived(request(), *options);
+
   std::string file_path;
   if (options->is_dict()) {
     auto* path_value =
@@ -107,6 +116,7 @@ void URLRequestAsyncAsarJob::GetResponseInfo(net::HttpResponseInfo* info) {
   auto* headers = new net::HttpResponseHeaders(status);
 
   headers->AddHeader(kCORSHeader);
+  AddHandlerHeaders(headers);
   info->headers = headers;
 }
 
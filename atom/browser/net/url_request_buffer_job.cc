@@ -64,6 +64,13 @@ URLRequestBufferJob::URLRequestBufferJob(net::URLRequest* request,
 URLRequestBufferJob::~URLRequestBufferJob() = default;
 
 void URLRequestBufferJob::Start() {
+  auto cached_options = GetCachedOptions(request());
+  if (cached_options) {
+    // Served from the response cache without a round trip to the UI thread.
+    StartAsync(std::move(cached_options), net::OK);
+    return;
+  }
+
   auto request_details = std::make_unique<base::DictionaryValue>();
   FillRequestDetails(request_details.get(), request());
   content::BrowserThread::PostTask(
@@ -81,6 +88,8 @@ void URLRequestBufferJob::StartAsync(std::unique_ptr<base::Value> options,
     return;
   }
 
+  OnOptionsReceived(request(), *options);
+
   const base::Value* binary = nullptr;
   if (options->is_dict()) {
     base::DictionaryValue* dict =
@@ -128,6 +137,7 @@ void URLRequestBufferJob::GetResponseInfo(net::HttpResponseInfo* info) {
   auto* headers = new net::HttpResponseHeaders(status);
 
   headers->AddHeader(kCORSHeader);
+  AddHandlerHeaders(headers);
 
   if (!mime_type_.empty()) {
     std::string content_type_header(net::HttpRequestHeaders::kContentType);
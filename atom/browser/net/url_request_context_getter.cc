@@ -18,6 +18,7 @@
 #include "atom/browser/net/atom_url_request_job_factory.h"
 #include "atom/browser/net/http_protocol_handler.h"
 #include "atom/browser/net/require_ct_delegate.h"
+#include "atom/browser/net/url_request_scheduler.h"
 #include "base/command_line.h"
 #include "base/strings/string_util.h"
 #include "base/task_scheduler/post_task.h"
@@ -278,7 +279,8 @@ URLRequestContextGetter::URLRequestContextGetter(
     URLRequestContextGetter::Handle* context_handle,
     content::ProtocolHandlerMap* protocol_handlers,
     content::URLRequestInterceptorScopedVector protocol_interceptors)
-    : context_handle_(context_handle),
+    : request_scheduler_(new URLRequestScheduler),
+      context_handle_(context_handle),
       url_request_context_(nullptr),
       protocol_interceptors_(std::move(protocol_interceptors)),
       context_shutting_down_(false) {
@@ -300,6 +302,7 @@ void URLRequestContextGetter::NotifyContextShuttingDown(
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
   context_shutting_down_ = true;
+  request_scheduler_->Shutdown();
   resource_context.reset();
   net::URLRequestContextGetter::NotifyContextShuttingDown();
 }
@@ -26,6 +26,7 @@ class AtomNetworkDelegate;
 class AtomURLRequestJobFactory;
 class RequireCTDelegate;
 class ResourceContext;
+class URLRequestScheduler;
 
 class URLRequestContextGetter : public net::URLRequestContextGetter {
  public:
@@ -44,6 +45,12 @@ class URLRequestContextGetter : public net::URLRequestContextGetter {
 
   AtomNetworkDelegate* network_delegate() const { return network_delegate_; }
 
+  // Schedules the requests made by the net module, must be used on the IO
+  // thread.
+  URLRequestScheduler* request_scheduler() const {
+    return request_scheduler_.get();
+  }
+
  private:
   friend class AtomBrowserContext;
 
@@ -96,6 +103,7 @@ class URLRequestContextGetter : public net::URLRequestContextGetter {
   std::unique_ptr<RequireCTDelegate> ct_delegate_;
   std::unique_ptr<AtomURLRequestJobFactory> top_job_factory_;
   std::unique_ptr<network::mojom::NetworkContext> network_context_;
+  std::unique_ptr<URLRequestScheduler> request_scheduler_;
 
   URLRequestContextGetter::Handle* context_handle_;
   net::URLRequestContext* url_request_context_;
@@ -0,0 +1,154 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/url_request_scheduler.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+
+namespace atom {
+
+URLRequestScheduler::URLRequestScheduler() {}
+
+URLRequestScheduler::~URLRequestScheduler() {}
+
+bool URLRequestScheduler::ScheduleRequest(Client* client,
+                                          const std::string& host,
+                                          net::RequestPriority priority) {
+  DCHECK(client);
+  DCHECK(!base::ContainsKey(requests_, client));
+  if (shutting_down_)
+    return false;
+
+  Request& request = requests_[client];
+  request.host = host;
+  request.priority = priority;
+  request.sequence = next_sequence_++;
+  request.queue_time = base::TimeTicks::Now();
+  request.active = false;
+
+  // Every queued request is waiting for a limit, so there is nothing with
+  // a higher priority that could start in place of this one.
+  if (CanStart(host)) {
+    Activate(&request);
+    return true;
+  }
+
+  queue_.insert(MakeQueueKey(client, request));
+  return false;
+}
+
+void URLRequestScheduler::SetPriority(Client* client,
+                                      net::RequestPriority priority) {
+  auto it = requests_.find(client);
+  if (it == requests_.end() || it->second.priority == priority)
+    return;
+
+  Request& request = it->second;
+  if (request.active) {
+    request.priority = priority;
+    return;
+  }
+  queue_.erase(MakeQueueKey(client, request));
+  request.priority = priority;
+  queue_.insert(MakeQueueKey(client, request));
+  StartQueuedRequests();
+}
+
+void URLRequestScheduler::RemoveRequest(Client* client) {
+  auto it = requests_.find(client);
+  if (it == requests_.end())
+    return;
+
+  const Request& request = it->second;
+  if (request.active) {
+    --active_requests_;
+    auto host = active_requests_per_host_.find(request.host);
+    if (--host->second == 0)
+      active_requests_per_host_.erase(host);
+  } else {
+    queue_.erase(MakeQueueKey(client, request));
+  }
+  requests_.erase(it);
+  StartQueuedRequests();
+}
+
+void URLRequestScheduler::Shutdown() {
+  shutting_down_ = true;
+  requests_.clear();
+  queue_.clear();
+  active_requests_per_host_.clear();
+  active_requests_ = 0;
+}
+
+void URLRequestScheduler::SetLimits(const Limits& limits) {
+  limits_ = limits;
+  StartQueuedRequests();
+}
+
+URLRequestScheduler::Metrics URLRequestScheduler::GetMetrics() const {
+  Metrics metrics;
+  metrics.active_requests = active_requests_;
+  metrics.queued_requests = queue_.size();
+  metrics.started_requests = started_requests_;
+  metrics.delayed_requests = delayed_requests_;
+  metrics.total_queue_time = total_queue_time_;
+  metrics.max_queue_time = max_queue_time_;
+  return metrics;
+}
+
+// static
+URLRequestScheduler::QueueKey URLRequestScheduler::MakeQueueKey(
+    Client* client,
+    const Request& request) {
+  return std::make_tuple(-static_cast<int>(request.priority), request.sequence,
+                         client);
+}
+
+bool URLRequestScheduler::CanStart(const std::string& host) const {
+  if (limits_.max_requests && active_requests_ >= limits_.max_requests)
+    return false;
+  if (!limits_.max_requests_per_host)
+    return true;
+  auto it = active_requests_per_host_.find(host);
+  return it == active_requests_per_host_.end() ||
+         it->second < limits_.max_requests_per_host;
+}
+
+void URLRequestScheduler::Activate(Request* request) {
+  request->active = true;
+  ++active_requests_;
+  ++active_requests_per_host_[request->host];
+  ++started_requests_;
+}
+
+void URLRequestScheduler::StartQueuedRequests() {
+  // Starting a request may synchronously finish it and re-enter this method,
+  // so look the next request up again after each start.
+  while (!shutting_down_) {
+    auto it = std::find_if(queue_.begin(), queue_.end(),
+                           [this](const QueueKey& key) {
+                             const Request& request =
+                                 requests_.find(std::get<2>(key))->second;
+                             return CanStart(request.host);
+                           });
+    if (it == queue_.end())
+      return;
+
+    Client* client = std::get<2>(*it);
+    queue_.erase(it);
+    Request& request = requests_[client];
+    Activate(&request);
+
+    base::TimeDelta queue_time = base::TimeTicks::Now() - request.queue_time;
+    ++delayed_requests_;
+    total_queue_time_ += queue_time;
+    max_queue_time_ = std::max(max_queue_time_, queue_time);
+    client->StartScheduledRequest();
+  }
+}
+
+}  // namespace atom
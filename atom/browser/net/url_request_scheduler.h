@@ -0,0 +1,114 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_URL_REQUEST_SCHEDULER_H_
+#define ATOM_BROWSER_NET_URL_REQUEST_SCHEDULER_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "net/base/request_priority.h"
+
+namespace atom {
+
+// Decides when the requests created by the net module of a session may start.
+//
+// Requests are started right away as long as the session is below its
+// limits, otherwise they are queued and started in priority order, oldest
+// first, when a running request finishes. A request waiting for a busy host
+// does not block the requests queued for other hosts.
+//
+// Must be used on the IO thread.
+class URLRequestScheduler {
+ public:
+  class Client {
+   public:
+    // Called when a queued request is allowed to start.
+    virtual void StartScheduledRequest() = 0;
+
+   protected:
+    virtual ~Client() {}
+  };
+
+  // A limit of 0 means unlimited.
+  struct Limits {
+    size_t max_requests = 0;
+    size_t max_requests_per_host = 0;
+  };
+
+  struct Metrics {
+    size_t active_requests = 0;
+    size_t queued_requests = 0;
+    // Number of requests started since the session was created, and how many
+    // of them had to wait in the queue.
+    uint64_t started_requests = 0;
+    uint64_t delayed_requests = 0;
+    base::TimeDelta total_queue_time;
+    base::TimeDelta max_queue_time;
+  };
+
+  URLRequestScheduler();
+  ~URLRequestScheduler();
+
+  // Returns true when |client| can start now, otherwise it is queued and
+  // StartScheduledRequest() is called later.
+  bool ScheduleRequest(Client* client,
+                       const std::string& host,
+                       net::RequestPriority priority);
+
+  // Moves a queued request to the position of its new |priority|.
+  void SetPriority(Client* client, net::RequestPriority priority);
+
+  // Must be called when a scheduled request finishes or is canceled.
+  void RemoveRequest(Client* client);
+
+  // Drops all requests, clients are expected to be canceled by their owners.
+  void Shutdown();
+
+  void SetLimits(const Limits& limits);
+  const Limits& limits() const { return limits_; }
+
+  Metrics GetMetrics() const;
+
+ private:
+  struct Request {
+    std::string host;
+    net::RequestPriority priority;
+    uint64_t sequence;
+    base::TimeTicks queue_time;
+    bool active;
+  };
+
+  // Highest priority first, then by arrival order.
+  using QueueKey = std::tuple<int, uint64_t, Client*>;
+
+  static QueueKey MakeQueueKey(Client* client, const Request& request);
+
+  bool CanStart(const std::string& host) const;
+  void Activate(Request* request);
+  void StartQueuedRequests();
+
+  Limits limits_;
+  std::map<Client*, Request> requests_;
+  std::set<QueueKey> queue_;
+  std::map<std::string, size_t> active_requests_per_host_;
+  size_t active_requests_ = 0;
+  uint64_t next_sequence_ = 0;
+  bool shutting_down_ = false;
+
+  uint64_t started_requests_ = 0;
+  uint64_t delayed_requests_ = 0;
+  base::TimeDelta total_queue_time_;
+  base::TimeDelta max_queue_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRequestScheduler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_URL_REQUEST_SCHEDULER_H_
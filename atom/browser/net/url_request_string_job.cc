@@ -52,6 +52,13 @@ URLRequestStringJob::URLRequestStringJob(net::URLRequest* request,
 URLRequestStringJob::~URLRequestStringJob() = default;
 
 void URLRequestStringJob::Start() {
+  auto cached_options = GetCachedOptions(request());
+  if (cached_options) {
+    // Served from the response cache without a round trip to the UI thread.
+    StartAsync(std::move(cached_options), net::OK);
+    return;
+  }
+
   auto request_details = std::make_unique<base::DictionaryValue>();
   FillRequestDetails(request_details.get(), request());
   content::BrowserThread::PostTask(
@@ -69,6 +76,8 @@ void URLRequestStringJob::StartAsync(std::unique_ptr<base::Value> options,
     return;
   }
 
+  OnOptionsReceived(request(), *options);
+
   if (options->is_dict()) {
     base::DictionaryValue* dict =
         static_cast<base::DictionaryValue*>(options.get());
@@ -91,6 +100,7 @@ void URLRequestStringJob::GetResponseInfo(net::HttpResponseInfo* info) {
   auto* headers = new net::HttpResponseHeaders(status);
 
   headers->AddHeader(kCORSHeader);
+  AddHandlerHeaders(headers);
 
   if (!mime_type_.empty()) {
     std::string content_type_header(net::HttpRequestHeaders::kContentType);
@@ -0,0 +1,120 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/osr/osr_backing_store.h"
+
+#include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/gfx/skia_util.h"
+
+namespace atom {
+
+namespace {
+
+// Triple buffering lets the consumer hold on to a frame while the next one
+// is being composited without forcing an allocation.
+const size_t kBackingCount = 3;
+
+}  // namespace
+
+OffScreenBackingStore::OffScreenBackingStore() : backings_(kBackingCount) {}
+
+OffScreenBackingStore::~OffScreenBackingStore() {}
+
+const SkBitmap& OffScreenBackingStore::Update(
+    const gfx::Size& size,
+    const SkBitmap& source,
+    const std::vector<Overlay>& overlays,
+    OffScreenDamage* damage) {
+  gfx::Rect bounds(size);
+
+  // Overlays that moved, appeared or went away damage both their old and
+  // new position.
+  bool overlays_changed = overlays.size() != overlay_bounds_.size();
+  for (size_t i = 0; !overlays_changed && i < overlays.size(); ++i)
+    overlays_changed = overlays[i].bounds != overlay_bounds_[i];
+  if (overlays_changed) {
+    for (const auto& rect : overlay_bounds_)
+      damage->Union(rect);
+    overlay_bounds_.clear();
+    for (const auto& overlay : overlays) {
+      damage->Union(overlay.bounds);
+      overlay_bounds_.push_back(overlay.bounds);
+    }
+  }
+  damage->Intersect(bounds);
+
+  for (auto& backing : backings_)
+    backing.stale.Union(*damage);
+
+  Backing* backing = AcquireBacking(bounds.size());
+  OffScreenDamage stale = backing->stale;
+  stale.Intersect(bounds);
+  backing->stale.Clear();
+
+  ++metrics_.frames;
+  for (const auto& rect : stale.rects()) {
+    CopyRect(source, gfx::Point(), rect, &backing->bitmap);
+    for (const auto& overlay : overlays) {
+      gfx::Rect overlay_rect = gfx::IntersectRects(overlay.bounds, rect);
+      if (!overlay_rect.IsEmpty()) {
+        CopyRect(*overlay.bitmap, overlay.bounds.origin(), overlay_rect,
+                 &backing->bitmap);
+      }
+    }
+  }
+  return backing->bitmap;
+}
+
+OffScreenBackingStore::Backing* OffScreenBackingStore::AcquireBacking(
+    const gfx::Size& size) {
+  // Prefer the least recently used backing that nobody else references.
+  Backing* backing = nullptr;
+  for (size_t i = 0; i < backings_.size(); ++i) {
+    Backing* candidate = &backings_[(next_backing_ + i) % backings_.size()];
+    SkPixelRef* pixel_ref = candidate->bitmap.pixelRef();
+    if (!pixel_ref || pixel_ref->unique()) {
+      backing = candidate;
+      next_backing_ = (next_backing_ + i + 1) % backings_.size();
+      break;
+    }
+  }
+  if (!backing) {
+    backing = &backings_[next_backing_];
+    next_backing_ = (next_backing_ + 1) % backings_.size();
+  }
+
+  bool reusable = backing->bitmap.pixelRef() &&
+                  backing->bitmap.pixelRef()->unique() &&
+                  backing->bitmap.width() == size.width() &&
+                  backing->bitmap.height() == size.height();
+  if (!reusable) {
+    // The previous bitmap, if any, stays alive as long as it is referenced.
+    backing->bitmap = SkBitmap();
+    backing->bitmap.allocN32Pixels(size.width(), size.height(), false);
+    backing->stale = OffScreenDamage(gfx::Rect(size));
+    ++metrics_.allocations;
+  }
+  return backing;
+}
+
+void OffScreenBackingStore::CopyRect(const SkBitmap& source,
+                                     const gfx::Point& origin,
+                                     const gfx::Rect& rect,
+                                     SkBitmap* target) {
+  gfx::Rect source_rect(origin, gfx::Size(source.width(), source.height()));
+  source_rect.Intersect(rect);
+  source_rect.Offset(-origin.OffsetFromOrigin());
+
+  SkPixmap pixmap;
+  SkPixmap subset;
+  if (!source.peekPixels(&pixmap) ||
+      !pixmap.extractSubset(&subset, gfx::RectToSkIRect(source_rect)))
+    return;
+  if (target->writePixels(subset, origin.x() + source_rect.x(),
+                          origin.y() + source_rect.y()))
+    metrics_.bytes_copied += subset.computeByteSize();
+}
+
+}  // namespace atom
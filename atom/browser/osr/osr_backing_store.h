@@ -0,0 +1,80 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_OSR_OSR_BACKING_STORE_H_
+#define ATOM_BROWSER_OSR_OSR_BACKING_STORE_H_
+
+#include <vector>
+
+#include "atom/browser/osr/osr_damage.h"
+#include "base/macros.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace atom {
+
+// The bitmaps the frames of an offscreen view are composited into before
+// being handed to the paint callback.
+//
+// A few bitmaps are reused in turn, and each of them remembers the area that
+// changed since it was last composited, so only the damaged pixels of a frame
+// are copied. A bitmap still referenced by the consumer of a previous frame,
+// e.g. by the NativeImage of a paint event, is never written to, a new bitmap
+// takes its place instead.
+class OffScreenBackingStore {
+ public:
+  // A bitmap drawn over the view, like a popup widget. Moving |bounds|
+  // damages both the old and the new area.
+  struct Overlay {
+    const SkBitmap* bitmap;
+    gfx::Rect bounds;
+  };
+
+  struct Metrics {
+    uint64_t frames = 0;
+    uint64_t bytes_copied = 0;
+    uint64_t allocations = 0;
+  };
+
+  OffScreenBackingStore();
+  ~OffScreenBackingStore();
+
+  // Composites |overlays| over |source| into a bitmap of |size| and returns
+  // it. |damage| is the part of |source| that changed since the previous
+  // frame, on return it also covers the overlays that moved.
+  const SkBitmap& Update(const gfx::Size& size,
+                         const SkBitmap& source,
+                         const std::vector<Overlay>& overlays,
+                         OffScreenDamage* damage);
+
+  const Metrics& metrics() const { return metrics_; }
+
+ private:
+  struct Backing {
+    SkBitmap bitmap;
+    // Area that changed since |bitmap| was last composited.
+    OffScreenDamage stale;
+  };
+
+  // Returns a backing that is not referenced outside of the store.
+  Backing* AcquireBacking(const gfx::Size& size);
+
+  // Copies the part of |source|, placed at |origin|, within |rect|.
+  void CopyRect(const SkBitmap& source,
+                const gfx::Point& origin,
+                const gfx::Rect& rect,
+                SkBitmap* target);
+
+  std::vector<Backing> backings_;
+  size_t next_backing_ = 0;
+  std::vector<gfx::Rect> overlay_bounds_;
+
+  Metrics metrics_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenBackingStore);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_OSR_OSR_BACKING_STORE_H_
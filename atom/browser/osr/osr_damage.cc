@@ -0,0 +1,102 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/osr/osr_damage.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "ui/gfx/skia_util.h"
+
+namespace atom {
+
+namespace {
+
+// Maximum number of rects in a damage region.
+const int kMaxRects = 32;
+
+}  // namespace
+
+OffScreenDamage::OffScreenDamage() {}
+
+OffScreenDamage::OffScreenDamage(const gfx::Rect& rect) {
+  Union(rect);
+}
+
+OffScreenDamage::OffScreenDamage(const SkRegion& region) : region_(region) {
+  CollapseIfComplex();
+}
+
+OffScreenDamage::OffScreenDamage(const OffScreenDamage& other) = default;
+
+OffScreenDamage::~OffScreenDamage() {}
+
+OffScreenDamage& OffScreenDamage::operator=(const OffScreenDamage& other) =
+    default;
+
+void OffScreenDamage::Union(const gfx::Rect& rect) {
+  if (rect.IsEmpty())
+    return;
+  region_.op(gfx::RectToSkIRect(rect), SkRegion::kUnion_Op);
+  CollapseIfComplex();
+}
+
+void OffScreenDamage::Union(const OffScreenDamage& other) {
+  region_.op(other.region_, SkRegion::kUnion_Op);
+  CollapseIfComplex();
+}
+
+void OffScreenDamage::Intersect(const gfx::Rect& rect) {
+  region_.op(gfx::RectToSkIRect(rect), SkRegion::kIntersect_Op);
+}
+
+void OffScreenDamage::Clear() {
+  region_.setEmpty();
+}
+
+gfx::Rect OffScreenDamage::bounds() const {
+  return gfx::SkIRectToRect(region_.getBounds());
+}
+
+std::vector<gfx::Rect> OffScreenDamage::rects() const {
+  std::vector<gfx::Rect> rects;
+  for (SkRegion::Iterator it(region_); !it.done(); it.next())
+    rects.push_back(gfx::SkIRectToRect(it.rect()));
+  return rects;
+}
+
+std::vector<uint8_t> OffScreenDamage::GetDirtyTiles(const gfx::Size& size,
+                                                    int tile_size) const {
+  DCHECK_GT(tile_size, 0);
+  int columns = (size.width() + tile_size - 1) / tile_size;
+  int rows = (size.height() + tile_size - 1) / tile_size;
+  std::vector<uint8_t> tiles(columns * rows, 0);
+
+  for (SkRegion::Iterator it(region_); !it.done(); it.next()) {
+    const SkIRect& rect = it.rect();
+    int left = std::max(rect.left(), 0) / tile_size;
+    int top = std::max(rect.top(), 0) / tile_size;
+    int right = std::min((rect.right() - 1) / tile_size, columns - 1);
+    int bottom = std::min((rect.bottom() - 1) / tile_size, rows - 1);
+    for (int y = top; y <= bottom; ++y) {
+      for (int x = left; x <= right; ++x)
+        tiles[y * columns + x] = 1;
+    }
+  }
+  return tiles;
+}
+
+void OffScreenDamage::CollapseIfComplex() {
+  if (!region_.isComplex())
+    return;
+  int count = 0;
+  for (SkRegion::Iterator it(region_); !it.done(); it.next()) {
+    if (++count > kMaxRects) {
+      region_.setRect(region_.getBounds());
+      return;
+    }
+  }
+}
+
+}  // namespace atom
@@ -0,0 +1,53 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_OSR_OSR_DAMAGE_H_
+#define ATOM_BROWSER_OSR_OSR_DAMAGE_H_
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkRegion.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace atom {
+
+// The area of an offscreen frame that changed, kept as a set of disjoint
+// rects so that small updates far apart do not damage everything between
+// them.
+//
+// The number of rects is bounded: when a union would make the region too
+// complex it collapses into its bounding rect.
+class OffScreenDamage {
+ public:
+  OffScreenDamage();
+  explicit OffScreenDamage(const gfx::Rect& rect);
+  explicit OffScreenDamage(const SkRegion& region);
+  OffScreenDamage(const OffScreenDamage& other);
+  ~OffScreenDamage();
+
+  OffScreenDamage& operator=(const OffScreenDamage& other);
+
+  void Union(const gfx::Rect& rect);
+  void Union(const OffScreenDamage& other);
+  void Intersect(const gfx::Rect& rect);
+  void Clear();
+
+  bool IsEmpty() const { return region_.isEmpty(); }
+  gfx::Rect bounds() const;
+  std::vector<gfx::Rect> rects() const;
+
+  // Returns one byte per tile of |tile_size| pixels covering |size|, in row
+  // major order, which is 1 when the tile intersects the damage.
+  std::vector<uint8_t> GetDirtyTiles(const gfx::Size& size,
+                                     int tile_size) const;
+
+ private:
+  void CollapseIfComplex();
+
+  SkRegion region_;
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_OSR_OSR_DAMAGE_H_
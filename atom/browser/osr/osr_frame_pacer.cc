@@ -0,0 +1,124 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/osr/osr_frame_pacer.h"
+
+#include <algorithm>
+
+namespace atom {
+
+namespace {
+
+// Number of consecutive frames without damage after which the page is
+// considered idle.
+const int kIdleFrameThreshold = 3;
+
+// While idle only every Nth tick produces a BeginFrame, so that animation
+// callbacks keep running and damage is noticed.
+const int kIdleFrameDivisor = 4;
+
+// Weight of a new sample in the moving average of the paint time.
+const double kPaintTimeWeight = 0.2;
+
+// The interval is stretched to leave some headroom above the paint time.
+const double kPaintTimeHeadroom = 1.25;
+
+}  // namespace
+
+OffScreenFramePacer::OffScreenFramePacer() {}
+
+OffScreenFramePacer::~OffScreenFramePacer() {}
+
+void OffScreenFramePacer::SetMode(Mode mode, uint32_t max_pending_frames) {
+  mode_ = mode;
+  max_pending_frames_ = mode == Mode::ADAPTIVE ? max_pending_frames : 0;
+  metrics_.pending_frames = 0;
+  Wake();
+}
+
+void OffScreenFramePacer::SetFrameInterval(base::TimeDelta interval) {
+  frame_interval_ = interval;
+}
+
+bool OffScreenFramePacer::ShouldSendBeginFrame(base::TimeTicks now) {
+  if (mode_ == Mode::ADAPTIVE) {
+    if (max_pending_frames_ &&
+        metrics_.pending_frames >= max_pending_frames_) {
+      ++metrics_.dropped_frames;
+      return false;
+    }
+
+    // The timer ticks at the nominal rate, allow for some jitter when
+    // checking whether a stretched interval has elapsed.
+    base::TimeDelta interval = GetEffectiveInterval();
+    if (interval > frame_interval_ && !last_begin_frame_time_.is_null() &&
+        now - last_begin_frame_time_ < interval - frame_interval_ / 2) {
+      ++metrics_.dropped_frames;
+      return false;
+    }
+
+    if (idle_frame_count_ >= kIdleFrameThreshold &&
+        ++idle_skip_count_ < kIdleFrameDivisor) {
+      ++metrics_.idle_frames;
+      return false;
+    }
+    idle_skip_count_ = 0;
+  }
+
+  last_begin_frame_time_ = now;
+  ++metrics_.begin_frames;
+  return true;
+}
+
+void OffScreenFramePacer::OnCompositorFrame(bool has_damage) {
+  if (has_damage)
+    idle_frame_count_ = 0;
+  else
+    ++idle_frame_count_;
+}
+
+void OffScreenFramePacer::OnFramePainted(base::TimeDelta paint_time) {
+  ++metrics_.painted_frames;
+  if (!frame_interval_.is_zero() && paint_time > frame_interval_)
+    ++metrics_.late_frames;
+
+  if (metrics_.average_paint_time.is_zero()) {
+    metrics_.average_paint_time = paint_time;
+  } else {
+    metrics_.average_paint_time = base::TimeDelta::FromMicrosecondsD(
+        metrics_.average_paint_time.InMicrosecondsF() *
+            (1 - kPaintTimeWeight) +
+        paint_time.InMicrosecondsF() * kPaintTimeWeight);
+  }
+
+  if (max_pending_frames_)
+    ++metrics_.pending_frames;
+}
+
+void OffScreenFramePacer::OnFrameAcknowledged() {
+  if (metrics_.pending_frames > 0)
+    --metrics_.pending_frames;
+}
+
+void OffScreenFramePacer::Wake() {
+  idle_frame_count_ = 0;
+  idle_skip_count_ = 0;
+}
+
+OffScreenFramePacer::Metrics OffScreenFramePacer::GetMetrics() const {
+  Metrics metrics = metrics_;
+  metrics.frame_interval = GetEffectiveInterval();
+  return metrics;
+}
+
+base::TimeDelta OffScreenFramePacer::GetEffectiveInterval() const {
+  if (mode_ != Mode::ADAPTIVE)
+    return frame_interval_;
+  return std::max(frame_interval_,
+                  base::TimeDelta::FromMicrosecondsD(
+                      metrics_.average_paint_time.InMicrosecondsF() *
+                      kPaintTimeHeadroom));
+}
+
+}  // namespace atom
@@ -0,0 +1,87 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_OSR_OSR_FRAME_PACER_H_
+#define ATOM_BROWSER_OSR_OSR_FRAME_PACER_H_
+
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace atom {
+
+// Decides which BeginFrames of an offscreen view are sent to the renderer.
+//
+// In the fixed mode every tick of the frame timer produces a BeginFrame. In
+// the adaptive mode BeginFrames are skipped while the page produces frames
+// without damage, the frame interval is stretched while the paint handlers
+// take longer than the interval, and, when |max_pending_frames| is set, no
+// BeginFrame is sent while that many painted frames were not acknowledged
+// by the consumer.
+class OffScreenFramePacer {
+ public:
+  enum class Mode {
+    FIXED,
+    ADAPTIVE,
+  };
+
+  struct Metrics {
+    uint64_t begin_frames = 0;
+    uint64_t painted_frames = 0;
+    // BeginFrames skipped because the consumer was behind.
+    uint64_t dropped_frames = 0;
+    // Painted frames whose paint handlers took longer than the interval.
+    uint64_t late_frames = 0;
+    // BeginFrames skipped because nothing was damaged.
+    uint64_t idle_frames = 0;
+    uint32_t pending_frames = 0;
+    base::TimeDelta frame_interval;
+    base::TimeDelta average_paint_time;
+  };
+
+  OffScreenFramePacer();
+  ~OffScreenFramePacer();
+
+  void SetMode(Mode mode, uint32_t max_pending_frames);
+  void SetFrameInterval(base::TimeDelta interval);
+
+  // Called on every tick of the frame timer, returns whether a BeginFrame
+  // should be sent.
+  bool ShouldSendBeginFrame(base::TimeTicks now);
+
+  // Called for every compositor frame submitted by the renderer.
+  void OnCompositorFrame(bool has_damage);
+
+  // Called after the paint handlers ran for a frame for |paint_time|.
+  void OnFramePainted(base::TimeDelta paint_time);
+
+  // Called when the consumer is done with the oldest pending frame.
+  void OnFrameAcknowledged();
+
+  // Resumes sending BeginFrames after the page was idle.
+  void Wake();
+
+  Mode mode() const { return mode_; }
+  Metrics GetMetrics() const;
+
+ private:
+  base::TimeDelta GetEffectiveInterval() const;
+
+  Mode mode_ = Mode::FIXED;
+  uint32_t max_pending_frames_ = 0;
+  base::TimeDelta frame_interval_;
+
+  base::TimeTicks last_begin_frame_time_;
+  // Number of consecutive compositor frames without damage.
+  int idle_frame_count_ = 0;
+  // Ticks skipped since the last BeginFrame while idle.
+  int idle_skip_count_ = 0;
+
+  Metrics metrics_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenFramePacer);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_OSR_OSR_FRAME_PACER_H_
@@ -0,0 +1,142 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/osr/osr_frame_ring.h"
+
+#include <utility>
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/gfx/skia_util.h"
+
+#if defined(OS_LINUX)
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "base/file_descriptor_posix.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/unguessable_token.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+
+namespace atom {
+
+namespace {
+
+std::unique_ptr<base::SharedMemory> CreateSharedMemory(size_t size) {
+#if defined(OS_LINUX) && defined(__NR_memfd_create)
+  // Prefer a memfd, which does not need a file in /dev/shm.
+  int fd = syscall(__NR_memfd_create, "electron-osr-frame", MFD_CLOEXEC);
+  if (fd >= 0) {
+    if (HANDLE_EINTR(ftruncate(fd, size)) == 0) {
+      base::SharedMemoryHandle handle(base::FileDescriptor(fd, true), size,
+                                      base::UnguessableToken::Create());
+      auto memory = std::make_unique<base::SharedMemory>(handle, false);
+      if (memory->Map(size))
+        return memory;
+    } else {
+      close(fd);
+    }
+  }
+#endif
+
+  auto memory = std::make_unique<base::SharedMemory>();
+  if (!memory->CreateAndMapAnonymous(size))
+    return nullptr;
+  return memory;
+}
+
+}  // namespace
+
+OffScreenFrameRing::Buffer::Buffer(std::unique_ptr<base::SharedMemory> memory,
+                                   size_t size)
+    : memory_(std::move(memory)), size_(size) {}
+
+OffScreenFrameRing::Buffer::~Buffer() {}
+
+OffScreenFrameRing::Slot::Slot() {}
+
+OffScreenFrameRing::Slot::Slot(const Slot& other) = default;
+
+OffScreenFrameRing::Slot::~Slot() {}
+
+// static
+std::unique_ptr<OffScreenFrameRing> OffScreenFrameRing::Create(
+    size_t buffer_count,
+    const gfx::Size& size) {
+  if (buffer_count == 0 || size.IsEmpty())
+    return nullptr;
+
+  std::unique_ptr<OffScreenFrameRing> ring(new OffScreenFrameRing(size));
+  size_t buffer_size = ring->stride() * size.height();
+  ring->slots_.resize(buffer_count);
+  for (auto& slot : ring->slots_) {
+    auto memory = CreateSharedMemory(buffer_size);
+    if (!memory)
+      return nullptr;
+    slot.buffer = new Buffer(std::move(memory), buffer_size);
+    slot.stale = OffScreenDamage(gfx::Rect(size));
+  }
+  return ring;
+}
+
+OffScreenFrameRing::OffScreenFrameRing(const gfx::Size& size)
+    : frame_size_(size) {}
+
+OffScreenFrameRing::~OffScreenFrameRing() {}
+
+bool OffScreenFrameRing::WriteFrame(const OffScreenDamage& damage,
+                                    const SkBitmap& bitmap,
+                                    Frame* frame) {
+  for (auto& slot : slots_)
+    slot.stale.Union(damage);
+
+  Slot* slot = nullptr;
+  size_t index = 0;
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    index = (next_slot_ + i) % slots_.size();
+    if (!slots_[index].in_use) {
+      slot = &slots_[index];
+      break;
+    }
+  }
+  if (!slot) {
+    pending_damage_.Union(damage);
+    ++dropped_frames_;
+    return false;
+  }
+  next_slot_ = (index + 1) % slots_.size();
+
+  SkImageInfo info = SkImageInfo::MakeN32Premul(frame_size_.width(),
+                                                frame_size_.height());
+  SkPixmap target(info, slot->buffer->memory(), stride());
+  slot->stale.Intersect(gfx::Rect(bitmap.width(), bitmap.height()));
+  for (const auto& rect : slot->stale.rects()) {
+    SkPixmap subset;
+    if (target.extractSubset(&subset, gfx::RectToSkIRect(rect)))
+      bitmap.readPixels(subset, rect.x(), rect.y());
+  }
+  slot->stale.Clear();
+  slot->in_use = true;
+
+  frame->index = index;
+  frame->sequence = ++sequence_;
+  frame->damage = pending_damage_;
+  frame->damage.Union(damage);
+  frame->damage.Intersect(gfx::Rect(frame_size_));
+  pending_damage_.Clear();
+  return true;
+}
+
+bool OffScreenFrameRing::ReleaseBuffer(size_t index) {
+  if (index >= slots_.size() || !slots_[index].in_use)
+    return false;
+  slots_[index].in_use = false;
+  return true;
+}
+
+}  // namespace atom
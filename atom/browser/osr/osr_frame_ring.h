@@ -0,0 +1,114 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_OSR_OSR_FRAME_RING_H_
+#define ATOM_BROWSER_OSR_OSR_FRAME_RING_H_
+
+#include <memory>
+#include <vector>
+
+#include "atom/browser/osr/osr_damage.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/shared_memory.h"
+#include "ui/gfx/geometry/rect.h"
+
+class SkBitmap;
+
+namespace atom {
+
+// A ring of shared memory buffers the frames of an offscreen view are written
+// to, so that they can be read by other processes without copying.
+//
+// A buffer that was handed out with a frame is not written to again until the
+// consumer releases it. When all buffers are held the frame is dropped and its
+// damage is carried over to the next frame that is written.
+class OffScreenFrameRing {
+ public:
+  // A shared memory mapping holding one frame, 32-bit BGRA pixels with
+  // premultiplied alpha and rows of |stride| bytes.
+  class Buffer : public base::RefCountedThreadSafe<Buffer> {
+   public:
+    Buffer(std::unique_ptr<base::SharedMemory> memory, size_t size);
+
+    void* memory() const { return memory_->memory(); }
+    size_t size() const { return size_; }
+
+#if defined(OS_LINUX)
+    // The file descriptor of the memfd, which can be inherited by a child
+    // process and mapped there.
+    int fd() const { return memory_->handle().GetHandle(); }
+#endif
+
+   private:
+    friend class base::RefCountedThreadSafe<Buffer>;
+    ~Buffer();
+
+    std::unique_ptr<base::SharedMemory> memory_;
+    size_t size_;
+
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  struct Frame {
+    size_t index;
+    uint64_t sequence;
+    // Area that changed since the previous frame that was written.
+    OffScreenDamage damage;
+  };
+
+  // Returns nullptr when the shared memory could not be allocated.
+  static std::unique_ptr<OffScreenFrameRing> Create(size_t buffer_count,
+                                                    const gfx::Size& size);
+
+  ~OffScreenFrameRing();
+
+  // Copies the damaged part of |bitmap| into a free buffer. Returns false when
+  // all buffers are held by the consumer.
+  bool WriteFrame(const OffScreenDamage& damage,
+                  const SkBitmap& bitmap,
+                  Frame* frame);
+
+  // Makes the buffer at |index| available for writing again. Returns false
+  // when it was not held by the consumer.
+  bool ReleaseBuffer(size_t index);
+
+  size_t buffer_count() const { return slots_.size(); }
+  const scoped_refptr<Buffer>& buffer(size_t index) const {
+    return slots_[index].buffer;
+  }
+  const gfx::Size& frame_size() const { return frame_size_; }
+  size_t stride() const { return frame_size_.width() * 4; }
+  uint64_t dropped_frames() const { return dropped_frames_; }
+  // Damage of the frames dropped since the last frame was written.
+  const OffScreenDamage& pending_damage() const { return pending_damage_; }
+
+ private:
+  struct Slot {
+    Slot();
+    Slot(const Slot& other);
+    ~Slot();
+
+    scoped_refptr<Buffer> buffer;
+    // Area that changed since the buffer was last written.
+    OffScreenDamage stale;
+    bool in_use = false;
+  };
+
+  explicit OffScreenFrameRing(const gfx::Size& size);
+
+  gfx::Size frame_size_;
+  std::vector<Slot> slots_;
+  size_t next_slot_ = 0;
+
+  uint64_t sequence_ = 0;
+  uint64_t dropped_frames_ = 0;
+  OffScreenDamage pending_damage_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenFrameRing);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_OSR_OSR_FRAME_RING_H_
@@ -4,6 +4,10 @@
 
 #include "atom/browser/osr/osr_output_device.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/src/core/SkDevice.h"
@@ -11,6 +15,15 @@
 
 namespace atom {
 
+namespace {
+
+// Size of the tiles compared to find the changed parts of a frame. Smaller
+// tiles find tighter rects but make the damage collapse into its bounds
+// sooner.
+const int kChangedTileSize = 16;
+
+}  // namespace
+
 OffScreenOutputDevice::OffScreenOutputDevice(bool transparent,
                                              const OnPaintCallback& callback)
     : transparent_(transparent), callback_(callback) {
@@ -42,6 +55,11 @@ void OffScreenOutputDevice::Resize(const gfx::Size& pixel_size,
   }
 
   canvas_.reset(new SkCanvas(*bitmap_));
+
+  previous_.reset();
+  if (compare_frames_)
+    previous_.allocN32Pixels(viewport_pixel_size_.width(),
+                             viewport_pixel_size_.height(), !transparent_);
 }
 
 SkCanvas* OffScreenOutputDevice::BeginPaint(const gfx::Rect& damage_rect) {
@@ -49,6 +67,9 @@ SkCanvas* OffScreenOutputDevice::BeginPaint(const gfx::Rect& damage_rect) {
   DCHECK(bitmap_.get());
 
   damage_rect_ = damage_rect;
+  damage_rect_.Intersect(gfx::Rect(viewport_pixel_size_));
+  SavePrevious(damage_rect_);
+
   SkIRect damage =
       SkIRect::MakeXYWH(damage_rect_.x(), damage_rect_.y(),
                         damage_rect_.width(), damage_rect_.height());
@@ -71,8 +92,11 @@ void OffScreenOutputDevice::EndPaint() {
 
   viz::SoftwareOutputDevice::EndPaint();
 
+  // Frames painted while inactive are reported with the next active one.
   if (active_)
-    OnPaint(damage_rect_);
+    OnPaint(GetChangedTiles(damage_rect_));
+  else
+    pending_damage_.Union(GetChangedTiles(damage_rect_));
 }
 
 void OffScreenOutputDevice::SetActive(bool active, bool paint) {
@@ -80,22 +104,71 @@ void OffScreenOutputDevice::SetActive(bool active, bool paint) {
     return;
   active_ = active;
 
-  if (!active_ && !pending_damage_rect_.IsEmpty() && paint)
-    OnPaint(gfx::Rect(viewport_pixel_size_));
+  if (!active_ && !pending_damage_.IsEmpty() && paint)
+    OnPaint(OffScreenDamage(gfx::Rect(viewport_pixel_size_)));
+}
+
+void OffScreenOutputDevice::SetCompareFrames(bool compare_frames) {
+  if (compare_frames == compare_frames_)
+    return;
+  compare_frames_ = compare_frames;
+
+  // The previous pixels are saved at the start of each paint, so the next one
+  // can already be compared.
+  previous_.reset();
+  if (compare_frames_ && bitmap_)
+    previous_.allocN32Pixels(viewport_pixel_size_.width(),
+                             viewport_pixel_size_.height(), !transparent_);
 }
 
-void OffScreenOutputDevice::OnPaint(const gfx::Rect& damage_rect) {
-  gfx::Rect rect = damage_rect;
-  if (!pending_damage_rect_.IsEmpty()) {
-    rect.Union(pending_damage_rect_);
-    pending_damage_rect_.SetRect(0, 0, 0, 0);
+void OffScreenOutputDevice::OnPaint(const OffScreenDamage& frame_damage) {
+  OffScreenDamage damage(frame_damage);
+  if (!pending_damage_.IsEmpty()) {
+    damage.Union(pending_damage_);
+    pending_damage_.Clear();
   }
 
-  rect.Intersect(gfx::Rect(viewport_pixel_size_));
-  if (rect.IsEmpty())
+  damage.Intersect(gfx::Rect(viewport_pixel_size_));
+  if (damage.IsEmpty())
+    return;
+
+  callback_.Run(damage, *bitmap_);
+}
+
+void OffScreenOutputDevice::SavePrevious(const gfx::Rect& rect) {
+  if (rect.IsEmpty() || previous_.drawsNothing())
     return;
+  size_t row_bytes = rect.width() * sizeof(uint32_t);
+  for (int y = rect.y(); y < rect.bottom(); ++y)
+    memcpy(previous_.getAddr32(rect.x(), y), bitmap_->getAddr32(rect.x(), y),
+           row_bytes);
+}
 
-  callback_.Run(rect, *bitmap_);
+OffScreenDamage OffScreenOutputDevice::GetChangedTiles(
+    const gfx::Rect& rect) const {
+  if (rect.IsEmpty() || previous_.drawsNothing())
+    return OffScreenDamage(rect);
+
+  SkRegion changed;
+  for (int top = rect.y(); top < rect.bottom(); top += kChangedTileSize) {
+    int bottom = std::min(top + kChangedTileSize, rect.bottom());
+    for (int left = rect.x(); left < rect.right(); left += kChangedTileSize) {
+      int right = std::min(left + kChangedTileSize, rect.right());
+      size_t row_bytes = (right - left) * sizeof(uint32_t);
+      for (int y = top; y < bottom; ++y) {
+        if (memcmp(previous_.getAddr32(left, y), bitmap_->getAddr32(left, y),
+                   row_bytes) != 0) {
+          changed.op(SkIRect::MakeLTRB(left, top, right, bottom),
+                     SkRegion::kUnion_Op);
+          break;
+        }
+      }
+    }
+  }
+  // A redraw that changed nothing is still reported as before.
+  if (changed.isEmpty())
+    return OffScreenDamage(rect);
+  return OffScreenDamage(changed);
 }
 
 }  // namespace atom
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "atom/browser/osr/osr_damage.h"
 #include "base/callback.h"
 #include "components/viz/service/display/software_output_device.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -14,7 +15,8 @@
 
 namespace atom {
 
-typedef base::Callback<void(const gfx::Rect&, const SkBitmap&)> OnPaintCallback;
+typedef base::Callback<void(const OffScreenDamage&, const SkBitmap&)>
+    OnPaintCallback;
 
 class OffScreenOutputDevice : public viz::SoftwareOutputDevice {
  public:
@@ -27,17 +29,31 @@ class OffScreenOutputDevice : public viz::SoftwareOutputDevice {
   void EndPaint() override;
 
   void SetActive(bool active, bool paint);
-  void OnPaint(const gfx::Rect& damage_rect);
+  void OnPaint(const OffScreenDamage& damage);
+
+  // Keeps a copy of the previous frame to find the changed tiles of the
+  // redrawn rect, otherwise the rect is reported as it is.
+  void SetCompareFrames(bool compare_frames);
 
  private:
+  // The compositor only reports the bounding rect of what it redraws, the
+  // parts of it that really changed are found by comparing the pixels of
+  // |bitmap_| with |previous_|, tile by tile.
+  void SavePrevious(const gfx::Rect& rect);
+  OffScreenDamage GetChangedTiles(const gfx::Rect& rect) const;
+
   const bool transparent_;
   OnPaintCallback callback_;
 
   bool active_ = false;
+  bool compare_frames_ = false;
 
   std::unique_ptr<SkCanvas> canvas_;
   std::unique_ptr<SkBitmap> bitmap_;
-  gfx::Rect pending_damage_rect_;
+  // The pixels of |bitmap_| within |damage_rect_| before they were painted,
+  // only allocated when comparing frames.
+  SkBitmap previous_;
+  OffScreenDamage pending_damage_;
 
   DISALLOW_COPY_AND_ASSIGN(OffScreenOutputDevice);
 };
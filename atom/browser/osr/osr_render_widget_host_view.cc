@@ -197,7 +197,7 @@ class AtomCopyFrameGenerator {
   void OnCopyFrameCaptureSuccess(const gfx::Rect& damage_rect,
                                  const std::shared_ptr<SkBitmap>& bitmap) {
     base::AutoLock lock(onPaintLock_);
-    view_->OnPaint(damage_rect, *bitmap);
+    view_->OnPaint(OffScreenDamage(damage_rect), *bitmap);
   }
 
   base::Lock lock_;
@@ -369,6 +369,9 @@ void OffScreenRenderWidgetHostView::OnWindowClosed() {
 
 void OffScreenRenderWidgetHostView::OnBeginFrameTimerTick() {
   const base::TimeTicks frame_time = base::TimeTicks::Now();
+  if (!frame_pacer_.ShouldSendBeginFrame(frame_time))
+    return;
+
   const base::TimeDelta vsync_period =
       base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_);
   SendBeginFrame(frame_time, vsync_period);
@@ -566,6 +569,9 @@ void OffScreenRenderWidgetHostView::SubmitCompositorFrame(
   }
 
   if (!frame.render_pass_list.empty()) {
+    frame_pacer_.OnCompositorFrame(
+        !frame.render_pass_list.back()->damage_rect.IsEmpty());
+
     if (software_output_device_) {
       if (!begin_frame_timer_.get() || IsPopupWidget()) {
         software_output_device_->SetActive(painting_, false);
@@ -754,9 +760,11 @@ OffScreenRenderWidgetHostView::CreateViewForWidget(
         embedder_render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
+  auto* view = new OffScreenRenderWidgetHostView(
       transparent_, true, embedder_host_view->GetFrameRate(), callback_,
       render_widget_host, embedder_host_view, native_window_);
+  view->SetCompareFrames(embedder_host_view->compare_frames());
+  return view;
 }
 
 #if !defined(OS_MACOSX)
@@ -923,6 +931,7 @@ OffScreenRenderWidgetHostView::CreateSoftwareOutputDevice(
   software_output_device_ = new OffScreenOutputDevice(
       transparent_, base::Bind(&OffScreenRenderWidgetHostView::OnPaint,
                                weak_ptr_factory_.GetWeakPtr()));
+  software_output_device_->SetCompareFrames(compare_frames_);
   return base::WrapUnique(software_output_device_);
 }
 
@@ -943,6 +952,8 @@ void OffScreenRenderWidgetHostView::SetNeedsBeginFrames(
     bool needs_begin_frames) {
   SetupFrameRate(true);
 
+  if (needs_begin_frames)
+    frame_pacer_.Wake();
   begin_frame_timer_->SetActive(needs_begin_frames);
 
   if (software_output_device_) {
@@ -956,46 +967,37 @@ void OffScreenRenderWidgetHostView::SetWantsAnimateOnlyBeginFrames() {
   }
 }
 
-void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
+void OffScreenRenderWidgetHostView::OnPaint(const OffScreenDamage& damage,
                                             const SkBitmap& bitmap) {
   TRACE_EVENT0("electron", "OffScreenRenderWidgetHostView::OnPaint");
 
   HoldResize();
 
   if (parent_callback_) {
-    parent_callback_.Run(damage_rect, bitmap);
+    parent_callback_.Run(damage, bitmap);
   } else {
-    gfx::Rect damage(damage_rect);
-
-    gfx::Size size = GetViewBounds().size();
-    SkBitmap backing;
-    backing.allocN32Pixels(size.width(), size.height(), false);
-    SkCanvas canvas(backing);
-
-    canvas.writePixels(bitmap, 0, 0);
-
-    if (popup_host_view_ && popup_bitmap_.get()) {
-      gfx::Rect pos = popup_host_view_->popup_position_;
-      damage.Union(pos);
-      canvas.writePixels(*popup_bitmap_.get(), pos.x(), pos.y());
-    }
-
-    for (auto* proxy_view : proxy_views_) {
-      gfx::Rect pos = proxy_view->GetBounds();
-      damage.Union(pos);
-      canvas.writePixels(*proxy_view->GetBitmap(), pos.x(), pos.y());
-    }
-
-    damage.Intersect(GetViewBounds());
+    OffScreenDamage frame_damage(damage);
+
+    std::vector<OffScreenBackingStore::Overlay> overlays;
+    if (popup_host_view_ && popup_bitmap_.get())
+      overlays.push_back(
+          {popup_bitmap_.get(), popup_host_view_->popup_position_});
+    for (auto* proxy_view : proxy_views_)
+      overlays.push_back({proxy_view->GetBitmap(), proxy_view->GetBounds()});
+
+    const SkBitmap& backing = backing_store_.Update(
+        GetViewBounds().size(), bitmap, overlays, &frame_damage);
+    base::TimeTicks paint_start = base::TimeTicks::Now();
     paint_callback_running_ = true;
-    callback_.Run(damage, backing);
+    callback_.Run(frame_damage, backing);
     paint_callback_running_ = false;
+    frame_pacer_.OnFramePainted(base::TimeTicks::Now() - paint_start);
   }
 
   ReleaseResize();
 }
 
-void OffScreenRenderWidgetHostView::OnPopupPaint(const gfx::Rect& damage_rect,
+void OffScreenRenderWidgetHostView::OnPopupPaint(const OffScreenDamage& damage,
                                                  const SkBitmap& bitmap) {
   if (popup_host_view_ && popup_bitmap_.get())
     popup_bitmap_.reset(new SkBitmap(bitmap));
@@ -1043,6 +1045,7 @@ void OffScreenRenderWidgetHostView::SynchronizeVisualProperties() {
 
 void OffScreenRenderWidgetHostView::SendMouseEvent(
     const blink::WebMouseEvent& event) {
+  frame_pacer_.Wake();
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->GetBounds();
     if (bounds.Contains(event.PositionInWidget().x,
@@ -1081,6 +1084,7 @@ void OffScreenRenderWidgetHostView::SendMouseEvent(
 
 void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
     const blink::WebMouseWheelEvent& event) {
+  frame_pacer_.Wake();
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->GetBounds();
     if (bounds.Contains(event.PositionInWidget().x,
@@ -1195,6 +1199,30 @@ int OffScreenRenderWidgetHostView::GetFrameRate() const {
   return frame_rate_;
 }
 
+void OffScreenRenderWidgetHostView::SetFramePacing(
+    OffScreenFramePacer::Mode mode,
+    uint32_t max_pending_frames) {
+  frame_pacer_.SetMode(mode, max_pending_frames);
+}
+
+void OffScreenRenderWidgetHostView::AcknowledgeFrame() {
+  frame_pacer_.OnFrameAcknowledged();
+}
+
+OffScreenFramePacer::Metrics
+OffScreenRenderWidgetHostView::GetFramePacingMetrics() const {
+  return frame_pacer_.GetMetrics();
+}
+
+void OffScreenRenderWidgetHostView::SetCompareFrames(bool compare_frames) {
+  compare_frames_ = compare_frames;
+  if (software_output_device_)
+    software_output_device_->SetCompareFrames(compare_frames);
+
+  for (auto* guest_host_view : guest_host_views_)
+    guest_host_view->SetCompareFrames(compare_frames);
+}
+
 #if !defined(OS_MACOSX)
 ui::Compositor* OffScreenRenderWidgetHostView::GetCompositor() const {
   return compositor_.get();
@@ -1215,6 +1243,8 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
     return;
 
   frame_rate_threshold_us_ = 1000000 / frame_rate_;
+  frame_pacer_.SetFrameInterval(
+      base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_));
 
   if (GetCompositor()) {
     GetCompositor()->SetAuthoritativeVSyncInterval(
@@ -1237,12 +1267,13 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
 }
 
 void OffScreenRenderWidgetHostView::Invalidate() {
+  frame_pacer_.Wake();
   InvalidateBounds(GetViewBounds());
 }
 
 void OffScreenRenderWidgetHostView::InvalidateBounds(const gfx::Rect& bounds) {
   if (software_output_device_) {
-    software_output_device_->OnPaint(bounds);
+    software_output_device_->OnPaint(OffScreenDamage(bounds));
   } else if (copy_frame_generator_) {
     copy_frame_generator_->GenerateCopyFrame(bounds);
   }
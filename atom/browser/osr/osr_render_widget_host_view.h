@@ -16,6 +16,8 @@
 
 #include "atom/browser/native_window.h"
 #include "atom/browser/native_window_observer.h"
+#include "atom/browser/osr/osr_backing_store.h"
+#include "atom/browser/osr/osr_frame_pacer.h"
 #include "atom/browser/osr/osr_output_device.h"
 #include "atom/browser/osr/osr_view_proxy.h"
 #include "base/process/kill.h"
@@ -232,12 +234,16 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void OnGuestViewFrameSwapped(
       content::RenderWidgetHostViewGuest* guest_host_view);
 
-  void OnPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
-  void OnPopupPaint(const gfx::Rect& damage_rect, const SkBitmap& bitmap);
+  void OnPaint(const OffScreenDamage& damage, const SkBitmap& bitmap);
+  void OnPopupPaint(const OffScreenDamage& damage, const SkBitmap& bitmap);
   void OnProxyViewPaint(const gfx::Rect& damage_rect) override;
 
   bool IsPopupWidget() const { return popup_type_ != blink::kWebPopupTypeNone; }
 
+  const OffScreenBackingStore::Metrics& paint_metrics() const {
+    return backing_store_.metrics();
+  }
+
   void HoldResize();
   void ReleaseResize();
   void SynchronizeVisualProperties();
@@ -251,6 +257,14 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
 
+  void SetFramePacing(OffScreenFramePacer::Mode mode,
+                      uint32_t max_pending_frames);
+  void AcknowledgeFrame();
+  OffScreenFramePacer::Metrics GetFramePacingMetrics() const;
+
+  void SetCompareFrames(bool compare_frames);
+  bool compare_frames() const { return compare_frames_; }
+
   ui::Compositor* GetCompositor() const;
   ui::Layer* GetRootLayer() const;
 
@@ -313,6 +327,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   const bool transparent_;
   OnPaintCallback callback_;
   OnPaintCallback parent_callback_;
+  OffScreenBackingStore backing_store_;
 
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
@@ -323,6 +338,9 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   gfx::Vector2dF last_scroll_offset_;
   gfx::Size size_;
   bool painting_;
+  // Whether the software output device compares frames to find their
+  // changed tiles.
+  bool compare_frames_ = false;
 
   bool is_showing_ = false;
   bool is_destroyed_ = false;
@@ -344,6 +362,7 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   std::unique_ptr<AtomCopyFrameGenerator> copy_frame_generator_;
   std::unique_ptr<AtomBeginFrameTimer> begin_frame_timer_;
+  OffScreenFramePacer frame_pacer_;
 
   // Provides |source_id| for BeginFrameArgs that we create.
   viz::StubBeginFrameSource begin_frame_source_;
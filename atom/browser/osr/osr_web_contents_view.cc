@@ -102,9 +102,12 @@ OffScreenWebContentsView::CreateViewForWidget(
         render_widget_host->GetView());
   }
 
-  return new OffScreenRenderWidgetHostView(
+  auto* view = new OffScreenRenderWidgetHostView(
       transparent_, painting_, GetFrameRate(), callback_, render_widget_host,
       nullptr, nullptr);
+  view->SetFramePacing(pacing_mode_, max_pending_frames_);
+  view->SetCompareFrames(compare_frames_);
+  return view;
 }
 
 content::RenderWidgetHostViewBase*
@@ -120,9 +123,11 @@ OffScreenWebContentsView::CreateViewForPopupWidget(
                     ->GetRenderWidgetHostView()
               : web_contents_impl->GetRenderWidgetHostView());
 
-  return new OffScreenRenderWidgetHostView(transparent_, true,
-                                           view->GetFrameRate(), callback_,
-                                           render_widget_host, view, nullptr);
+  auto* popup_view = new OffScreenRenderWidgetHostView(
+      transparent_, true, view->GetFrameRate(), callback_, render_widget_host,
+      view, nullptr);
+  popup_view->SetCompareFrames(view->compare_frames());
+  return popup_view;
 }
 
 void OffScreenWebContentsView::SetPageTitle(const base::string16& title) {}
@@ -209,6 +214,22 @@ int OffScreenWebContentsView::GetFrameRate() const {
   }
 }
 
+void OffScreenWebContentsView::SetFramePacing(OffScreenFramePacer::Mode mode,
+                                              uint32_t max_pending_frames) {
+  pacing_mode_ = mode;
+  max_pending_frames_ = max_pending_frames;
+  auto* view = GetView();
+  if (view != nullptr)
+    view->SetFramePacing(mode, max_pending_frames);
+}
+
+void OffScreenWebContentsView::SetCompareFrames(bool compare_frames) {
+  compare_frames_ = compare_frames;
+  auto* view = GetView();
+  if (view != nullptr)
+    view->SetCompareFrames(compare_frames);
+}
+
 OffScreenRenderWidgetHostView* OffScreenWebContentsView::GetView() const {
   if (web_contents_) {
     return static_cast<OffScreenRenderWidgetHostView*>(
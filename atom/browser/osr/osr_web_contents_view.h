@@ -75,6 +75,9 @@ class OffScreenWebContentsView : public content::WebContentsView,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  void SetFramePacing(OffScreenFramePacer::Mode mode,
+                      uint32_t max_pending_frames);
+  void SetCompareFrames(bool compare_frames);
 
  private:
 #if defined(OS_MACOSX)
@@ -87,6 +90,10 @@ class OffScreenWebContentsView : public content::WebContentsView,
   const bool transparent_;
   bool painting_ = true;
   int frame_rate_ = 60;
+  // Kept for the views created by later navigations.
+  OffScreenFramePacer::Mode pacing_mode_ = OffScreenFramePacer::Mode::FIXED;
+  uint32_t max_pending_frames_ = 0;
+  bool compare_frames_ = false;
   OnPaintCallback callback_;
 
   // Weak refs.
@@ -0,0 +1,210 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/spare_renderer_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "atom/browser/child_web_contents_tracker.h"
+#include "atom/browser/web_contents_preferences.h"
+#include "base/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+#include "content/public/browser/web_contents.h"
+
+namespace atom {
+
+namespace {
+
+// Launching renderers competes with the window that just took a spare one,
+// wait a bit before replacing it.
+const int kFillDelayMs = 1000;
+
+// Keeps a spare renderer's SiteInstance alive for the WebContents it was
+// handed to, the navigation only takes its own reference later.
+struct SpareInstanceHolder : public base::SupportsUserData::Data {
+  explicit SpareInstanceHolder(scoped_refptr<content::SiteInstance> instance)
+      : instance(std::move(instance)) {}
+
+  scoped_refptr<content::SiteInstance> instance;
+};
+
+int kSpareInstanceKey = 0;
+
+// The partition only picks the session, which the pool already belongs to.
+base::Value GetProfile(const base::Value& preference) {
+  base::Value profile = preference.Clone();
+  profile.RemoveKey("partition");
+  return profile;
+}
+
+}  // namespace
+
+// static
+int SpareRendererPool::kLocatorKey = 0;
+
+// static
+SpareRendererPool* SpareRendererPool::FromBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<SpareRendererPool*>(context->GetUserData(&kLocatorKey));
+}
+
+// static
+WebContentsPreferences* SpareRendererPool::GetPreferencesForSpare(
+    int process_id) {
+  auto* host = content::RenderProcessHost::FromID(process_id);
+  if (!host)
+    return nullptr;
+  auto* self = FromBrowserContext(host->GetBrowserContext());
+  if (!self || !self->IsSpare(process_id))
+    return nullptr;
+  return self->web_preferences_.get();
+}
+
+SpareRendererPool::SpareRendererPool(content::BrowserContext* context)
+    : context_(context), weak_factory_(this) {
+  context->SetUserData(&kLocatorKey, base::WrapUnique(this));
+}
+
+SpareRendererPool::~SpareRendererPool() {
+  while (!spares_.empty())
+    Remove(spares_.size() - 1);
+}
+
+void SpareRendererPool::SetProfile(
+    size_t count,
+    std::unique_ptr<WebContentsPreferences> web_preferences) {
+  // Renderers launched for other preferences can not be handed out anymore.
+  bool same_profile =
+      web_preferences_ && web_preferences &&
+      *web_preferences_->preference() == *web_preferences->preference();
+  size_t keep = same_profile ? count : 0;
+  while (spares_.size() > keep) {
+    int process_id = spares_.back().process_id;
+    Remove(spares_.size() - 1);
+    auto* host = content::RenderProcessHost::FromID(process_id);
+    if (host)
+      host->Cleanup();
+  }
+
+  count_ = count;
+  web_preferences_ = std::move(web_preferences);
+  profile_ = web_preferences_ ? GetProfile(*web_preferences_->preference())
+                              : base::Value();
+  Fill();
+}
+
+content::SiteInstance* SpareRendererPool::Take(
+    content::WebContents* web_contents) {
+  if (spares_.empty())
+    return nullptr;
+
+  // Spare renderers are in a BrowsingInstance of their own, which only works
+  // for windows that have no opener to script them. Later navigations stay
+  // in the BrowsingInstance of the window.
+  if (web_contents->HasOpener() ||
+      ChildWebContentsTracker::IsChildWebContents(web_contents) ||
+      !web_contents->GetController().IsInitialNavigation() ||
+      web_contents->GetUserData(&kSpareInstanceKey))
+    return nullptr;
+
+  if (!MatchesProfile(WebContentsPreferences::From(web_contents)))
+    return nullptr;
+
+  for (size_t i = 0; i < spares_.size(); ++i) {
+    // The process is locked to the site of the navigation once it commits,
+    // which site isolation only allows for unused processes.
+    auto* host = content::RenderProcessHost::FromID(spares_[i].process_id);
+    if (!host || !host->HasConnection() || !host->IsUnused() ||
+        spares_[i].instance->HasSite())
+      continue;
+    scoped_refptr<content::SiteInstance> instance = Remove(i);
+    ScheduleFill();
+    content::SiteInstance* result = instance.get();
+    web_contents->SetUserData(
+        &kSpareInstanceKey,
+        std::make_unique<SpareInstanceHolder>(std::move(instance)));
+    return result;
+  }
+  return nullptr;
+}
+
+void SpareRendererPool::RenderProcessExited(
+    content::RenderProcessHost* host,
+    const content::ChildProcessTerminationInfo& info) {
+  // Not refilled, a renderer that keeps crashing would be launched forever.
+  RenderProcessHostDestroyed(host);
+}
+
+void SpareRendererPool::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  for (size_t i = 0; i < spares_.size(); ++i) {
+    if (spares_[i].process_id == host->GetID()) {
+      Remove(i);
+      return;
+    }
+  }
+}
+
+void SpareRendererPool::Fill() {
+  fill_scheduled_ = false;
+  while (web_preferences_ && spares_.size() < count_) {
+    auto instance = content::SiteInstance::Create(context_);
+    auto* host = instance->GetProcess();
+    // Past the process limit an existing renderer is returned, there is no
+    // point in launching more.
+    if (host->HasConnection() || !host->IsUnused())
+      return;
+
+    // Register the spare before launching it, the command line of the process
+    // is built from |web_preferences_|.
+    spares_.push_back({instance, host->GetID()});
+    host->AddObserver(this);
+    if (!host->Init()) {
+      Remove(spares_.size() - 1);
+      return;
+    }
+  }
+}
+
+void SpareRendererPool::ScheduleFill() {
+  if (fill_scheduled_)
+    return;
+  fill_scheduled_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&SpareRendererPool::Fill, weak_factory_.GetWeakPtr()),
+      base::TimeDelta::FromMilliseconds(kFillDelayMs));
+}
+
+scoped_refptr<content::SiteInstance> SpareRendererPool::Remove(size_t index) {
+  Spare spare = std::move(spares_[index]);
+  spares_.erase(spares_.begin() + index);
+  auto* host = content::RenderProcessHost::FromID(spare.process_id);
+  if (host)
+    host->RemoveObserver(this);
+  return spare.instance;
+}
+
+bool SpareRendererPool::IsSpare(int process_id) const {
+  for (const auto& spare : spares_) {
+    if (spare.process_id == process_id)
+      return true;
+  }
+  return false;
+}
+
+bool SpareRendererPool::MatchesProfile(
+    WebContentsPreferences* web_preferences) const {
+  return web_preferences &&
+         GetProfile(*web_preferences->preference()) == profile_;
+}
+
+}  // namespace atom
@@ -0,0 +1,104 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_SPARE_RENDERER_POOL_H_
+#define ATOM_BROWSER_SPARE_RENDERER_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/values.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+class WebContents;
+}
+
+namespace atom {
+
+class WebContentsPreferences;
+
+// Keeps renderer processes of a session launched ahead of time, so the
+// WebContents whose preferences match the pool's profile do not have to wait
+// for a new process on their first navigation.
+class SpareRendererPool : public base::SupportsUserData::Data,
+                          public content::RenderProcessHostObserver {
+ public:
+  static SpareRendererPool* FromBrowserContext(
+      content::BrowserContext* context);
+
+  // Returns the preferences of the pool if |process_id| is a spare renderer
+  // that has not been handed out yet.
+  static WebContentsPreferences* GetPreferencesForSpare(int process_id);
+
+  explicit SpareRendererPool(content::BrowserContext* context);
+  ~SpareRendererPool() override;
+
+  // Keeps |count| spare renderers launched for |web_preferences|, a count of
+  // 0 shuts the spare renderers down.
+  void SetProfile(size_t count,
+                  std::unique_ptr<WebContentsPreferences> web_preferences);
+
+  // Hands out a spare renderer for the initial navigation of |web_contents|,
+  // returns null when there is no spare renderer it can use. The returned
+  // SiteInstance is kept alive by |web_contents|.
+  content::SiteInstance* Take(content::WebContents* web_contents);
+
+  size_t count() const { return count_; }
+  size_t spare_count() const { return spares_.size(); }
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessExited(
+      content::RenderProcessHost* host,
+      const content::ChildProcessTerminationInfo& info) override;
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+ private:
+  // Launches renderers until there are |count_| of them.
+  void Fill();
+  void ScheduleFill();
+
+  // Stops observing the renderer at |index| and removes it from the pool.
+  scoped_refptr<content::SiteInstance> Remove(size_t index);
+
+  bool IsSpare(int process_id) const;
+
+  // Whether a WebContents with |web_preferences| may use the spare renderers.
+  bool MatchesProfile(WebContentsPreferences* web_preferences) const;
+
+  // The user data key.
+  static int kLocatorKey;
+
+  content::BrowserContext* context_;
+
+  size_t count_ = 0;
+  std::unique_ptr<WebContentsPreferences> web_preferences_;
+  // The preferences of |web_preferences_| that a WebContents must have too
+  // to use a spare renderer. They are matched as a whole, everything the
+  // browser reads from the preferences of a renderer comes from them.
+  base::Value profile_;
+
+  struct Spare {
+    scoped_refptr<content::SiteInstance> instance;
+    // Asking the SiteInstance would launch a new process once the spare one
+    // is gone.
+    int process_id;
+  };
+  std::vector<Spare> spares_;
+
+  bool fill_scheduled_ = false;
+
+  base::WeakPtrFactory<SpareRendererPool> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRendererPool);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_SPARE_RENDERER_POOL_H_
@@ -86,6 +86,25 @@ WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const mate::Dictionary& web_preferences)
     : web_contents_(web_contents) {
+  SetPreferences(web_preferences);
+  web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
+
+  instances_.push_back(this);
+}
+
+WebContentsPreferences::WebContentsPreferences(
+    const mate::Dictionary& web_preferences)
+    : web_contents_(nullptr) {
+  SetPreferences(web_preferences);
+}
+
+WebContentsPreferences::~WebContentsPreferences() {
+  instances_.erase(std::remove(instances_.begin(), instances_.end(), this),
+                   instances_.end());
+}
+
+void WebContentsPreferences::SetPreferences(
+    const mate::Dictionary& web_preferences) {
   v8::Isolate* isolate = web_preferences.isolate();
   mate::Dictionary copied(isolate, web_preferences.GetHandle()->Clone());
   // Following fields should not be stored.
@@ -94,9 +113,6 @@ WebContentsPreferences::WebContentsPreferences(
   copied.Delete("session");
 
   mate::ConvertFromV8(isolate, copied.GetHandle(), &preference_);
-  web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
-
-  instances_.push_back(this);
 
   // Set WebPreferences defaults onto the JS object
   SetDefaultBoolIfUndefined(options::kPlugins, false);
@@ -129,11 +145,6 @@ WebContentsPreferences::WebContentsPreferences(
   last_preference_ = preference_.Clone();
 }
 
-WebContentsPreferences::~WebContentsPreferences() {
-  instances_.erase(std::remove(instances_.begin(), instances_.end(), this),
-                   instances_.end());
-}
-
 bool WebContentsPreferences::SetDefaultBoolIfUndefined(
     const base::StringPiece& key,
     bool val) {
@@ -279,6 +290,20 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (IsEnabled(options::kContextIsolation))
     command_line->AppendSwitch(switches::kContextIsolation);
 
+  // Run the sampling profiler of the main process in the renderer too.
+  auto* browser_command_line = base::CommandLine::ForCurrentProcess();
+  if (IsEnabled(options::kSamplingProfiler) &&
+      browser_command_line->HasSwitch(switches::kSamplingProfilerDir)) {
+    for (const char* name :
+         {switches::kSamplingProfilerDir, switches::kSamplingProfilerInterval,
+          switches::kSamplingProfilerWindow,
+          switches::kSamplingProfilerThreshold}) {
+      if (browser_command_line->HasSwitch(name))
+        command_line->AppendSwitchNative(
+            name, browser_command_line->GetSwitchValueNative(name));
+    }
+  }
+
   // --background-color.
   std::string s;
   if (GetAsString(&preference_, options::kBackgroundColor, &s)) {
@@ -328,7 +353,7 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (GetAsString(&preference_, options::kDisableBlinkFeatures, &s))
     command_line->AppendSwitchASCII(::switches::kDisableBlinkFeatures, s);
 
-  if (guest_instance_id) {
+  if (guest_instance_id && web_contents_) {
     // Webview `document.visibilityState` tracks window visibility so we need
     // to let it know if the window happens to be hidden right now.
     auto* manager = WebViewManager::GetWebViewManager(web_contents_);
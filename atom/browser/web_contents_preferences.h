@@ -34,6 +34,9 @@ class WebContentsPreferences
 
   WebContentsPreferences(content::WebContents* web_contents,
                          const mate::Dictionary& web_preferences);
+  // Preferences that are not attached to any WebContents, which describe the
+  // renderers launched ahead of time by SpareRendererPool.
+  explicit WebContentsPreferences(const mate::Dictionary& web_preferences);
   ~WebContentsPreferences() override;
 
   // A simple way to know whether a Boolean property is enabled.
@@ -72,6 +75,9 @@ class WebContentsPreferences
   // Get WebContents according to process ID.
   static content::WebContents* GetWebContentsFromProcessID(int process_id);
 
+  // Copy |web_preferences| and fill in the defaults.
+  void SetPreferences(const mate::Dictionary& web_preferences);
+
   // Set preference value to given bool if user did not provide value
   bool SetDefaultBoolIfUndefined(const base::StringPiece& key, bool val);
 
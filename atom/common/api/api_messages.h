@@ -83,3 +83,5 @@ IPC_MESSAGE_ROUTED2(AtomFrameHostMsg_PDFSaveURLAs,
 IPC_MESSAGE_ROUTED2(AtomFrameMsg_TakeHeapSnapshot,
                     IPC::PlatformFileForTransit /* file_handle */,
                     std::string /* channel */)
+
+IPC_MESSAGE_ROUTED1(AtomFrameMsg_GetMemoryUsage, std::string /* channel */)
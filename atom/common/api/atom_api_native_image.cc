@@ -4,33 +4,46 @@
 
 #include "atom/common/api/atom_api_native_image.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "atom/common/asar/asar_util.h"
+#include "atom/common/image_cache.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "atom/common/pixel_pipeline.h"
+#include "atom/common/promise_util.h"
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "base/task_scheduler/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "native_mate/object_template_builder.h"
 #include "net/base/data_url.h"
+#include "skia/ext/image_operations.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "ui/base/layout.h"
 #include "ui/base/webui/web_ui_util.h"
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
+#include "ui/gfx/skia_util.h"
 
 #if defined(OS_WIN)
 #include "atom/common/asar/archive.h"
@@ -107,34 +120,160 @@ bool AddImageSkiaRep(gfx::ImageSkia* image,
 
   if (!decoded) {
     // Try Bitmap
-    if (width > 0 && height > 0) {
-      decoded.reset(new SkBitmap);
-      decoded->allocN32Pixels(width, height, false);
-      decoded->setPixels(
-          const_cast<void*>(reinterpret_cast<const void*>(data)));
-    } else {
+    if (width <= 0 || height <= 0)
       return false;
-    }
+    // The pixels are copied, |data| may be a JS buffer that is changed or
+    // collected while the image is still used, also by the async encoders.
+    decoded.reset(new SkBitmap);
+    if (!decoded->tryAllocN32Pixels(width, height, false) ||
+        size < decoded->computeByteSize())
+      return false;
+    memcpy(decoded->getPixels(), data, decoded->computeByteSize());
   }
 
   image->AddRepresentation(gfx::ImageSkiaRep(*decoded, scale_factor));
   return true;
 }
 
+struct ThumbnailOptions {
+  // Bounds the thumbnail is scaled down to fit in, the image keeps its size
+  // when empty.
+  gfx::Size max_size;
+  // Part of the image that is decoded, the whole image when empty.
+  gfx::Rect rect;
+};
+
+bool GetThumbnailOptions(const mate::Dictionary& options,
+                         ThumbnailOptions* thumbnail) {
+  bool has_max_size = options.Get("maxSize", &thumbnail->max_size);
+  bool has_rect = options.Get("rect", &thumbnail->rect);
+  return has_max_size || has_rect;
+}
+
+// Decodes a PNG or JPEG image directly at a reduced size. The codec skips
+// the rows and columns that are not needed, and JPEG images are scaled in
+// the DCT, so the full resolution image is never allocated.
+bool DecodeThumbnail(const unsigned char* data,
+                     size_t size,
+                     const ThumbnailOptions& options,
+                     SkBitmap* bitmap) {
+  std::unique_ptr<SkAndroidCodec> codec =
+      SkAndroidCodec::MakeFromData(SkData::MakeWithoutCopy(data, size));
+  if (!codec)
+    return false;
+
+  SkIRect bounds = SkIRect::MakeSize(codec->getInfo().dimensions());
+  SkIRect rect = bounds;
+  if (!options.rect.IsEmpty()) {
+    rect = gfx::RectToSkIRect(options.rect);
+    if (!bounds.contains(rect))
+      return false;
+  }
+  // The codec may only support subsets that are aligned to its blocks, the
+  // decoded subset is cropped to |rect| below.
+  SkIRect subset = rect;
+  if (!options.rect.IsEmpty() &&
+      (!codec->getSupportedSubset(&subset) || !subset.contains(rect)))
+    return false;
+
+  gfx::Size target(rect.width(), rect.height());
+  if (!options.max_size.IsEmpty()) {
+    float scale = std::min(
+        {1.f, static_cast<float>(options.max_size.width()) / rect.width(),
+         static_cast<float>(options.max_size.height()) / rect.height()});
+    target = gfx::ScaleToRoundedSize(target, scale);
+    target.SetToMax(gfx::Size(1, 1));
+  }
+
+  // Sample by the largest power of two that still decodes at least the
+  // target size, the rest is scaled with a proper filter below.
+  int sample_size = 1;
+  while (rect.width() / (sample_size * 2) >= target.width() &&
+         rect.height() / (sample_size * 2) >= target.height())
+    sample_size *= 2;
+
+  SkISize decoded_size =
+      codec->getSampledSubsetDimensions(sample_size, subset);
+  SkAlphaType alpha_type =
+      codec->computeOutputAlphaType(/* requestedUnpremul */ false);
+  SkBitmap decoded;
+  if (decoded_size.isEmpty() ||
+      !decoded.tryAllocPixels(SkImageInfo::MakeN32(
+          decoded_size.width(), decoded_size.height(), alpha_type)))
+    return false;
+
+  SkAndroidCodec::AndroidOptions android_options;
+  android_options.fSampleSize = sample_size;
+  if (!options.rect.IsEmpty())
+    android_options.fSubset = &subset;
+  SkCodec::Result result =
+      codec->getAndroidPixels(decoded.info(), decoded.getPixels(),
+                              decoded.rowBytes(), &android_options);
+  if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput)
+    return false;
+
+  // The part of the sampled subset that shows |rect|.
+  gfx::Rect crop = gfx::ScaleToEnclosingRect(
+      gfx::Rect(rect.x() - subset.x(), rect.y() - subset.y(), rect.width(),
+                rect.height()),
+      1.f / sample_size);
+  crop.Intersect(gfx::Rect(decoded.width(), decoded.height()));
+  SkBitmap cropped;
+  if (crop.IsEmpty() ||
+      !decoded.extractSubset(&cropped, gfx::RectToSkIRect(crop)))
+    return false;
+
+  if (crop.size() != target) {
+    *bitmap = skia::ImageOperations::Resize(
+        cropped, skia::ImageOperations::RESIZE_GOOD, target.width(),
+        target.height());
+  } else if (crop.size() == gfx::Size(decoded.width(), decoded.height())) {
+    *bitmap = decoded;
+  } else {
+    // Copied so the rest of the decoded subset is not kept alive.
+    if (!bitmap->tryAllocPixels(cropped.info()) ||
+        !cropped.readPixels(bitmap->pixmap()))
+      return false;
+  }
+  return true;
+}
+
 bool AddImageSkiaRep(gfx::ImageSkia* image,
                      const base::FilePath& path,
                      double scale_factor) {
+  ImageCache* cache = ImageCache::GetInstance();
+  ImageCache::Key key;
   std::string file_contents;
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
-    if (!asar::ReadFileToString(path, &file_contents))
+    if (!ImageCache::GetKey(path, scale_factor, &key))
       return false;
+
+    gfx::ImageSkiaRep cached;
+    if (cache->Get(key, &cached)) {
+      if (cached.is_null())
+        return false;
+      image->AddRepresentation(cached);
+      return true;
+    }
+
+    if (!asar::ReadFileToString(path, &file_contents)) {
+      cache->Put(key, gfx::ImageSkiaRep());
+      return false;
+    }
   }
 
   const unsigned char* data =
       reinterpret_cast<const unsigned char*>(file_contents.data());
   size_t size = file_contents.size();
-  return AddImageSkiaRep(image, data, size, 0, 0, scale_factor);
+  gfx::ImageSkia decoded;
+  if (!AddImageSkiaRep(&decoded, data, size, 0, 0, scale_factor)) {
+    cache->Put(key, gfx::ImageSkiaRep());
+    return false;
+  }
+
+  image->AddRepresentation(cache->Put(key, decoded.image_reps().front()));
+  return true;
 }
 
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
@@ -204,7 +343,244 @@ bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
 }
 #endif
 
-void Noop(char*, void*) {}
+// Representations decoded or resized on the task scheduler, they are only
+// turned into a gfx::ImageSkia on the JS thread.
+using ImageSkiaReps = std::vector<gfx::ImageSkiaRep>;
+
+struct ResizeOptions {
+  bool width_set = false;
+  bool height_set = false;
+  int width = 0;
+  int height = 0;
+  skia::ImageOperations::ResizeMethod method =
+      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+};
+
+ResizeOptions GetResizeOptions(const base::DictionaryValue& options) {
+  ResizeOptions resize;
+  resize.width_set = options.GetInteger("width", &resize.width);
+  resize.height_set = options.GetInteger("height", &resize.height);
+
+  std::string quality;
+  options.GetString("quality", &quality);
+  if (quality == "good")
+    resize.method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality == "better")
+    resize.method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return resize;
+}
+
+gfx::Size GetResizedSize(const gfx::Size& original,
+                         const ResizeOptions& resize) {
+  float aspect_ratio =
+      original.IsEmpty()
+          ? 1.f
+          : static_cast<float>(original.width()) / original.height();
+  gfx::Size size(resize.width_set ? resize.width : original.width(),
+                 resize.height_set ? resize.height : original.height());
+  if (resize.width_set && !resize.height_set) {
+    // Scale height to preserve original aspect ratio
+    size.set_height(size.width());
+    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / aspect_ratio);
+  } else if (resize.height_set && !resize.width_set) {
+    // Scale width to preserve original aspect ratio
+    size.set_width(size.height());
+    size = gfx::ScaleToRoundedSize(size, aspect_ratio, 1.f);
+  }
+  return size;
+}
+
+gfx::ImageSkia CreateImageSkia(const ImageSkiaReps& reps) {
+  gfx::ImageSkia image;
+  for (const auto& rep : reps)
+    image.AddRepresentation(rep);
+  return image;
+}
+
+ImageSkiaReps GetImageSkiaReps(const gfx::Image& image) {
+  if (image.IsEmpty())
+    return ImageSkiaReps();
+  const gfx::ImageSkia* image_skia = image.ToImageSkia();
+  ImageSkiaReps reps = image_skia->image_reps();
+  if (reps.empty())
+    reps.push_back(image_skia->GetRepresentation(1.0f));
+  return reps;
+}
+
+ImageSkiaReps ReadImageSkiaRepsFromPath(const base::FilePath& path) {
+  gfx::ImageSkia image;
+  PopulateImageSkiaRepsFromPath(&image, path);
+  return image.image_reps();
+}
+
+ImageSkiaReps DecodeImageSkiaReps(const std::string& data,
+                                  int width,
+                                  int height,
+                                  double scale_factor) {
+  gfx::ImageSkia image;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  if (!AddImageSkiaRep(&image, bytes, data.size(), width, height,
+                       scale_factor))
+    return ImageSkiaReps();
+  return image.image_reps();
+}
+
+ImageSkiaReps ResizeImageSkiaReps(const ImageSkiaReps& reps,
+                                  const ResizeOptions& resize) {
+  if (reps.empty())
+    return reps;
+
+  const gfx::ImageSkiaRep& first = reps.front();
+  gfx::Size size = GetResizedSize(
+      gfx::ScaleToFlooredSize(first.pixel_size(), 1.f / first.scale()),
+      resize);
+  if (size.IsEmpty())
+    return ImageSkiaReps();
+
+  ImageSkiaReps resized;
+  for (const auto& rep : reps) {
+    gfx::Size pixel_size = gfx::ScaleToCeiledSize(size, rep.scale());
+    resized.emplace_back(
+        skia::ImageOperations::Resize(rep.sk_bitmap(), resize.method,
+                                      pixel_size.width(),
+                                      pixel_size.height()),
+        rep.scale());
+  }
+  return resized;
+}
+
+ImageSkiaReps ReadAndResizeImageSkiaReps(const base::FilePath& path,
+                                         const ResizeOptions& resize) {
+  ImageSkiaReps reps = ReadImageSkiaRepsFromPath(path);
+  if (!resize.width_set && !resize.height_set)
+    return reps;
+  return ResizeImageSkiaReps(reps, resize);
+}
+
+ImageSkiaReps ReadThumbnailFromPath(const base::FilePath& path,
+                                    const ThumbnailOptions& options) {
+  std::string file_contents;
+  if (!asar::ReadFileToString(path, &file_contents))
+    return ImageSkiaReps();
+
+  SkBitmap bitmap;
+  if (!DecodeThumbnail(
+          reinterpret_cast<const unsigned char*>(file_contents.data()),
+          file_contents.size(), options, &bitmap))
+    return ImageSkiaReps();
+  return ImageSkiaReps{gfx::ImageSkiaRep(bitmap, 1.0f)};
+}
+
+std::vector<unsigned char> EncodePNG(const SkBitmap& bitmap) {
+  std::vector<unsigned char> encoded;
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeJPEG(const SkBitmap& bitmap, int quality) {
+  std::vector<unsigned char> encoded;
+  if (!gfx::JPEGCodec::Encode(bitmap, quality, &encoded))
+    encoded.clear();
+  return encoded;
+}
+
+// Enters the context the promise was created in, the results of the task
+// scheduler are delivered outside of any JS call.
+class PromiseScope {
+ public:
+  explicit PromiseScope(util::Promise* promise)
+      : locker_(promise->isolate()),
+        handle_scope_(promise->isolate()),
+        context_scope_(promise->GetHandle()->CreationContext()) {}
+
+ private:
+  v8::Locker locker_;
+  v8::HandleScope handle_scope_;
+  v8::Context::Scope context_scope_;
+
+  DISALLOW_COPY_AND_ASSIGN(PromiseScope);
+};
+
+mate::Handle<NativeImage> CreateFromImageSkiaReps(v8::Isolate* isolate,
+                                                  const ImageSkiaReps& reps,
+                                                  bool is_template) {
+  mate::Handle<NativeImage> handle =
+      NativeImage::Create(isolate, gfx::Image(CreateImageSkia(reps)));
+#if defined(OS_MACOSX)
+  if (is_template)
+    handle->SetTemplateImage(true);
+#endif
+  return handle;
+}
+
+void ResolveWithImage(scoped_refptr<util::Promise> promise,
+                      bool is_template,
+                      ImageSkiaReps reps) {
+  PromiseScope scope(promise.get());
+  promise->Resolve(
+      CreateFromImageSkiaReps(promise->isolate(), reps, is_template));
+}
+
+void ResolveWithBuffer(scoped_refptr<util::Promise> promise,
+                       std::vector<unsigned char> data) {
+  PromiseScope scope(promise.get());
+  promise->Resolve(
+      node::Buffer::Copy(promise->isolate(),
+                         reinterpret_cast<const char*>(data.data()),
+                         data.size())
+          .ToLocalChecked());
+}
+
+// Collects the images of a batch, which are read in parallel.
+class ImageBatch : public base::RefCounted<ImageBatch> {
+ public:
+  ImageBatch(scoped_refptr<util::Promise> promise,
+             const std::vector<base::FilePath>& paths)
+      : promise_(promise), paths_(paths), images_(paths.size()) {}
+
+  void Start(const ResizeOptions& resize) {
+    if (paths_.empty()) {
+      promise_->Resolve(std::vector<mate::Handle<NativeImage>>());
+      return;
+    }
+    remaining_ = paths_.size();
+    for (size_t i = 0; i < paths_.size(); ++i) {
+      base::PostTaskWithTraitsAndReplyWithResult(
+          FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+          base::BindOnce(&ReadAndResizeImageSkiaReps, paths_[i], resize),
+          base::BindOnce(&ImageBatch::OnImageRead, this, i));
+    }
+  }
+
+ private:
+  friend class base::RefCounted<ImageBatch>;
+  ~ImageBatch() {}
+
+  void OnImageRead(size_t index, ImageSkiaReps reps) {
+    images_[index] = std::move(reps);
+    if (--remaining_ > 0)
+      return;
+
+    PromiseScope scope(promise_.get());
+    std::vector<mate::Handle<NativeImage>> handles;
+    for (size_t i = 0; i < images_.size(); ++i) {
+      bool is_template = false;
+#if defined(OS_MACOSX)
+      is_template = IsTemplateFilename(paths_[i]);
+#endif
+      handles.push_back(CreateFromImageSkiaReps(promise_->isolate(),
+                                                images_[i], is_template));
+    }
+    promise_->Resolve(handles);
+  }
+
+  scoped_refptr<util::Promise> promise_;
+  std::vector<base::FilePath> paths_;
+  std::vector<ImageSkiaReps> images_;
+  size_t remaining_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageBatch);
+};
 
 }  // namespace
 
@@ -239,6 +615,14 @@ NativeImage::~NativeImage() {
   }
 }
 
+void NativeImage::Release() {
+  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
+    isolate()->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(
+        image_.ToImageSkia()->bitmap()->computeByteSize()));
+  }
+  image_ = gfx::Image();
+}
+
 #if defined(OS_WIN)
 HICON NativeImage::GetHICON(int size) {
   auto iter = hicons_.find(size);
@@ -282,17 +666,59 @@ v8::Local<v8::Value> NativeImage::ToPNG(mate::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToBitmap(mate::Arguments* args) {
-  float scale_factor = GetScaleFactorFromOptions(args);
+  float scale_factor = 1.0f;
+  int width = 0;
+  int height = 0;
+  std::string format;
+  PixelPipelineOptions pipeline;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("scaleFactor", &scale_factor);
+    options.Get("rect", &pipeline.source_rect);
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("format", &format);
+    options.Get("premultiplied", &pipeline.premultiplied);
+  }
+
+  if (format == "rgba") {
+    pipeline.format = PixelFormat::RGBA;
+  } else if (format == "bgra") {
+    pipeline.format = PixelFormat::BGRA;
+  } else if (!format.empty()) {
+    args->ThrowError("format must be either 'bgra' or 'rgba'");
+    return v8::Undefined(args->isolate());
+  }
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
-  SkPixelRef* ref = bitmap.pixelRef();
-  if (!ref)
+  SkPixmap pixmap;
+  if (!bitmap.peekPixels(&pixmap))
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
-  return node::Buffer::Copy(args->isolate(),
-                            reinterpret_cast<const char*>(ref->pixels()),
-                            bitmap.computeByteSize())
-      .ToLocalChecked();
+
+  // Scale the missing dimension to preserve the aspect ratio of the rect.
+  gfx::Size rect_size = pipeline.source_rect.IsEmpty()
+                            ? gfx::Size(bitmap.width(), bitmap.height())
+                            : pipeline.source_rect.size();
+  if (width > 0 && height <= 0 && !rect_size.IsEmpty())
+    height = std::max(1, width * rect_size.height() / rect_size.width());
+  else if (height > 0 && width <= 0 && !rect_size.IsEmpty())
+    width = std::max(1, height * rect_size.width() / rect_size.height());
+  pipeline.output_size.SetSize(width, height);
+
+  if (!ResolvePixelPipelineOptions(pixmap, &pipeline)) {
+    args->ThrowError(
+        "rect must be inside the image and the size must not exceed it");
+    return v8::Undefined(args->isolate());
+  }
+
+  v8::Local<v8::Object> buffer =
+      node::Buffer::New(args->isolate(),
+                        pipeline.output_size.GetArea() * sizeof(uint32_t))
+          .ToLocalChecked();
+  RunPixelPipeline(pixmap, pipeline,
+                   reinterpret_cast<uint8_t*>(node::Buffer::Data(buffer)));
+  return buffer;
 }
 
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
@@ -306,6 +732,42 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
       .ToLocalChecked();
 }
 
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(mate::Arguments* args) {
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  if (scale_factor == 1.0f &&
+      image_.HasRepresentation(gfx::Image::kImageRepPNG)) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    const char* data = reinterpret_cast<const char*>(png->front());
+    promise->Resolve(node::Buffer::Copy(args->isolate(), data, png->size())
+                         .ToLocalChecked());
+    return promise->GetHandle();
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodePNG, bitmap),
+      base::BindOnce(&ResolveWithBuffer, promise));
+  return promise->GetHandle();
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+  SkBitmap bitmap;
+  if (!image_.IsEmpty())
+    bitmap = image_.AsImageSkia().GetRepresentation(1.0f).sk_bitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&EncodeJPEG, bitmap, quality),
+      base::BindOnce(&ResolveWithBuffer, promise));
+  return promise->GetHandle();
+}
+
 std::string NativeImage::ToDataURL(mate::Arguments* args) {
   float scale_factor = GetScaleFactorFromOptions(args);
 
@@ -328,9 +790,11 @@ v8::Local<v8::Value> NativeImage::GetBitmap(mate::Arguments* args) {
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
-  return node::Buffer::New(args->isolate(),
-                           reinterpret_cast<char*>(ref->pixels()),
-                           bitmap.computeByteSize(), &Noop, nullptr)
+  // The pixels may be shared with other images through the decoded image
+  // cache, so they must not be handed out for writing.
+  return node::Buffer::Copy(args->isolate(),
+                            reinterpret_cast<const char*>(ref->pixels()),
+                            bitmap.computeByteSize())
       .ToLocalChecked();
 }
 
@@ -369,38 +833,25 @@ float NativeImage::GetAspectRatio() {
 mate::Handle<NativeImage> NativeImage::Resize(
     v8::Isolate* isolate,
     const base::DictionaryValue& options) {
-  gfx::Size size = GetSize();
-  int width = size.width();
-  int height = size.height();
-  bool width_set = options.GetInteger("width", &width);
-  bool height_set = options.GetInteger("height", &height);
-  size.SetSize(width, height);
-
-  if (width_set && !height_set) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio());
-  } else if (height_set && !width_set) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
-  }
-
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string quality;
-  options.GetString("quality", &quality);
-  if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
-
+  ResizeOptions resize = GetResizeOptions(options);
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image_.AsImageSkia(), resize.method, GetResizedSize(GetSize(), resize));
   return mate::CreateHandle(isolate,
                             new NativeImage(isolate, gfx::Image(resized)));
 }
 
+v8::Local<v8::Promise> NativeImage::ResizeAsync(
+    v8::Isolate* isolate,
+    const base::DictionaryValue& options) {
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ResizeImageSkiaReps, GetImageSkiaReps(image_),
+                     GetResizeOptions(options)),
+      base::BindOnce(&ResolveWithImage, promise, IsTemplateImage()));
+  return promise->GetHandle();
+}
+
 mate::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                             const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -512,21 +963,117 @@ mate::Handle<NativeImage> NativeImage::CreateFromBuffer(
   int width = 0;
   int height = 0;
   double scale_factor = 1.;
+  ThumbnailOptions thumbnail_options;
+  bool has_thumbnail_options = false;
 
   mate::Dictionary options;
   if (args->GetNext(&options)) {
     options.Get("width", &width);
     options.Get("height", &height);
     options.Get("scaleFactor", &scale_factor);
+    has_thumbnail_options = GetThumbnailOptions(options, &thumbnail_options);
   }
 
   gfx::ImageSkia image_skia;
-  AddImageSkiaRep(&image_skia,
-                  reinterpret_cast<unsigned char*>(node::Buffer::Data(buffer)),
-                  node::Buffer::Length(buffer), width, height, scale_factor);
+  const auto* data =
+      reinterpret_cast<unsigned char*>(node::Buffer::Data(buffer));
+  size_t size = node::Buffer::Length(buffer);
+  if (has_thumbnail_options) {
+    // Like createThumbnailFromPath, the image is empty when the data can not
+    // be decoded at a reduced size or the rect is not inside of it.
+    SkBitmap thumbnail;
+    if (DecodeThumbnail(data, size, thumbnail_options, &thumbnail))
+      image_skia.AddRepresentation(gfx::ImageSkiaRep(thumbnail, scale_factor));
+  } else {
+    AddImageSkiaRep(&image_skia, data, size, width, height, scale_factor);
+  }
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateThumbnailFromPath(
+    mate::Arguments* args,
+    const base::FilePath& path) {
+  ThumbnailOptions thumbnail_options;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    GetThumbnailOptions(options, &thumbnail_options);
+
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadThumbnailFromPath, NormalizePath(path),
+                     thumbnail_options),
+      base::BindOnce(&ResolveWithImage, promise, false));
+  return promise->GetHandle();
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  scoped_refptr<util::Promise> promise = new util::Promise(isolate);
+  base::FilePath image_path = NormalizePath(path);
+#if defined(OS_WIN)
+  if (image_path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    promise->Resolve(CreateFromPath(isolate, image_path));
+    return promise->GetHandle();
+  }
+#endif
+  bool is_template = false;
+#if defined(OS_MACOSX)
+  is_template = IsTemplateFilename(image_path);
+#endif
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadImageSkiaRepsFromPath, image_path),
+      base::BindOnce(&ResolveWithImage, promise, is_template));
+  return promise->GetHandle();
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    mate::Arguments* args,
+    v8::Local<v8::Value> buffer) {
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  std::string data(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&DecodeImageSkiaReps, std::move(data), width, height,
+                     scale_factor),
+      base::BindOnce(&ResolveWithImage, promise, false));
+  return promise->GetHandle();
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathsAsync(
+    mate::Arguments* args,
+    const std::vector<base::FilePath>& paths) {
+  scoped_refptr<util::Promise> promise = new util::Promise(args->isolate());
+  ResizeOptions resize;
+  base::DictionaryValue options;
+  if (args->GetNext(&options))
+    resize = GetResizeOptions(options);
+
+  std::vector<base::FilePath> image_paths;
+  for (const auto& path : paths)
+    image_paths.push_back(NormalizePath(path));
+  scoped_refptr<ImageBatch> batch = new ImageBatch(promise, image_paths);
+  batch->Start(resize);
+  return promise->GetHandle();
+}
+
 // static
 mate::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
                                                          const GURL& url) {
@@ -555,7 +1102,9 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(mate::StringToV8(isolate, "NativeImage"));
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
@@ -565,6 +1114,7 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setTemplateImage", &NativeImage::SetTemplateImage)
       .SetMethod("isTemplateImage", &NativeImage::IsTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -607,6 +1157,30 @@ bool Converter<mate::Handle<atom::api::NativeImage>>::FromV8(
 
 namespace {
 
+v8::Local<v8::Value> GetCacheStats(v8::Isolate* isolate) {
+  atom::ImageCache::Stats stats = atom::ImageCache::GetInstance()->GetStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", static_cast<double>(stats.hits));
+  dict.Set("misses", static_cast<double>(stats.misses));
+  dict.Set("evictions", static_cast<double>(stats.evictions));
+  dict.Set("count", static_cast<double>(stats.count));
+  dict.Set("size", static_cast<double>(stats.size));
+  dict.Set("limit", static_cast<double>(stats.limit));
+  return dict.GetHandle();
+}
+
+void SetCacheLimit(mate::Arguments* args, double limit) {
+  if (limit < 0) {
+    args->ThrowError("limit must be non-negative");
+    return;
+  }
+  atom::ImageCache::GetInstance()->SetLimit(static_cast<size_t>(limit));
+}
+
+void ClearCache() {
+  atom::ImageCache::GetInstance()->Clear();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -614,11 +1188,22 @@ void Initialize(v8::Local<v8::Object> exports,
   mate::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("createEmpty", &atom::api::NativeImage::CreateEmpty);
   dict.SetMethod("createFromPath", &atom::api::NativeImage::CreateFromPath);
+  dict.SetMethod("createFromPathAsync",
+                 &atom::api::NativeImage::CreateFromPathAsync);
+  dict.SetMethod("createFromPathsAsync",
+                 &atom::api::NativeImage::CreateFromPathsAsync);
   dict.SetMethod("createFromBuffer", &atom::api::NativeImage::CreateFromBuffer);
+  dict.SetMethod("createFromBufferAsync",
+                 &atom::api::NativeImage::CreateFromBufferAsync);
+  dict.SetMethod("createThumbnailFromPath",
+                 &atom::api::NativeImage::CreateThumbnailFromPath);
   dict.SetMethod("createFromDataURL",
                  &atom::api::NativeImage::CreateFromDataURL);
   dict.SetMethod("createFromNamedImage",
                  &atom::api::NativeImage::CreateFromNamedImage);
+  dict.SetMethod("getCacheStats", &GetCacheStats);
+  dict.SetMethod("setCacheLimit", &SetCacheLimit);
+  dict.SetMethod("clearCache", &ClearCache);
 }
 
 }  // namespace
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/values.h"
 #include "native_mate/dictionary.h"
@@ -54,6 +55,19 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   static mate::Handle<NativeImage> CreateFromBuffer(
       mate::Arguments* args,
       v8::Local<v8::Value> buffer);
+  // Decode the images on the task scheduler.
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      mate::Arguments* args,
+      v8::Local<v8::Value> buffer);
+  static v8::Local<v8::Promise> CreateFromPathsAsync(
+      mate::Arguments* args,
+      const std::vector<base::FilePath>& paths);
+  static v8::Local<v8::Promise> CreateThumbnailFromPath(
+      mate::Arguments* args,
+      const base::FilePath& path);
   static mate::Handle<NativeImage> CreateFromDataURL(v8::Isolate* isolate,
                                                      const GURL& url);
   static mate::Handle<NativeImage> CreateFromNamedImage(
@@ -69,6 +83,19 @@ class NativeImage : public mate::Wrappable<NativeImage> {
 
   const gfx::Image& image() const { return image_; }
 
+  // Lets |producer| drop the image with Release() once the consumer hands it
+  // back, so that the producer can write to its pixels again.
+  void set_producer(const void* producer) { producer_ = producer; }
+  bool IsProducedBy(const void* producer) const {
+    return producer_ && producer_ == producer;
+  }
+  void Release();
+
+  // Mark the image as template image.
+  void SetTemplateImage(bool setAsTemplate);
+  // Determine if the image is a template image.
+  bool IsTemplateImage();
+
  protected:
   NativeImage(v8::Isolate* isolate, const gfx::Image& image);
 #if defined(OS_WIN)
@@ -78,13 +105,17 @@ class NativeImage : public mate::Wrappable<NativeImage> {
 
  private:
   v8::Local<v8::Value> ToPNG(mate::Arguments* args);
+  v8::Local<v8::Promise> ToPNGAsync(mate::Arguments* args);
   v8::Local<v8::Value> ToJPEG(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
   v8::Local<v8::Value> ToBitmap(mate::Arguments* args);
   v8::Local<v8::Value> GetBitmap(mate::Arguments* args);
   v8::Local<v8::Value> GetNativeHandle(v8::Isolate* isolate,
                                        mate::Arguments* args);
   mate::Handle<NativeImage> Resize(v8::Isolate* isolate,
                                    const base::DictionaryValue& options);
+  v8::Local<v8::Promise> ResizeAsync(v8::Isolate* isolate,
+                                     const base::DictionaryValue& options);
   mate::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(mate::Arguments* args);
   bool IsEmpty();
@@ -92,11 +123,6 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   float GetAspectRatio();
   void AddRepresentation(const mate::Dictionary& options);
 
-  // Mark the image as template image.
-  void SetTemplateImage(bool setAsTemplate);
-  // Determine if the image is a template image.
-  bool IsTemplateImage();
-
 #if defined(OS_WIN)
   base::FilePath hicon_path_;
   std::map<int, base::win::ScopedHICON> hicons_;
@@ -104,6 +130,8 @@ class NativeImage : public mate::Wrappable<NativeImage> {
 
   gfx::Image image_;
 
+  const void* producer_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(NativeImage);
 };
 
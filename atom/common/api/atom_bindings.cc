@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "atom/common/api/locker.h"
 #include "atom/common/atom_version.h"
@@ -15,6 +16,7 @@
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/node_includes.h"
+#include "atom/common/startup_timeline.h"
 #include "base/logging.h"
 #include "base/process/process_info.h"
 #include "base/process/process_metrics_iocounters.h"
@@ -60,6 +62,7 @@ void AtomBindings::BindTo(v8::Isolate* isolate, v8::Local<v8::Object> process) {
   dict.SetMethod("log", &Log);
   dict.SetMethod("getHeapStatistics", &GetHeapStatistics);
   dict.SetMethod("getCreationTime", &GetCreationTime);
+  dict.SetMethod("getStartupTimeline", &GetStartupTimeline);
   dict.SetMethod("getSystemMemoryInfo", &GetSystemMemoryInfo);
   dict.SetMethod("getCPUUsage", base::Bind(&AtomBindings::GetCPUUsage,
                                            base::Unretained(metrics_.get())));
@@ -178,6 +181,22 @@ v8::Local<v8::Value> AtomBindings::GetCreationTime(v8::Isolate* isolate) {
   return v8::Number::New(isolate, jsTime);
 }
 
+// static
+v8::Local<v8::Value> AtomBindings::GetStartupTimeline(v8::Isolate* isolate) {
+  std::vector<StartupTimeline::Mark> marks =
+      StartupTimeline::GetInstance()->GetMarks();
+  v8::Local<v8::Array> timeline = v8::Array::New(isolate, marks.size());
+  for (size_t i = 0; i < marks.size(); ++i) {
+    mate::Dictionary mark = mate::Dictionary::CreateEmpty(isolate);
+    mark.Set("name", marks[i].name);
+    mark.Set("time", marks[i].time.InMillisecondsF());
+    if (!marks[i].detail.empty())
+      mark.Set("detail", marks[i].detail);
+    timeline->Set(i, mark.GetHandle());
+  }
+  return timeline;
+}
+
 // static
 v8::Local<v8::Value> AtomBindings::GetSystemMemoryInfo(v8::Isolate* isolate,
                                                        mate::Arguments* args) {
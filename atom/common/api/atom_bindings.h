@@ -39,6 +39,7 @@ class AtomBindings {
   static void Hang();
   static v8::Local<v8::Value> GetHeapStatistics(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetCreationTime(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetStartupTimeline(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetSystemMemoryInfo(v8::Isolate* isolate,
                                                   mate::Arguments* args);
   static v8::Local<v8::Value> GetCPUUsage(base::ProcessMetrics* metrics,
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "atom/common/asar/scoped_temporary_file.h"
+#include "atom/common/startup_timeline.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
@@ -196,6 +197,7 @@ bool Archive::Init() {
 
   header_size_ = 8 + size;
   header_.reset(static_cast<base::DictionaryValue*>(value.release()));
+  StartupTimeline::GetInstance()->AddMark("asar-open", path_.AsUTF8Unsafe());
   return true;
 }
 
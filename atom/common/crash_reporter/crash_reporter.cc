@@ -93,6 +93,10 @@ std::map<std::string, std::string> CrashReporter::GetParameters() const {
   return upload_parameters_;
 }
 
+bool CrashReporter::DumpWithoutCrashing() {
+  return false;
+}
+
 #if defined(OS_MACOSX) && defined(MAS_BUILD)
 // static
 CrashReporter* CrashReporter::GetInstance() {
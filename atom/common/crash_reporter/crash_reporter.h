@@ -42,6 +42,10 @@ class CrashReporter {
   virtual void RemoveExtraParameter(const std::string& key);
   virtual std::map<std::string, std::string> GetParameters() const;
 
+  // Writes a minidump of the running process without crashing it, returns
+  // false when the crash reporter has not been started.
+  virtual bool DumpWithoutCrashing();
+
  protected:
   CrashReporter();
   virtual ~CrashReporter();
@@ -84,6 +84,10 @@ bool CrashReporterLinux::GetUploadToServer() {
   return upload_to_server_;
 }
 
+bool CrashReporterLinux::DumpWithoutCrashing() {
+  return breakpad_ && breakpad_->WriteMinidump();
+}
+
 void CrashReporterLinux::EnableCrashDumping(const base::FilePath& crashes_dir) {
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
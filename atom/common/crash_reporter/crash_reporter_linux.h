@@ -38,6 +38,7 @@ class CrashReporterLinux : public CrashReporter {
   void SetUploadToServer(bool upload_to_server) override;
   void SetUploadParameters() override;
   bool GetUploadToServer() override;
+  bool DumpWithoutCrashing() override;
 
  private:
   friend struct base::DefaultSingletonTraits<CrashReporterLinux>;
@@ -41,6 +41,7 @@ class CrashReporterMac : public CrashReporter {
                          const std::string& value) override;
   void RemoveExtraParameter(const std::string& key) override;
   std::map<std::string, std::string> GetParameters() const override;
+  bool DumpWithoutCrashing() override;
 
  private:
   friend struct base::DefaultSingletonTraits<CrashReporterMac>;
@@ -17,6 +17,7 @@
 #include "crashpad/client/crashpad_client.h"
 #include "crashpad/client/crashpad_info.h"
 #include "crashpad/client/settings.h"
+#include "crashpad/client/simulate_crash.h"
 
 namespace crash_reporter {
 
@@ -130,6 +131,14 @@ std::map<std::string, std::string> CrashReporterMac::GetParameters() const {
   return upload_parameters_;
 }
 
+bool CrashReporterMac::DumpWithoutCrashing() {
+  // Crashpad is only started by the crash reporter.
+  if (!simple_string_dictionary_)
+    return false;
+  CRASHPAD_SIMULATE_CRASH();
+  return true;
+}
+
 std::vector<CrashReporter::UploadReportResult>
 CrashReporterMac::GetUploadedReports(const base::FilePath& crashes_dir) {
   std::vector<CrashReporter::UploadReportResult> uploaded_reports;
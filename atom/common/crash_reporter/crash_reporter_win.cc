@@ -199,6 +199,10 @@ void CrashReporterWin::SetUploadParameters() {
   upload_parameters_["platform"] = "win32";
 }
 
+bool CrashReporterWin::DumpWithoutCrashing() {
+  return breakpad_ && breakpad_->WriteMinidump();
+}
+
 int CrashReporterWin::CrashForException(EXCEPTION_POINTERS* info) {
   if (breakpad_) {
     breakpad_->WriteMinidumpForException(info);
@@ -32,6 +32,7 @@ class CrashReporterWin : public CrashReporter {
                     bool upload_to_server,
                     bool skip_system_crash_handler) override;
   void SetUploadParameters() override;
+  bool DumpWithoutCrashing() override;
 
   // Crashes the process after generating a dump for the provided exception.
   int CrashForException(EXCEPTION_POINTERS* info);
@@ -0,0 +1,139 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/image_cache.h"
+
+#include <tuple>
+
+#include "atom/common/asar/asar_util.h"
+#include "base/files/file_util.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace atom {
+
+namespace {
+
+// Enough for the icons of an application at several scale factors.
+const size_t kDefaultLimit = 32 * 1024 * 1024;
+
+// Bounds the number of null representations, which have no pixel memory.
+const size_t kMaxEntries = 4096;
+
+size_t GetRepSize(const gfx::ImageSkiaRep& rep) {
+  return rep.is_null() ? 0 : rep.sk_bitmap().computeByteSize();
+}
+
+}  // namespace
+
+ImageCache::Key::Key() {}
+
+ImageCache::Key::Key(const Key& other) = default;
+
+ImageCache::Key::~Key() {}
+
+bool ImageCache::Key::operator<(const Key& other) const {
+  return std::tie(path, last_modified, size, scale) <
+         std::tie(other.path, other.last_modified, other.size, other.scale);
+}
+
+// static
+ImageCache* ImageCache::GetInstance() {
+  static base::NoDestructor<ImageCache> instance;
+  return instance.get();
+}
+
+// static
+bool ImageCache::GetKey(const base::FilePath& path, float scale, Key* key) {
+  base::FilePath file_path = path;
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path))
+    file_path = asar_path;
+
+  base::File::Info info;
+  if (!base::GetFileInfo(file_path, &info) || info.is_directory)
+    return false;
+
+  key->path = path;
+  key->last_modified = info.last_modified;
+  key->size = info.size;
+  key->scale = scale;
+  return true;
+}
+
+ImageCache::ImageCache() : entries_(decltype(entries_)::NO_AUTO_EVICT) {
+  stats_.limit = kDefaultLimit;
+}
+
+ImageCache::~ImageCache() {}
+
+bool ImageCache::Get(const Key& key, gfx::ImageSkiaRep* rep) {
+  base::AutoLock auto_lock(lock_);
+  auto it = entries_.Get(key);
+  if (it == entries_.end()) {
+    ++stats_.misses;
+    return false;
+  }
+  ++stats_.hits;
+  *rep = it->second;
+  return true;
+}
+
+gfx::ImageSkiaRep ImageCache::Put(const Key& key,
+                                  const gfx::ImageSkiaRep& rep) {
+  gfx::ImageSkiaRep shared = rep;
+  if (!rep.is_null()) {
+    // The pixels are shared by every image created from the entry.
+    SkBitmap bitmap = rep.sk_bitmap();
+    bitmap.setImmutable();
+    shared = gfx::ImageSkiaRep(bitmap, rep.scale());
+  }
+
+  base::AutoLock auto_lock(lock_);
+  size_t size = GetRepSize(shared);
+  if (stats_.limit == 0 || size > stats_.limit)
+    return shared;
+
+  auto it = entries_.Peek(key);
+  if (it != entries_.end()) {
+    stats_.size -= GetRepSize(it->second);
+    entries_.Erase(it);
+  }
+  entries_.Put(key, shared);
+  stats_.size += size;
+  ShrinkToLimit();
+  return shared;
+}
+
+void ImageCache::SetLimit(size_t limit) {
+  base::AutoLock auto_lock(lock_);
+  stats_.limit = limit;
+  ShrinkToLimit();
+}
+
+void ImageCache::Clear() {
+  base::AutoLock auto_lock(lock_);
+  entries_.Clear();
+  stats_.size = 0;
+}
+
+ImageCache::Stats ImageCache::GetStats() {
+  base::AutoLock auto_lock(lock_);
+  Stats stats = stats_;
+  stats.count = entries_.size();
+  return stats;
+}
+
+void ImageCache::ShrinkToLimit() {
+  lock_.AssertAcquired();
+  while (!entries_.empty() &&
+         (stats_.size > stats_.limit || entries_.size() > kMaxEntries ||
+          stats_.limit == 0)) {
+    auto it = entries_.rbegin();
+    stats_.size -= GetRepSize(it->second);
+    entries_.Erase(it);
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace atom
@@ -0,0 +1,92 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_IMAGE_CACHE_H_
+#define ATOM_COMMON_IMAGE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "ui/gfx/image/image_skia_rep.h"
+
+namespace atom {
+
+// Process-wide LRU cache of the representations decoded from image files.
+//
+// Entries are keyed by the path, the modification time and the size of the
+// file and by the scale factor, so a file that changed on disk is decoded
+// again. Cached bitmaps are immutable and shared by all images created from
+// them. Files that could not be decoded are cached as null representations.
+// The cache can be used from any thread.
+class ImageCache {
+ public:
+  struct Key {
+    Key();
+    Key(const Key& other);
+    ~Key();
+
+    bool operator<(const Key& other) const;
+
+    base::FilePath path;
+    base::Time last_modified;
+    int64_t size = 0;
+    float scale = 1.0f;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t count = 0;
+    // Bytes of pixel memory held by the cache.
+    size_t size = 0;
+    size_t limit = 0;
+  };
+
+  static ImageCache* GetInstance();
+
+  // Gets the key of the file at |path|, files in asar archives use the
+  // archive's modification time. Returns false when the file does not exist.
+  // Blocks on the file system.
+  static bool GetKey(const base::FilePath& path, float scale, Key* key);
+
+  // Returns true and sets |rep| when |key| is cached.
+  bool Get(const Key& key, gfx::ImageSkiaRep* rep);
+
+  // Caches |rep| for |key|, pass a null representation when the file could
+  // not be decoded. Returns the representation that should be used.
+  gfx::ImageSkiaRep Put(const Key& key, const gfx::ImageSkiaRep& rep);
+
+  // Limits the pixel memory held by the cache, 0 disables the cache.
+  void SetLimit(size_t limit);
+
+  void Clear();
+
+  Stats GetStats();
+
+ private:
+  friend class base::NoDestructor<ImageCache>;
+
+  ImageCache();
+  ~ImageCache();
+
+  // Evicts the least recently used entries until the cache fits in |limit_|.
+  void ShrinkToLimit();
+
+  base::Lock lock_;
+  base::MRUCache<Key, gfx::ImageSkiaRep> entries_;
+  Stats stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageCache);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_IMAGE_CACHE_H_
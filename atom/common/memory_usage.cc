@@ -0,0 +1,57 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/memory_usage.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace atom {
+
+std::unique_ptr<base::DictionaryValue> GetV8MemoryUsage(v8::Isolate* isolate) {
+  v8::HeapStatistics heap_stats;
+  isolate->GetHeapStatistics(&heap_stats);
+
+  auto usage = std::make_unique<base::DictionaryValue>();
+  usage->SetDouble("totalHeapSize",
+                   static_cast<double>(heap_stats.total_heap_size() >> 10));
+  usage->SetDouble("usedHeapSize",
+                   static_cast<double>(heap_stats.used_heap_size() >> 10));
+  usage->SetDouble("heapSizeLimit",
+                   static_cast<double>(heap_stats.heap_size_limit() >> 10));
+  usage->SetDouble("mallocedMemory",
+                   static_cast<double>(heap_stats.malloced_memory() >> 10));
+
+  // Adjusting by 0 returns what V8 has been told about, which includes the
+  // backing stores of ArrayBuffers and the memory of node's Buffers.
+  int64_t external_memory =
+      std::max<int64_t>(isolate->AdjustAmountOfExternalAllocatedMemory(0), 0);
+  usage->SetDouble("externalMemory",
+                   static_cast<double>(external_memory >> 10));
+
+  auto spaces = std::make_unique<base::DictionaryValue>();
+  for (size_t i = 0; i < isolate->NumberOfHeapSpaces(); ++i) {
+    v8::HeapSpaceStatistics space_stats;
+    if (!isolate->GetHeapSpaceStatistics(&space_stats, i))
+      continue;
+    auto space = std::make_unique<base::DictionaryValue>();
+    space->SetDouble("size",
+                     static_cast<double>(space_stats.space_size() >> 10));
+    space->SetDouble("usedSize",
+                     static_cast<double>(space_stats.space_used_size() >> 10));
+    space->SetDouble(
+        "availableSize",
+        static_cast<double>(space_stats.space_available_size() >> 10));
+    space->SetDouble(
+        "physicalSize",
+        static_cast<double>(space_stats.physical_space_size() >> 10));
+    spaces->SetWithoutPathExpansion(space_stats.space_name(),
+                                    std::move(space));
+  }
+  usage->Set("spaces", std::move(spaces));
+
+  return usage;
+}
+
+}  // namespace atom
@@ -0,0 +1,22 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_MEMORY_USAGE_H_
+#define ATOM_COMMON_MEMORY_USAGE_H_
+
+#include <memory>
+
+#include "base/values.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Returns the heap statistics of |isolate| and of each of its heap spaces,
+// along with the memory held outside of the heap by ArrayBuffers and node
+// Buffers. All sizes are in kilobytes.
+std::unique_ptr<base::DictionaryValue> GetV8MemoryUsage(v8::Isolate* isolate);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_MEMORY_USAGE_H_
@@ -203,6 +203,32 @@ bool Converter<net::HttpResponseHeaders*>::FromV8(
   return true;
 }
 
+// static
+v8::Local<v8::Value> Converter<net::RequestPriority>::ToV8(
+    v8::Isolate* isolate,
+    net::RequestPriority val) {
+  return StringToV8(isolate,
+                    base::ToLowerASCII(net::RequestPriorityToString(val)));
+}
+
+// static
+bool Converter<net::RequestPriority>::FromV8(v8::Isolate* isolate,
+                                             v8::Local<v8::Value> val,
+                                             net::RequestPriority* out) {
+  std::string priority;
+  if (!ConvertFromV8(isolate, val, &priority))
+    return false;
+  for (int i = net::MINIMUM_PRIORITY; i <= net::MAXIMUM_PRIORITY; ++i) {
+    auto value = static_cast<net::RequestPriority>(i);
+    if (base::EqualsCaseInsensitiveASCII(priority,
+                                         net::RequestPriorityToString(value))) {
+      *out = value;
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace mate
 
 namespace atom {
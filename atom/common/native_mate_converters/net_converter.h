@@ -7,6 +7,7 @@
 
 #include "base/memory/ref_counted.h"
 #include "native_mate/converter.h"
+#include "net/base/request_priority.h"
 
 namespace base {
 class DictionaryValue;
@@ -55,6 +56,15 @@ struct Converter<net::HttpResponseHeaders*> {
                      net::HttpResponseHeaders* out);
 };
 
+template <>
+struct Converter<net::RequestPriority> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   net::RequestPriority val);
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     net::RequestPriority* out);
+};
+
 }  // namespace mate
 
 namespace atom {
@@ -14,18 +14,23 @@
 #include "atom/common/api/locker.h"
 #include "atom/common/atom_command_line.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/startup_timeline.h"
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/environment.h"
+#include "base/lazy_instance.h"
+#include "base/observer_list.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/thread_local.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/content_paths.h"
 #include "electron/buildflags/buildflags.h"
+#include "gin/public/v8_platform.h"
 #include "native_mate/dictionary.h"
 
 #include "atom/common/node_includes.h"
@@ -51,6 +56,7 @@
   V(atom_browser_system_preferences)         \
   V(atom_browser_top_level_window)           \
   V(atom_browser_tray)                       \
+  V(atom_browser_utility_process)            \
   V(atom_browser_web_contents)               \
   V(atom_browser_web_contents_view)          \
   V(atom_browser_view)                       \
@@ -152,6 +158,36 @@ base::FilePath GetResourcesPath(bool is_browser) {
   return resources_path;
 }
 
+// V8's background tasks are run by gin in the renderer process, so Node's
+// own thread pool is barely used there.
+const int kRendererPlatformThreads = 1;
+
+// Node's platform for the renderer process. gin's V8Platform drives V8 there
+// and does not know the isolates Node creates for worker_threads, so it
+// forwards their foreground tasks to this one.
+struct RendererPlatform {
+  RendererPlatform() {
+    gin::V8Platform* gin_platform = gin::V8Platform::Get();
+    platform = node::CreatePlatform(kRendererPlatformThreads,
+                                    gin_platform->GetTracingController());
+    gin_platform->SetEmbedderPlatform(platform);
+  }
+
+  node::MultiIsolatePlatform* platform;
+};
+
+// Shared by the main thread and the web workers.
+base::LazyInstance<RendererPlatform>::Leaky g_renderer_platform =
+    LAZY_INSTANCE_INITIALIZER;
+
+using UvWorkObserverList = base::ObserverList<NodeBindings::UvWorkObserver>;
+
+// The observers of the libuv work of each thread. A list is kept once the
+// thread had an observer, removing observers from inside a notification
+// would otherwise delete the list being iterated.
+base::LazyInstance<base::ThreadLocalPointer<UvWorkObserverList>>::Leaky
+    g_uv_work_observers = LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 NodeBindings::NodeBindings(BrowserEnvironment browser_env)
@@ -165,16 +201,19 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
-  WakeupEmbedThread();
+  if (use_embed_thread_) {
+    // Quit the embed thread.
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
+
+    uv_sem_destroy(&embed_sem_);
+  }
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   uv_close(reinterpret_cast<uv_handle_t*>(&dummy_uv_handle_), nullptr);
 
   // Clean up worker loop
@@ -182,6 +221,39 @@ NodeBindings::~NodeBindings() {
     stop_and_close_uv_loop(uv_loop_);
 }
 
+// static
+void NodeBindings::AddUvWorkObserver(UvWorkObserver* observer) {
+  UvWorkObserverList* observers = g_uv_work_observers.Get().Get();
+  if (!observers) {
+    observers = new UvWorkObserverList;
+    g_uv_work_observers.Get().Set(observers);
+  }
+  observers->AddObserver(observer);
+}
+
+// static
+void NodeBindings::RemoveUvWorkObserver(UvWorkObserver* observer) {
+  UvWorkObserverList* observers = g_uv_work_observers.Get().Get();
+  if (observers)
+    observers->RemoveObserver(observer);
+}
+
+NodeBindings::ScopedUvWork::ScopedUvWork() {
+  UvWorkObserverList* observers = g_uv_work_observers.Get().Get();
+  if (observers) {
+    for (auto& observer : *observers)
+      observer.WillRunUvWork();
+  }
+}
+
+NodeBindings::ScopedUvWork::~ScopedUvWork() {
+  UvWorkObserverList* observers = g_uv_work_observers.Get().Get();
+  if (observers) {
+    for (auto& observer : *observers)
+      observer.DidRunUvWork();
+  }
+}
+
 void NodeBindings::RegisterBuiltinModules() {
 #define V(modname) _register_##modname();
   ELECTRON_BUILTIN_MODULES(V)
@@ -217,11 +289,12 @@ void NodeBindings::Initialize() {
   RegisterBuiltinModules();
 
   // pass non-null program name to argv so it doesn't crash
-  // trying to index into a nullptr
-  int argc = 1;
+  // trying to index into a nullptr, worker_threads is still behind a flag in
+  // this version of Node.
+  const char* args[] = {"electron", "--experimental-worker"};
+  int argc = arraysize(args);
   int exec_argc = 0;
-  const char* prog_name = "electron";
-  const char** argv = &prog_name;
+  const char** argv = args;
   const char** exec_argv = nullptr;
 
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -314,6 +387,9 @@ node::Environment* NodeBindings::CreateEnvironment(
     case WORKER:
       process_type = FILE_PATH_LITERAL("worker");
       break;
+    case UTILITY:
+      process_type = FILE_PATH_LITERAL("utility");
+      break;
   }
   base::FilePath resources_path = GetResourcesPath(browser_env_ == BROWSER);
   base::FilePath script_path =
@@ -322,6 +398,10 @@ node::Environment* NodeBindings::CreateEnvironment(
           .Append(FILE_PATH_LITERAL("init.js"));
   args.insert(args.begin() + 1, script_path.AsUTF8Unsafe());
 
+  // Workers need a platform to register their isolates with.
+  if (!platform && (browser_env_ == RENDERER || browser_env_ == WORKER))
+    platform = g_renderer_platform.Get().platform;
+
   std::unique_ptr<const char* []> c_argv = StringVectorToArgArray(args);
   node::Environment* env = node::CreateEnvironment(
       node::CreateIsolateData(context->GetIsolate(), uv_loop_, platform),
@@ -352,7 +432,10 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  // In the browser process this includes running the app's main script.
+  StartupTimeline::GetInstance()->AddMark("load-environment");
   node::LoadEnvironment(env);
+  StartupTimeline::GetInstance()->AddMark("environment-loaded");
   mate::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
 
@@ -361,6 +444,9 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  if (!use_embed_thread_)
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -383,6 +469,8 @@ void NodeBindings::UvRunOnce() {
   if (!env)
     return;
 
+  ScopedUvWork scoped_uv_work;
+
   // Use Locker in browser process.
   mate::Locker locker(env->isolate());
   v8::HandleScope handle_scope(env->isolate());
@@ -407,7 +495,8 @@ void NodeBindings::UvRunOnce() {
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
   // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  if (use_embed_thread_)
+    uv_sem_post(&embed_sem_);
 }
 
 void NodeBindings::WakeupMainThread() {
@@ -29,8 +29,25 @@ class NodeBindings {
     BROWSER,
     RENDERER,
     WORKER,
+    UTILITY,
   };
 
+  // Observes the libuv work run on a thread. It is not always wrapped in a
+  // task, the browser process's glib loop dispatches it directly on Linux, so
+  // task observers alone miss it.
+  class UvWorkObserver {
+   public:
+    virtual void WillRunUvWork() = 0;
+    virtual void DidRunUvWork() = 0;
+
+   protected:
+    virtual ~UvWorkObserver() {}
+  };
+
+  // Adds or removes an observer of the libuv work of the calling thread.
+  static void AddUvWorkObserver(UvWorkObserver* observer);
+  static void RemoveUvWorkObserver(UvWorkObserver* observer);
+
   static NodeBindings* Create(BrowserEnvironment browser_env);
   static void RegisterBuiltinModules();
   static bool IsInitialized();
@@ -67,6 +84,16 @@ class NodeBindings {
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
+  // Notifies the observers of the calling thread while libuv work runs.
+  class ScopedUvWork {
+   public:
+    ScopedUvWork();
+    ~ScopedUvWork();
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(ScopedUvWork);
+  };
+
   // Run the libuv loop for once.
   void UvRunOnce();
 
@@ -85,6 +112,11 @@ class NodeBindings {
   // Current thread's libuv loop.
   uv_loop_t* uv_loop_;
 
+  // Whether uv events are polled on the embed thread. Derived classes that
+  // watch uv's backend fd on the main thread clear it before the message
+  // loop is prepared.
+  bool use_embed_thread_ = true;
+
  private:
   // Thread to poll uv events.
   static void EmbedThreadRunner(void* arg);
@@ -6,8 +6,46 @@
 
 #include <sys/epoll.h>
 
+#include "base/bind.h"
+#include "base/message_loop/message_loop_current.h"
+#include "base/trace_event/trace_event.h"
+
+#if defined(USE_GLIB)
+#include <glib.h>
+#endif
+
 namespace atom {
 
+namespace {
+
+#if defined(USE_GLIB)
+struct UvSource {
+  GSource source;
+  GPollFD poll_fd;
+};
+
+gboolean UvSourcePrepare(GSource* source, gint* timeout) {
+  // The uv timers are run as delayed tasks.
+  *timeout = -1;
+  return FALSE;
+}
+
+gboolean UvSourceCheck(GSource* source) {
+  return reinterpret_cast<UvSource*>(source)->poll_fd.revents & G_IO_IN;
+}
+
+gboolean UvSourceDispatch(GSource* source,
+                          GSourceFunc callback,
+                          gpointer user_data) {
+  return callback(user_data);
+}
+
+GSourceFuncs g_uv_source_funcs = {UvSourcePrepare, UvSourceCheck,
+                                  UvSourceDispatch, nullptr};
+#endif
+
+}  // namespace
+
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
     : NodeBindings(browser_env), epoll_(epoll_create(1)) {
   int backend_fd = uv_backend_fd(uv_loop_);
@@ -15,9 +53,24 @@ NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
   ev.events = EPOLLIN;
   ev.data.fd = backend_fd;
   epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
+
+#if defined(USE_GLIB)
+  // Only the browser process runs a glib loop on its main thread.
+  if (browser_env == BROWSER)
+    use_embed_thread_ = false;
+#endif
 }
 
-NodeBindingsLinux::~NodeBindingsLinux() {}
+NodeBindingsLinux::~NodeBindingsLinux() {
+#if defined(USE_GLIB)
+  if (uv_source_) {
+    if (base::MessageLoopCurrent::IsSet())
+      base::MessageLoopCurrent::Get()->RemoveTaskObserver(this);
+    g_source_destroy(uv_source_);
+    g_source_unref(uv_source_);
+  }
+#endif
+}
 
 void NodeBindingsLinux::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
@@ -25,6 +78,32 @@ void NodeBindingsLinux::RunMessageLoop() {
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
   NodeBindings::RunMessageLoop();
+
+#if defined(USE_GLIB)
+  if (!use_embed_thread_) {
+    uv_source_ = g_source_new(&g_uv_source_funcs, sizeof(UvSource));
+    UvSource* source = reinterpret_cast<UvSource*>(uv_source_);
+    source->poll_fd.fd = uv_backend_fd(uv_loop_);
+    source->poll_fd.events = G_IO_IN;
+    source->poll_fd.revents = 0;
+    g_source_add_poll(uv_source_, &source->poll_fd);
+    g_source_set_callback(uv_source_, &NodeBindingsLinux::OnBackendFdReadable,
+                          this, nullptr);
+    g_source_set_can_recurse(uv_source_, FALSE);
+    g_source_attach(uv_source_, g_main_context_default());
+
+    // JavaScript run by other tasks may start uv timers.
+    base::MessageLoopCurrent::Get()->AddTaskObserver(this);
+    ScheduleUvTimer(true);
+  }
+#endif
+}
+
+void NodeBindingsLinux::WillProcessTask(
+    const base::PendingTask& pending_task) {}
+
+void NodeBindingsLinux::DidProcessTask(const base::PendingTask& pending_task) {
+  ScheduleUvTimer(false);
 }
 
 // static
@@ -32,10 +111,20 @@ void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
   // We need to break the io polling in the epoll thread when loop's watcher
-  // queue changes, otherwise new events cannot be notified.
+  // queue changes, otherwise new events cannot be notified. Without the
+  // embed thread this makes the backend fd readable, so the main thread runs
+  // the loop and adds the new watchers to it.
   self->WakeupEmbedThread();
 }
 
+// static
+int NodeBindingsLinux::OnBackendFdReadable(void* data) {
+  // Not a task, observers of the main thread only see it as libuv work.
+  ScopedUvWork scoped_uv_work;
+  static_cast<NodeBindingsLinux*>(data)->RunUvLoop();
+  return TRUE;
+}
+
 void NodeBindingsLinux::PollEvents() {
   int timeout = uv_backend_timeout(uv_loop_);
 
@@ -47,6 +136,29 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+void NodeBindingsLinux::RunUvLoop() {
+  TRACE_EVENT0("electron", "NodeBindingsLinux::RunUvLoop");
+  UvRunOnce();
+  ScheduleUvTimer(true);
+}
+
+void NodeBindingsLinux::ScheduleUvTimer(bool reschedule) {
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout < 0) {
+    if (reschedule)
+      uv_timer_.Stop();
+    return;
+  }
+
+  base::TimeDelta delay = base::TimeDelta::FromMilliseconds(timeout);
+  if (!reschedule && uv_timer_.IsRunning() &&
+      uv_timer_.desired_run_time() <= base::TimeTicks::Now() + delay)
+    return;
+  uv_timer_.Start(
+      FROM_HERE, delay,
+      base::Bind(&NodeBindingsLinux::RunUvLoop, base::Unretained(this)));
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
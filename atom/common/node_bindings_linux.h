@@ -7,25 +7,59 @@
 
 #include "atom/common/node_bindings.h"
 #include "base/compiler_specific.h"
+#include "base/message_loop/message_loop.h"
+#include "base/timer/timer.h"
+
+#if defined(USE_GLIB)
+typedef struct _GSource GSource;
+#endif
 
 namespace atom {
 
-class NodeBindingsLinux : public NodeBindings {
+// In the browser process the uv backend fd is watched by the main thread's
+// glib loop and uv timers are run as delayed tasks, so libuv events are
+// dispatched without going through the embed thread. Other processes do not
+// run a glib loop on their main thread and keep polling on the embed thread.
+class NodeBindingsLinux : public NodeBindings,
+                          public base::MessageLoop::TaskObserver {
  public:
   explicit NodeBindingsLinux(BrowserEnvironment browser_env);
   ~NodeBindingsLinux() override;
 
   void RunMessageLoop() override;
 
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
  private:
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
+  // Called by the glib loop when uv's backend fd is readable, the signature
+  // is the one of GSourceFunc.
+  static int OnBackendFdReadable(void* data);
+
   void PollEvents() override;
 
+  // Runs the uv loop on the main thread and schedules the next uv timer.
+  void RunUvLoop();
+
+  // Makes sure the uv loop runs before its next timer is due, the pending
+  // run is moved when |reschedule| is true and only moved earlier otherwise.
+  void ScheduleUvTimer(bool reschedule);
+
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+#if defined(USE_GLIB)
+  // Watches uv's backend fd in the main thread's glib loop.
+  GSource* uv_source_ = nullptr;
+#endif
+
+  // Runs the uv loop when its next timer is due.
+  base::OneShotTimer uv_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
 
@@ -0,0 +1,142 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/node_message_serializer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <utility>
+
+#include "base/containers/span.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "native_mate/arguments.h"
+#include "native_mate/converter.h"
+
+namespace atom {
+
+namespace {
+
+class SerializerDelegate : public v8::ValueSerializer::Delegate {
+ public:
+  explicit SerializerDelegate(v8::Isolate* isolate) : isolate_(isolate) {}
+
+  // v8::ValueSerializer::Delegate:
+  void ThrowDataCloneError(v8::Local<v8::String> message) override {
+    isolate_->ThrowException(v8::Exception::Error(message));
+  }
+
+ private:
+  v8::Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializerDelegate);
+};
+
+void ThrowDataCloneError(v8::Isolate* isolate, const char* message) {
+  isolate->ThrowException(
+      v8::Exception::Error(mate::StringToV8(isolate, message)));
+}
+
+}  // namespace
+
+mojom::NodeMessagePtr SerializeNodeMessage(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer) {
+  for (size_t i = 0; i < transfer.size(); ++i) {
+    if (!transfer[i]->IsNeuterable()) {
+      ThrowDataCloneError(isolate, "An ArrayBuffer could not be transferred");
+      return nullptr;
+    }
+    for (size_t j = 0; j < i; ++j) {
+      if (transfer[i] == transfer[j]) {
+        ThrowDataCloneError(
+            isolate, "An ArrayBuffer is duplicated in the transfer list");
+        return nullptr;
+      }
+    }
+  }
+
+  SerializerDelegate delegate(isolate);
+  v8::ValueSerializer serializer(isolate, &delegate);
+  serializer.WriteHeader();
+  for (size_t i = 0; i < transfer.size(); ++i)
+    serializer.TransferArrayBuffer(i, transfer[i]);
+  bool wrote;
+  if (!serializer.WriteValue(isolate->GetCurrentContext(), value).To(&wrote))
+    return nullptr;
+
+  auto message = mojom::NodeMessage::New();
+  std::pair<uint8_t*, size_t> buffer = serializer.Release();
+  message->encoded_message =
+      mojo_base::BigBuffer(base::make_span(buffer.first, buffer.second));
+  free(buffer.first);
+
+  for (const auto& array_buffer : transfer) {
+    // Buffers that are already external belong to someone else and are only
+    // neutered, the others are owned by us once externalized.
+    bool owned = !array_buffer->IsExternal();
+    v8::ArrayBuffer::Contents contents = owned ? array_buffer->Externalize()
+                                               : array_buffer->GetContents();
+    message->array_buffers.emplace_back(
+        base::make_span(static_cast<const uint8_t*>(contents.Data()),
+                        contents.ByteLength()));
+    array_buffer->Neuter();
+    if (owned) {
+      isolate->GetArrayBufferAllocator()->Free(contents.Data(),
+                                               contents.ByteLength());
+    }
+  }
+  return message;
+}
+
+mojom::NodeMessagePtr SerializeNodeMessage(mate::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value)) {
+    args->ThrowError("Missing message");
+    return nullptr;
+  }
+
+  std::vector<v8::Local<v8::ArrayBuffer>> transfer;
+  v8::Local<v8::Value> transfer_list;
+  if (args->GetNext(&transfer_list) && !transfer_list->IsUndefined()) {
+    std::vector<v8::Local<v8::Value>> items;
+    if (!mate::ConvertFromV8(args->isolate(), transfer_list, &items)) {
+      args->ThrowError("transfer must be an array");
+      return nullptr;
+    }
+    for (const auto& item : items) {
+      if (!item->IsArrayBuffer()) {
+        args->ThrowError("transfer must only contain ArrayBuffers");
+        return nullptr;
+      }
+      transfer.push_back(item.As<v8::ArrayBuffer>());
+    }
+  }
+  return SerializeNodeMessage(args->isolate(), value, transfer);
+}
+
+v8::MaybeLocal<v8::Value> DeserializeNodeMessage(
+    v8::Isolate* isolate,
+    const mojom::NodeMessage& message) {
+  v8::ValueDeserializer deserializer(isolate,
+                                     message.encoded_message.data(),
+                                     message.encoded_message.size());
+  for (size_t i = 0; i < message.array_buffers.size(); ++i) {
+    const mojo_base::BigBuffer& contents = message.array_buffers[i];
+    v8::Local<v8::ArrayBuffer> array_buffer =
+        v8::ArrayBuffer::New(isolate, contents.size());
+    memcpy(array_buffer->GetContents().Data(), contents.data(),
+           contents.size());
+    deserializer.TransferArrayBuffer(i, array_buffer);
+  }
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  bool read;
+  if (!deserializer.ReadHeader(context).To(&read))
+    return v8::MaybeLocal<v8::Value>();
+  return deserializer.ReadValue(context);
+}
+
+}  // namespace atom
@@ -0,0 +1,39 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_NODE_MESSAGE_SERIALIZER_H_
+#define ATOM_COMMON_NODE_MESSAGE_SERIALIZER_H_
+
+#include <vector>
+
+#include "atom/common/node_service.mojom.h"
+#include "v8/include/v8.h"
+
+namespace mate {
+class Arguments;
+}
+
+namespace atom {
+
+// Serializes |value| with the structured clone algorithm. The contents of
+// the ArrayBuffers in |transfer| are moved into the message and the buffers
+// are neutered, like with postMessage. Throws a JavaScript exception and
+// returns nullptr when the value can not be serialized.
+mojom::NodeMessagePtr SerializeNodeMessage(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer);
+
+// Reads the value and the optional array of ArrayBuffers to transfer from
+// the arguments of a postMessage call and serializes them.
+mojom::NodeMessagePtr SerializeNodeMessage(mate::Arguments* args);
+
+// Deserializes |message| in the current context.
+v8::MaybeLocal<v8::Value> DeserializeNodeMessage(
+    v8::Isolate* isolate,
+    const mojom::NodeMessage& message);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_NODE_MESSAGE_SERIALIZER_H_
@@ -148,6 +148,9 @@ const char kPlugins[] = "plugins";
 
 const char kSandbox[] = "sandbox";
 
+// Run the sampling profiler in the renderer process.
+const char kSamplingProfiler[] = "samplingProfiler";
+
 const char kWebSecurity[] = "webSecurity";
 
 const char kAllowRunningInsecureContent[] = "allowRunningInsecureContent";
@@ -208,6 +211,9 @@ const char kWebviewTag[] = "webview-tag";
 // Command switch passed to renderer process to control nodeIntegration.
 const char kNodeIntegrationInWorker[] = "node-integration-in-worker";
 
+// Passed to renderer processes launched ahead of their window.
+const char kSpareRenderer[] = "spare-renderer";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
@@ -227,6 +233,20 @@ const char kAuthServerWhitelist[] = "auth-server-whitelist";
 const char kAuthNegotiateDelegateWhitelist[] =
     "auth-negotiate-delegate-whitelist";
 
+// Writes the startup timeline of the browser process to the path, in the
+// trace event format.
+const char kStartupTimelineFile[] = "startup-timeline-file";
+
+// Keeps a sampling profiler running and writes its last samples to the
+// directory after a long task.
+const char kSamplingProfilerDir[] = "sampling-profiler-dir";
+// Microseconds between two samples of the sampling profiler.
+const char kSamplingProfilerInterval[] = "sampling-profiler-interval";
+// Seconds of samples written by the sampling profiler.
+const char kSamplingProfilerWindow[] = "sampling-profiler-window";
+// Milliseconds a task has to take for the sampling profiler to write them.
+const char kSamplingProfilerThreshold[] = "sampling-profiler-threshold";
+
 }  // namespace switches
 
 }  // namespace atom
@@ -72,6 +72,7 @@ extern const char kNativeWindowOpen[];
 extern const char kCustomArgs[];
 extern const char kPlugins[];
 extern const char kSandbox[];
+extern const char kSamplingProfiler[];
 extern const char kWebSecurity[];
 extern const char kAllowRunningInsecureContent[];
 extern const char kOffscreen[];
@@ -107,6 +108,7 @@ extern const char kHiddenPage[];
 extern const char kNativeWindowOpen[];
 extern const char kNodeIntegrationInWorker[];
 extern const char kWebviewTag[];
+extern const char kSpareRenderer[];
 
 extern const char kWidevineCdmPath[];
 extern const char kWidevineCdmVersion[];
@@ -116,6 +118,13 @@ extern const char kIgnoreConnectionsLimit[];
 extern const char kAuthServerWhitelist[];
 extern const char kAuthNegotiateDelegateWhitelist[];
 
+extern const char kStartupTimelineFile[];
+
+extern const char kSamplingProfilerDir[];
+extern const char kSamplingProfilerInterval[];
+extern const char kSamplingProfilerWindow[];
+extern const char kSamplingProfilerThreshold[];
+
 }  // namespace switches
 
 }  // namespace atom
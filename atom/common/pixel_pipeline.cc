@@ -0,0 +1,341 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/pixel_pipeline.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#define PIXEL_PIPELINE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PIXEL_PIPELINE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace atom {
+
+namespace {
+
+// Factors that scale a color channel premultiplied with the alpha at the
+// index back to the full range. The vector paths compute the same factors
+// with a division, so all paths produce the same pixels.
+struct UnpremultiplyTable {
+  UnpremultiplyTable() {
+    factors[0] = 0;
+    for (int alpha = 1; alpha < 256; ++alpha)
+      factors[alpha] = 255.0f / alpha;
+  }
+
+  float factors[256];
+};
+
+const UnpremultiplyTable& GetUnpremultiplyTable() {
+  static const UnpremultiplyTable table;
+  return table;
+}
+
+PixelFormat GetPixelFormat(SkColorType color_type) {
+  return color_type == kRGBA_8888_SkColorType ? PixelFormat::RGBA
+                                              : PixelFormat::BGRA;
+}
+
+inline uint32_t UnpremultiplyChannel(uint32_t channel, float factor) {
+  return static_cast<uint32_t>(std::min(channel * factor + 0.5f, 255.0f));
+}
+
+// Pixels are handled as little endian words, the alpha is in the top byte
+// and the red and blue channels are in the bytes 0 and 2.
+inline uint32_t ConvertPixel(uint32_t pixel,
+                             bool swap_rb,
+                             bool unpremultiply) {
+  if (unpremultiply) {
+    uint32_t alpha = pixel >> 24;
+    if (alpha != 255) {
+      float factor = GetUnpremultiplyTable().factors[alpha];
+      uint32_t c0 = UnpremultiplyChannel(pixel & 0xFF, factor);
+      uint32_t c1 = UnpremultiplyChannel((pixel >> 8) & 0xFF, factor);
+      uint32_t c2 = UnpremultiplyChannel((pixel >> 16) & 0xFF, factor);
+      pixel = (alpha << 24) | (c2 << 16) | (c1 << 8) | c0;
+    }
+  }
+  if (swap_rb) {
+    pixel = (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) |
+            ((pixel & 0xFF) << 16);
+  }
+  return pixel;
+}
+
+#if defined(PIXEL_PIPELINE_SSE2)
+// Unpremultiplies 4 pixels in single precision floats.
+inline __m128i UnpremultiplySSE2(__m128i pixels) {
+  const __m128i byte_mask = _mm_set1_epi32(0xFF);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 max = _mm_set1_ps(255.0f);
+  __m128i alpha = _mm_srli_epi32(pixels, 24);
+  __m128 alpha_f = _mm_cvtepi32_ps(alpha);
+  // Transparent pixels get a factor of 0 instead of infinity.
+  __m128 factor = _mm_and_ps(_mm_div_ps(max, alpha_f),
+                             _mm_cmpneq_ps(alpha_f, _mm_setzero_ps()));
+  __m128i result = _mm_slli_epi32(alpha, 24);
+  for (int shift = 0; shift < 24; shift += 8) {
+    __m128i count = _mm_cvtsi32_si128(shift);
+    __m128 channel = _mm_cvtepi32_ps(
+        _mm_and_si128(_mm_srl_epi32(pixels, count), byte_mask));
+    channel = _mm_min_ps(_mm_add_ps(_mm_mul_ps(channel, factor), half), max);
+    result =
+        _mm_or_si128(result, _mm_sll_epi32(_mm_cvttps_epi32(channel), count));
+  }
+  return result;
+}
+#elif defined(PIXEL_PIPELINE_NEON)
+inline float32x4_t UnpremultiplyFactorNEON(uint32x4_t alpha) {
+  const float32x4_t max = vdupq_n_f32(255.0f);
+  float32x4_t alpha_f = vcvtq_f32_u32(alpha);
+#if defined(__aarch64__)
+  float32x4_t factor = vdivq_f32(max, alpha_f);
+#else
+  // ARMv7 has no vector division, refine the reciprocal estimate instead.
+  float32x4_t reciprocal = vrecpeq_f32(alpha_f);
+  reciprocal = vmulq_f32(vrecpsq_f32(alpha_f, reciprocal), reciprocal);
+  reciprocal = vmulq_f32(vrecpsq_f32(alpha_f, reciprocal), reciprocal);
+  float32x4_t factor = vmulq_f32(max, reciprocal);
+#endif
+  // Transparent pixels get a factor of 0 instead of infinity.
+  return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(factor),
+                                         vcgtq_u32(alpha, vdupq_n_u32(0))));
+}
+
+// Splits 16 channel bytes into 4 vectors of 4 words.
+inline void WidenNEON(uint8x16_t bytes, uint32x4_t words[4]) {
+  uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+  uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+  words[0] = vmovl_u16(vget_low_u16(low));
+  words[1] = vmovl_u16(vget_high_u16(low));
+  words[2] = vmovl_u16(vget_low_u16(high));
+  words[3] = vmovl_u16(vget_high_u16(high));
+}
+
+// Unpremultiplies the deinterleaved channels of 16 pixels.
+inline void UnpremultiplyNEON(uint8x16x4_t* pixels) {
+  const float32x4_t half = vdupq_n_f32(0.5f);
+  const float32x4_t max = vdupq_n_f32(255.0f);
+  uint32x4_t alpha[4];
+  WidenNEON(pixels->val[3], alpha);
+  float32x4_t factors[4];
+  for (int i = 0; i < 4; ++i)
+    factors[i] = UnpremultiplyFactorNEON(alpha[i]);
+
+  for (int channel = 0; channel < 3; ++channel) {
+    uint32x4_t words[4];
+    WidenNEON(pixels->val[channel], words);
+    for (int i = 0; i < 4; ++i) {
+      float32x4_t value = vcvtq_f32_u32(words[i]);
+      value = vminq_f32(vaddq_f32(vmulq_f32(value, factors[i]), half), max);
+      words[i] = vcvtq_u32_f32(value);
+    }
+    uint16x8_t low = vcombine_u16(vmovn_u32(words[0]), vmovn_u32(words[1]));
+    uint16x8_t high = vcombine_u16(vmovn_u32(words[2]), vmovn_u32(words[3]));
+    pixels->val[channel] = vcombine_u8(vmovn_u16(low), vmovn_u16(high));
+  }
+}
+#endif
+
+// Converts |count| pixels from |source| to |target|, which may be the same
+// row. Blocks that are fully opaque skip the unpremultiplication.
+void ConvertRow(const uint32_t* source,
+                uint32_t* target,
+                int count,
+                bool swap_rb,
+                bool unpremultiply) {
+  int i = 0;
+#if defined(PIXEL_PIPELINE_SSE2)
+  const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+  const __m128i ag_mask = _mm_set1_epi32(0xFF00FF00);
+  const __m128i rb_mask = _mm_set1_epi32(0x00FF00FF);
+  for (; i + 4 <= count; i += 4) {
+    __m128i pixels =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    if (unpremultiply) {
+      __m128i opaque =
+          _mm_cmpeq_epi32(_mm_and_si128(pixels, alpha_mask), alpha_mask);
+      if (_mm_movemask_epi8(opaque) != 0xFFFF)
+        pixels = UnpremultiplySSE2(pixels);
+    }
+    if (swap_rb) {
+      __m128i rb = _mm_and_si128(pixels, rb_mask);
+      pixels = _mm_or_si128(
+          _mm_and_si128(pixels, ag_mask),
+          _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), pixels);
+  }
+#elif defined(PIXEL_PIPELINE_NEON)
+  for (; i + 16 <= count; i += 16) {
+    uint8x16x4_t pixels =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(source + i));
+    if (unpremultiply) {
+      uint64x2_t transparent = vreinterpretq_u64_u8(vmvnq_u8(pixels.val[3]));
+      if (vgetq_lane_u64(transparent, 0) | vgetq_lane_u64(transparent, 1))
+        UnpremultiplyNEON(&pixels);
+    }
+    if (swap_rb) {
+      uint8x16_t channel = pixels.val[0];
+      pixels.val[0] = pixels.val[2];
+      pixels.val[2] = channel;
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(target + i), pixels);
+  }
+#endif
+  for (; i < count; ++i)
+    target[i] = ConvertPixel(source[i], swap_rb, unpremultiply);
+}
+
+// Adds the channels of the pixels [begin, end) of |row| to |sum|. The vector
+// paths accumulate a row in 32-bit lanes, which holds the channels of more
+// than 16 million pixels, and the sums of all rows are kept in 64 bits.
+inline void SumPixels(const uint32_t* row, int begin, int end, uint64_t* sum) {
+  int i = begin;
+#if defined(PIXEL_PIPELINE_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lanes = zero;
+  for (; i + 4 <= end; i += 4) {
+    __m128i pixels =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+    // Pixels 0 + 2 and 1 + 3 in 16-bit lanes.
+    __m128i pairs = _mm_add_epi16(_mm_unpacklo_epi8(pixels, zero),
+                                  _mm_unpackhi_epi8(pixels, zero));
+    lanes = _mm_add_epi32(lanes, _mm_unpacklo_epi16(pairs, zero));
+    lanes = _mm_add_epi32(lanes, _mm_unpackhi_epi16(pairs, zero));
+  }
+  uint32_t channels[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(channels), lanes);
+  for (int channel = 0; channel < 4; ++channel)
+    sum[channel] += channels[channel];
+#elif defined(PIXEL_PIPELINE_NEON)
+  uint32x4_t lanes = vdupq_n_u32(0);
+  for (; i + 4 <= end; i += 4) {
+    uint8x16_t pixels = vld1q_u8(reinterpret_cast<const uint8_t*>(row + i));
+    // Pixels 0 + 2 and 1 + 3 in 16-bit lanes.
+    uint16x8_t pairs = vaddl_u8(vget_low_u8(pixels), vget_high_u8(pixels));
+    lanes = vaddq_u32(lanes,
+                      vaddl_u16(vget_low_u16(pairs), vget_high_u16(pairs)));
+  }
+  uint32_t channels[4];
+  vst1q_u32(channels, lanes);
+  for (int channel = 0; channel < 4; ++channel)
+    sum[channel] += channels[channel];
+#endif
+  for (; i < end; ++i) {
+    uint32_t pixel = row[i];
+    sum[0] += pixel & 0xFF;
+    sum[1] += (pixel >> 8) & 0xFF;
+    sum[2] += (pixel >> 16) & 0xFF;
+    sum[3] += pixel >> 24;
+  }
+}
+
+// Averages the source rows [first_row, last_row) of |rect| into |target|,
+// output pixel x covering the columns [columns[x], columns[x + 1]).
+void DownscaleRow(const SkPixmap& source,
+                  const gfx::Rect& rect,
+                  int first_row,
+                  int last_row,
+                  const std::vector<int>& columns,
+                  std::vector<uint64_t>* sums,
+                  uint32_t* target) {
+  int width = static_cast<int>(columns.size()) - 1;
+  std::fill(sums->begin(), sums->end(), 0);
+  for (int y = first_row; y < last_row; ++y) {
+    const uint32_t* row = source.addr32(rect.x(), rect.y() + y);
+    uint64_t* sum = sums->data();
+    for (int x = 0; x < width; ++x, sum += 4)
+      SumPixels(row, columns[x], columns[x + 1], sum);
+  }
+
+  const uint64_t* sum = sums->data();
+  for (int x = 0; x < width; ++x, sum += 4) {
+    uint64_t count = static_cast<uint64_t>(last_row - first_row) *
+                     (columns[x + 1] - columns[x]);
+    uint32_t pixel = 0;
+    for (int channel = 3; channel >= 0; --channel) {
+      pixel = (pixel << 8) |
+              static_cast<uint32_t>((sum[channel] + count / 2) / count);
+    }
+    target[x] = pixel;
+  }
+}
+
+}  // namespace
+
+PixelPipelineOptions::PixelPipelineOptions()
+    : format(GetNativePixelFormat()) {}
+
+PixelPipelineOptions::~PixelPipelineOptions() {}
+
+PixelFormat GetNativePixelFormat() {
+  return GetPixelFormat(kN32_SkColorType);
+}
+
+bool ResolvePixelPipelineOptions(const SkPixmap& source,
+                                 PixelPipelineOptions* options) {
+  if (source.colorType() != kRGBA_8888_SkColorType &&
+      source.colorType() != kBGRA_8888_SkColorType)
+    return false;
+
+  gfx::Rect bounds(source.width(), source.height());
+  if (options->source_rect.IsEmpty())
+    options->source_rect = bounds;
+  else if (!bounds.Contains(options->source_rect))
+    return false;
+
+  const gfx::Rect& rect = options->source_rect;
+  if (options->output_size.IsEmpty())
+    options->output_size = rect.size();
+  return options->output_size.width() <= rect.width() &&
+         options->output_size.height() <= rect.height();
+}
+
+void RunPixelPipeline(const SkPixmap& source,
+                      const PixelPipelineOptions& options,
+                      uint8_t* output) {
+  const gfx::Rect& rect = options.source_rect;
+  int width = options.output_size.width();
+  int height = options.output_size.height();
+  bool swap_rb = GetPixelFormat(source.colorType()) != options.format;
+  bool unpremultiply =
+      !options.premultiplied && source.alphaType() == kPremul_SkAlphaType;
+  auto* target = reinterpret_cast<uint32_t*>(output);
+
+  if (options.output_size == rect.size()) {
+    for (int y = 0; y < height; ++y, target += width) {
+      const uint32_t* row = source.addr32(rect.x(), rect.y() + y);
+      if (swap_rb || unpremultiply)
+        ConvertRow(row, target, width, swap_rb, unpremultiply);
+      else
+        memcpy(target, row, width * sizeof(uint32_t));
+    }
+    return;
+  }
+
+  std::vector<int> columns(width + 1);
+  for (int x = 0; x <= width; ++x)
+    columns[x] = static_cast<int64_t>(x) * rect.width() / width;
+  std::vector<uint64_t> sums(width * 4);
+
+  for (int y = 0; y < height; ++y, target += width) {
+    int first_row = static_cast<int64_t>(y) * rect.height() / height;
+    int last_row = static_cast<int64_t>(y + 1) * rect.height() / height;
+    DownscaleRow(source, rect, first_row, last_row, columns, &sums, target);
+    if (swap_rb || unpremultiply)
+      ConvertRow(target, target, width, swap_rb, unpremultiply);
+  }
+}
+
+}  // namespace atom
@@ -0,0 +1,54 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_PIXEL_PIPELINE_H_
+#define ATOM_COMMON_PIXEL_PIPELINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace atom {
+
+// Byte order of the pixels written by the pipeline.
+enum class PixelFormat {
+  BGRA,
+  RGBA,
+};
+
+struct PixelPipelineOptions {
+  PixelPipelineOptions();
+  ~PixelPipelineOptions();
+
+  // Part of the source that is read, the whole source when empty.
+  gfx::Rect source_rect;
+  // Size of the output, the size of |source_rect| when empty. The pipeline
+  // only downscales, so it must not be larger than |source_rect|.
+  gfx::Size output_size;
+  PixelFormat format;
+  bool premultiplied = true;
+};
+
+// Returns the byte order of the platform's N32 bitmaps.
+PixelFormat GetNativePixelFormat();
+
+// Resolves the empty fields of |options| against |source|, returns false
+// when the options can not be applied to it.
+bool ResolvePixelPipelineOptions(const SkPixmap& source,
+                                 PixelPipelineOptions* options);
+
+// Crops, downscales with a box filter, reorders and unpremultiplies the
+// 32-bit pixels of |source| in a single pass, writing rows of
+// |options.output_size| tightly packed to |output|. The options must have
+// been resolved.
+void RunPixelPipeline(const SkPixmap& source,
+                      const PixelPipelineOptions& options,
+                      uint8_t* output);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_PIXEL_PIPELINE_H_
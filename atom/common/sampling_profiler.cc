@@ -0,0 +1,428 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/sampling_profiler.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "atom/common/api/locker.h"
+#include "atom/common/options_switches.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/message_loop/message_loop_current.h"
+#include "base/process/process_handle.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+#include "native_mate/converter.h"
+#include "v8/include/v8-profiler.h"
+
+namespace atom {
+
+namespace {
+
+// Sampling every 10ms instead of V8's default of 1ms keeps the cost of a
+// profiler that never stops low.
+const int kDefaultSamplingIntervalUs = 10000;
+const int kDefaultWindowSeconds = 10;
+const int kDefaultThresholdMs = 500;
+
+// Work past the threshold is interrupted within half a threshold.
+const int kHangChecksPerThreshold = 2;
+
+int GetIntSwitch(const base::CommandLine& command_line,
+                 const char* name,
+                 int default_value) {
+  int value;
+  if (!base::StringToInt(command_line.GetSwitchValueASCII(name), &value) ||
+      value <= 0)
+    return default_value;
+  return value;
+}
+
+// Converts consecutive profiles to the Profile type of the DevTools protocol,
+// which is what .cpuprofile files hold. The profiles are merged into one
+// tree, nodes of the same function under the same parent become one node.
+class ProfileSerializer {
+ public:
+  explicit ProfileSerializer(int64_t since) : since_(since) {}
+
+  void AddProfile(const v8::CpuProfile* profile) {
+    if (nodes_.empty()) {
+      start_time_ = std::max(since_, profile->GetStartTime());
+      last_timestamp_ = start_time_;
+    }
+    AddNode(profile->GetTopDownRoot(), 0);
+    end_time_ = profile->GetEndTime();
+
+    for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+      int64_t timestamp = profile->GetSampleTimestamp(i);
+      if (timestamp < since_)
+        continue;
+      int id = ids_[profile->GetSample(i)];
+      samples_.push_back(id);
+      time_deltas_.push_back(static_cast<int>(timestamp - last_timestamp_));
+      last_timestamp_ = timestamp;
+      ++hit_counts_[id];
+    }
+  }
+
+  std::unique_ptr<base::DictionaryValue> Serialize() {
+    auto nodes = std::make_unique<base::ListValue>();
+    for (auto& node : nodes_) {
+      int id = 0;
+      node->GetInteger("id", &id);
+      node->SetInteger("hitCount", hit_counts_[id]);
+      nodes->Append(std::move(node));
+    }
+    nodes_.clear();
+
+    auto samples = std::make_unique<base::ListValue>();
+    for (int id : samples_)
+      samples->AppendInteger(id);
+    auto time_deltas = std::make_unique<base::ListValue>();
+    for (int delta : time_deltas_)
+      time_deltas->AppendInteger(delta);
+
+    auto profile = std::make_unique<base::DictionaryValue>();
+    profile->Set("nodes", std::move(nodes));
+    // Microsecond timestamps do not fit in an int.
+    profile->SetDouble("startTime", static_cast<double>(start_time_));
+    profile->SetDouble("endTime", static_cast<double>(end_time_));
+    profile->Set("samples", std::move(samples));
+    profile->Set("timeDeltas", std::move(time_deltas));
+    return profile;
+  }
+
+ private:
+  // The parent id and the call frame of a node.
+  using NodeKey = std::tuple<int, std::string, int, std::string, int, int>;
+
+  // Adds |node| and its children under the node |parent_id|, 0 for the root.
+  void AddNode(const v8::CpuProfileNode* node, int parent_id) {
+    NodeKey key(parent_id, node->GetFunctionNameStr(), node->GetScriptId(),
+                node->GetScriptResourceNameStr(), node->GetLineNumber(),
+                node->GetColumnNumber());
+    auto it = node_ids_.find(key);
+    int id;
+    if (it != node_ids_.end()) {
+      id = it->second;
+    } else {
+      id = static_cast<int>(nodes_.size()) + 1;
+      node_ids_[key] = id;
+
+      // The protocol counts lines and columns from 0, V8 from 1.
+      auto call_frame = std::make_unique<base::DictionaryValue>();
+      call_frame->SetString("functionName", node->GetFunctionNameStr());
+      call_frame->SetString("scriptId",
+                            base::IntToString(node->GetScriptId()));
+      call_frame->SetString("url", node->GetScriptResourceNameStr());
+      call_frame->SetInteger("lineNumber", node->GetLineNumber() - 1);
+      call_frame->SetInteger("columnNumber", node->GetColumnNumber() - 1);
+
+      auto dict = std::make_unique<base::DictionaryValue>();
+      dict->SetInteger("id", id);
+      dict->Set("callFrame", std::move(call_frame));
+      dict->Set("children", std::make_unique<base::ListValue>());
+      nodes_.push_back(std::move(dict));
+
+      if (parent_id > 0) {
+        base::ListValue* children = nullptr;
+        nodes_[parent_id - 1]->GetList("children", &children);
+        children->AppendInteger(id);
+      }
+    }
+    ids_[node] = id;
+
+    for (int i = 0; i < node->GetChildrenCount(); ++i)
+      AddNode(node->GetChild(i), id);
+  }
+
+  int64_t since_;
+  int64_t start_time_ = 0;
+  int64_t end_time_ = 0;
+  int64_t last_timestamp_ = 0;
+
+  std::vector<std::unique_ptr<base::DictionaryValue>> nodes_;
+  std::map<NodeKey, int> node_ids_;
+  std::map<const v8::CpuProfileNode*, int> ids_;
+  std::map<int, int> hit_counts_;
+  std::vector<int> samples_;
+  std::vector<int> time_deltas_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileSerializer);
+};
+
+void WriteProfile(const base::FilePath& path, const std::string& json) {
+  if (!base::CreateDirectory(path.DirName()) ||
+      base::WriteFile(path, json.data(), json.size()) !=
+          static_cast<int>(json.size()))
+    LOG(ERROR) << "Failed to write the CPU profile to " << path.value();
+}
+
+}  // namespace
+
+// Watches the work of the profiled thread from a task scheduler sequence and
+// interrupts JavaScript that is still running past the threshold. The
+// profiler clears |isolate_| when it goes away.
+class SamplingProfiler::HangDetector
+    : public base::RefCountedThreadSafe<HangDetector> {
+ public:
+  HangDetector(v8::Isolate* isolate,
+               base::TimeDelta threshold,
+               base::WeakPtr<SamplingProfiler> profiler)
+      : isolate_(isolate),
+        threshold_(threshold),
+        check_interval_(std::max(threshold / kHangChecksPerThreshold,
+                                 base::TimeDelta::FromMilliseconds(1))),
+        profiler_(profiler),
+        task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+            {base::TaskPriority::USER_VISIBLE,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
+    ScheduleCheck();
+  }
+
+  // Called on the profiled thread.
+  void WorkStarted(base::TimeTicks start) {
+    base::AutoLock auto_lock(lock_);
+    work_start_ = start;
+    ++work_id_;
+  }
+
+  void WorkFinished() {
+    base::AutoLock auto_lock(lock_);
+    work_start_ = base::TimeTicks();
+  }
+
+  void Shutdown() {
+    base::AutoLock auto_lock(lock_);
+    isolate_ = nullptr;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<HangDetector>;
+
+  ~HangDetector() {}
+
+  void Check() {
+    {
+      base::AutoLock auto_lock(lock_);
+      if (!isolate_)
+        return;
+      if (!work_start_.is_null() && interrupted_id_ != work_id_ &&
+          base::TimeTicks::Now() - work_start_ >= threshold_) {
+        interrupted_id_ = work_id_;
+        // V8 runs the interrupt on the profiled thread the next time it
+        // checks its stack guard, which only happens while JavaScript runs.
+        isolate_->RequestInterrupt(
+            &SamplingProfiler::DumpFromInterrupt,
+            new base::WeakPtr<SamplingProfiler>(profiler_));
+      }
+    }
+    ScheduleCheck();
+  }
+
+  void ScheduleCheck() {
+    task_runner_->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&HangDetector::Check, this),
+        check_interval_);
+  }
+
+  base::Lock lock_;
+  // Guarded by |lock_|.
+  v8::Isolate* isolate_;
+  base::TimeTicks work_start_;
+  int work_id_ = 0;
+  int interrupted_id_ = 0;
+
+  base::TimeDelta threshold_;
+  base::TimeDelta check_interval_;
+  // Only dereferenced on the profiled thread.
+  base::WeakPtr<SamplingProfiler> profiler_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(HangDetector);
+};
+
+// static
+std::unique_ptr<SamplingProfiler> SamplingProfiler::CreateFromCommandLine(
+    v8::Isolate* isolate,
+    const std::string& process_type) {
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  base::FilePath directory =
+      command_line->GetSwitchValuePath(switches::kSamplingProfilerDir);
+  if (directory.empty())
+    return nullptr;
+
+  return std::make_unique<SamplingProfiler>(
+      isolate, process_type, directory,
+      GetIntSwitch(*command_line, switches::kSamplingProfilerInterval,
+                   kDefaultSamplingIntervalUs),
+      base::TimeDelta::FromSeconds(GetIntSwitch(
+          *command_line, switches::kSamplingProfilerWindow,
+          kDefaultWindowSeconds)),
+      base::TimeDelta::FromMilliseconds(GetIntSwitch(
+          *command_line, switches::kSamplingProfilerThreshold,
+          kDefaultThresholdMs)));
+}
+
+SamplingProfiler::SamplingProfiler(v8::Isolate* isolate,
+                                   const std::string& process_type,
+                                   const base::FilePath& directory,
+                                   int sampling_interval_us,
+                                   base::TimeDelta window,
+                                   base::TimeDelta threshold)
+    : isolate_(isolate),
+      process_type_(process_type),
+      directory_(directory),
+      window_(window),
+      threshold_(threshold),
+      profiler_(v8::CpuProfiler::New(isolate)),
+      weak_factory_(this) {
+  profiler_->SetSamplingInterval(sampling_interval_us);
+  RestartProfile();
+  rotate_timer_.Start(FROM_HERE, window_,
+                      base::Bind(&SamplingProfiler::RotateProfiles,
+                                 base::Unretained(this)));
+  base::MessageLoopCurrent::Get()->AddTaskObserver(this);
+  NodeBindings::AddUvWorkObserver(this);
+  hang_detector_ =
+      new HangDetector(isolate_, threshold_, weak_factory_.GetWeakPtr());
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  hang_detector_->Shutdown();
+  NodeBindings::RemoveUvWorkObserver(this);
+  base::MessageLoopCurrent::Get()->RemoveTaskObserver(this);
+  rotate_timer_.Stop();
+
+  mate::Locker locker(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+  v8::CpuProfile* profile =
+      profiler_->StopProfiling(mate::StringToV8(isolate_, title_));
+  if (profile)
+    profile->Delete();
+  if (previous_profile_)
+    previous_profile_->Delete();
+  profiler_->Dispose();
+}
+
+void SamplingProfiler::Dump() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  // The file covers the whole window, so there is no need to write the next
+  // long task of the same window again.
+  if (!last_dump_.is_null() && now - last_dump_ < window_)
+    return;
+  last_dump_ = now;
+
+  TRACE_EVENT0("electron", "SamplingProfiler::Dump");
+  v8::CpuProfile* profile = RestartProfile();
+  if (!profile)
+    return;
+
+  ProfileSerializer serializer(profile->GetEndTime() -
+                               window_.InMicroseconds());
+  if (previous_profile_)
+    serializer.AddProfile(previous_profile_);
+  serializer.AddProfile(profile);
+  std::string json;
+  base::JSONWriter::Write(*serializer.Serialize(), &json);
+
+  // The new profile covers everything after the one just written.
+  profile->Delete();
+  if (previous_profile_)
+    previous_profile_->Delete();
+  previous_profile_ = nullptr;
+  rotate_timer_.Reset();
+
+  base::FilePath path = directory_.AppendASCII(base::StringPrintf(
+      "%s-%d-%" PRId64 ".cpuprofile", process_type_.c_str(),
+      static_cast<int>(base::GetCurrentProcId()),
+      base::Time::Now().ToJavaTime()));
+  base::PostTaskWithTraits(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BACKGROUND},
+      base::BindOnce(&WriteProfile, path, std::move(json)));
+}
+
+void SamplingProfiler::WillProcessTask(const base::PendingTask& pending_task) {
+  WillRunWork();
+}
+
+void SamplingProfiler::DidProcessTask(const base::PendingTask& pending_task) {
+  DidRunWork();
+}
+
+void SamplingProfiler::WillRunUvWork() {
+  WillRunWork();
+}
+
+void SamplingProfiler::DidRunUvWork() {
+  DidRunWork();
+}
+
+void SamplingProfiler::WillRunWork() {
+  ++work_depth_;
+  work_start_ = base::TimeTicks::Now();
+  hang_detector_->WorkStarted(work_start_);
+}
+
+void SamplingProfiler::DidRunWork() {
+  // The work that created the profiler was not seen starting.
+  if (work_depth_ == 0)
+    return;
+  --work_depth_;
+  // The outer work of a nested message loop, the work run by the loop was
+  // measured instead.
+  if (work_start_.is_null())
+    return;
+  base::TimeDelta duration = base::TimeTicks::Now() - work_start_;
+  work_start_ = base::TimeTicks();
+  hang_detector_->WorkFinished();
+  if (duration >= threshold_)
+    Dump();
+}
+
+// static
+void SamplingProfiler::DumpFromInterrupt(v8::Isolate* isolate, void* data) {
+  std::unique_ptr<base::WeakPtr<SamplingProfiler>> profiler(
+      static_cast<base::WeakPtr<SamplingProfiler>*>(data));
+  if (*profiler)
+    (*profiler)->Dump();
+}
+
+v8::CpuProfile* SamplingProfiler::RestartProfile() {
+  mate::Locker locker(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+
+  // Starting the new profile first keeps the sampling thread running.
+  std::string previous_title = title_;
+  title_ = base::StringPrintf("electron-sampling-profiler-%d",
+                              ++next_profile_id_);
+  profiler_->StartProfiling(mate::StringToV8(isolate_, title_), true);
+  if (previous_title.empty())
+    return nullptr;
+  return profiler_->StopProfiling(mate::StringToV8(isolate_, previous_title));
+}
+
+void SamplingProfiler::RotateProfiles() {
+  v8::CpuProfile* profile = RestartProfile();
+  if (previous_profile_)
+    previous_profile_->Delete();
+  previous_profile_ = profile;
+}
+
+}  // namespace atom
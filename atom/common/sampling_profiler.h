@@ -0,0 +1,115 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_SAMPLING_PROFILER_H_
+#define ATOM_COMMON_SAMPLING_PROFILER_H_
+
+#include <memory>
+#include <string>
+
+#include "atom/common/node_bindings.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace v8 {
+class CpuProfile;
+class CpuProfiler;
+class Isolate;
+}  // namespace v8
+
+namespace atom {
+
+// Keeps V8's CpuProfiler sampling an isolate at a low rate, and writes the
+// samples of the last few seconds to a .cpuprofile file after a task or a
+// run of the libuv loop on the isolate's thread took longer than a threshold,
+// so the file shows what kept the thread busy.
+//
+// A unit of work that is still running past the threshold is written from a
+// V8 interrupt, so hangs in JavaScript are covered too. A thread that hangs
+// without running JavaScript does not handle interrupts and is only written
+// once the work is over.
+//
+// A running V8 profile can not drop its old samples, so the profile is
+// restarted every |window| and the previous one is kept until the next
+// restart. Together they always cover the last |window|.
+class SamplingProfiler : public base::MessageLoop::TaskObserver,
+                         public NodeBindings::UvWorkObserver {
+ public:
+  // Returns null unless --sampling-profiler-dir is passed to the process.
+  static std::unique_ptr<SamplingProfiler> CreateFromCommandLine(
+      v8::Isolate* isolate,
+      const std::string& process_type);
+
+  SamplingProfiler(v8::Isolate* isolate,
+                   const std::string& process_type,
+                   const base::FilePath& directory,
+                   int sampling_interval_us,
+                   base::TimeDelta window,
+                   base::TimeDelta threshold);
+  ~SamplingProfiler() override;
+
+  // Writes the samples of the last |window_| to the directory.
+  void Dump();
+
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+  // NodeBindings::UvWorkObserver:
+  void WillRunUvWork() override;
+  void DidRunUvWork() override;
+
+ private:
+  class HangDetector;
+
+  // The innermost unit of work is measured, a task running a nested message
+  // loop is not blocking while the loop runs other work.
+  void WillRunWork();
+  void DidRunWork();
+
+  // Runs on the profiled thread once V8 handles the interrupt requested for
+  // a hang.
+  static void DumpFromInterrupt(v8::Isolate* isolate, void* data);
+
+  // Starts a new profile and returns the one that was running.
+  v8::CpuProfile* RestartProfile();
+
+  // Replaces the previous profile with the running one.
+  void RotateProfiles();
+
+  v8::Isolate* isolate_;
+  std::string process_type_;
+  base::FilePath directory_;
+  base::TimeDelta window_;
+  base::TimeDelta threshold_;
+
+  v8::CpuProfiler* profiler_;
+  // The running profile is identified by its title.
+  std::string title_;
+  int next_profile_id_ = 0;
+  v8::CpuProfile* previous_profile_ = nullptr;
+
+  base::RepeatingTimer rotate_timer_;
+
+  // Start of the innermost work running on the thread, null once it is
+  // over.
+  base::TimeTicks work_start_;
+  int work_depth_ = 0;
+  base::TimeTicks last_dump_;
+
+  scoped_refptr<HangDetector> hang_detector_;
+
+  base::WeakPtrFactory<SamplingProfiler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingProfiler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_SAMPLING_PROFILER_H_
@@ -0,0 +1,125 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/startup_timeline.h"
+
+#include <memory>
+#include <utility>
+
+#include "atom/common/options_switches.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/process/process_handle.h"
+#include "base/process/process_info.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+
+namespace atom {
+
+namespace {
+
+// Repeated marks, like asar archive opens, stop being recorded after this.
+const size_t kMaxMarks = 256;
+
+void WriteTraceFile(const base::FilePath& path,
+                    const std::vector<StartupTimeline::Mark>& marks) {
+  auto events = std::make_unique<base::ListValue>();
+  base::ProcessId pid = base::GetCurrentProcId();
+  for (const auto& mark : marks) {
+    auto event = std::make_unique<base::DictionaryValue>();
+    event->SetString("name", mark.name);
+    event->SetString("cat", "electron,startup");
+    event->SetString("ph", "I");
+    event->SetString("s", "p");
+    event->SetDouble("ts", mark.time.InMicrosecondsF());
+    event->SetInteger("pid", pid);
+    event->SetInteger("tid", 0);
+    auto args = std::make_unique<base::DictionaryValue>();
+    if (!mark.detail.empty())
+      args->SetString("detail", mark.detail);
+    event->Set("args", std::move(args));
+    events->Append(std::move(event));
+  }
+
+  base::DictionaryValue trace;
+  trace.Set("traceEvents", std::move(events));
+  trace.SetString("displayTimeUnit", "ms");
+
+  std::string json;
+  base::JSONWriter::Write(trace, &json);
+  if (base::WriteFile(path, json.data(), json.size()) !=
+      static_cast<int>(json.size()))
+    LOG(ERROR) << "Failed to write startup timeline to " << path.value();
+}
+
+}  // namespace
+
+// static
+StartupTimeline* StartupTimeline::GetInstance() {
+  static base::NoDestructor<StartupTimeline> instance;
+  return instance.get();
+}
+
+StartupTimeline::StartupTimeline() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::Time creation_time = base::CurrentProcessInfo::CreationTime();
+  origin_ = now;
+  if (!creation_time.is_null()) {
+    base::TimeDelta uptime = base::Time::Now() - creation_time;
+    if (uptime > base::TimeDelta())
+      origin_ = now - uptime;
+  }
+}
+
+StartupTimeline::~StartupTimeline() {}
+
+void StartupTimeline::AddMark(const char* name, const std::string& detail) {
+  TRACE_EVENT_INSTANT1("electron", name, TRACE_EVENT_SCOPE_PROCESS, "detail",
+                       detail);
+  base::TimeDelta time = base::TimeTicks::Now() - origin_;
+  base::AutoLock auto_lock(lock_);
+  if (marks_.size() < kMaxMarks)
+    marks_.push_back({name, detail, time});
+}
+
+void StartupTimeline::AddMarkOnce(const char* name) {
+  {
+    base::AutoLock auto_lock(lock_);
+    if (!once_marks_.insert(name).second)
+      return;
+  }
+  AddMark(name);
+}
+
+std::vector<StartupTimeline::Mark> StartupTimeline::GetMarks() {
+  base::AutoLock auto_lock(lock_);
+  return marks_;
+}
+
+void StartupTimeline::WriteTraceFileIfRequested() {
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  base::FilePath path =
+      command_line->GetSwitchValuePath(switches::kStartupTimelineFile);
+  if (path.empty())
+    return;
+
+  std::vector<Mark> marks;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (trace_file_written_)
+      return;
+    trace_file_written_ = true;
+    marks = marks_;
+  }
+  base::PostTaskWithTraits(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BACKGROUND,
+       base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+      base::BindOnce(&WriteTraceFile, path, std::move(marks)));
+}
+
+}  // namespace atom
@@ -0,0 +1,69 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_STARTUP_TIMELINE_H_
+#define ATOM_COMMON_STARTUP_TIMELINE_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace atom {
+
+// Records when the phases of startup happen in the current process, relative
+// to the time the process was launched.
+//
+// Marks are cheap and always recorded, they are also emitted as trace events
+// in the "electron" category. The timeline can be used from any thread.
+class StartupTimeline {
+ public:
+  struct Mark {
+    // Points to a string literal.
+    const char* name;
+    std::string detail;
+    base::TimeDelta time;
+  };
+
+  static StartupTimeline* GetInstance();
+
+  // Records |name|, which must be a string literal.
+  void AddMark(const char* name, const std::string& detail = std::string());
+
+  // Records |name| unless it has been recorded before.
+  void AddMarkOnce(const char* name);
+
+  std::vector<Mark> GetMarks();
+
+  // Writes the marks in the trace event format to the path passed with
+  // --startup-timeline-file, if any. Only the first call writes the file and
+  // it does not block the calling thread.
+  void WriteTraceFileIfRequested();
+
+ private:
+  friend class base::NoDestructor<StartupTimeline>;
+
+  StartupTimeline();
+  ~StartupTimeline();
+
+  // Marks are relative to this, the launch time of the process when it is
+  // known and the creation of the timeline otherwise.
+  base::TimeTicks origin_;
+
+  base::Lock lock_;
+  std::vector<Mark> marks_;
+  std::set<const char*> once_marks_;
+  bool trace_file_written_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_STARTUP_TIMELINE_H_
@@ -4,12 +4,15 @@
 
 #include "atom/renderer/atom_render_frame_observer.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/heap_snapshot.h"
+#include "atom/common/memory_usage.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_includes.h"
 #include "base/strings/string_number_conversions.h"
@@ -21,11 +24,13 @@
 #include "native_mate/dictionary.h"
 #include "net/base/net_module.h"
 #include "net/grit/net_resources.h"
+#include "third_party/blink/public/platform/web_cache.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
 #include "third_party/blink/public/web/web_draggable_region.h"
 #include "third_party/blink/public/web/web_element.h"
 #include "third_party/blink/public/web/web_local_frame.h"
+#include "third_party/blink/public/web/web_memory_statistics.h"
 #include "third_party/blink/public/web/web_script_source.h"
 #include "ui/base/resource/resource_bundle.h"
 
@@ -69,6 +74,38 @@ base::StringPiece NetResourceProvider(int key) {
   return base::StringPiece();
 }
 
+// Returns the memory used by Blink's allocators and its resource cache in
+// kilobytes.
+std::unique_ptr<base::DictionaryValue> GetBlinkMemoryUsage() {
+  auto usage = std::make_unique<base::DictionaryValue>();
+  blink::WebMemoryStatistics stats = blink::WebMemoryStatistics::Get();
+  usage->SetDouble(
+      "partitionAlloc",
+      static_cast<double>(stats.partition_alloc_total_allocated_bytes >> 10));
+  usage->SetDouble(
+      "blinkGC",
+      static_cast<double>(stats.blink_gc_total_allocated_bytes >> 10));
+
+  blink::WebCache::ResourceTypeStats cache_stats;
+  blink::WebCache::GetResourceTypeStats(&cache_stats);
+  auto cache = std::make_unique<base::DictionaryValue>();
+  cache->SetDouble("images",
+                   static_cast<double>(cache_stats.images.size >> 10));
+  cache->SetDouble("scripts",
+                   static_cast<double>(cache_stats.scripts.size >> 10));
+  cache->SetDouble(
+      "cssStyleSheets",
+      static_cast<double>(cache_stats.css_style_sheets.size >> 10));
+  cache->SetDouble(
+      "xslStyleSheets",
+      static_cast<double>(cache_stats.xsl_style_sheets.size >> 10));
+  cache->SetDouble("fonts", static_cast<double>(cache_stats.fonts.size >> 10));
+  cache->SetDouble("other", static_cast<double>(cache_stats.other.size >> 10));
+  usage->Set("cache", std::move(cache));
+
+  return usage;
+}
+
 }  // namespace
 
 AtomRenderFrameObserver::AtomRenderFrameObserver(
@@ -166,6 +203,7 @@ bool AtomRenderFrameObserver::OnMessageReceived(const IPC::Message& message) {
   IPC_BEGIN_MESSAGE_MAP(AtomRenderFrameObserver, message)
     IPC_MESSAGE_HANDLER(AtomFrameMsg_Message, OnBrowserMessage)
     IPC_MESSAGE_HANDLER(AtomFrameMsg_TakeHeapSnapshot, OnTakeHeapSnapshot)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_GetMemoryUsage, OnGetMemoryUsage)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -218,6 +256,19 @@ void AtomRenderFrameObserver::OnTakeHeapSnapshot(
       render_frame_->GetRoutingID(), "ipc-message", args));
 }
 
+void AtomRenderFrameObserver::OnGetMemoryUsage(const std::string& channel) {
+  auto usage = std::make_unique<base::DictionaryValue>();
+  usage->Set("v8", GetV8MemoryUsage(blink::MainThreadIsolate()));
+  usage->Set("blink", GetBlinkMemoryUsage());
+
+  base::ListValue args;
+  args.AppendString(channel);
+  args.Append(std::move(usage));
+
+  render_frame_->Send(new AtomFrameHostMsg_Message(
+      render_frame_->GetRoutingID(), "ipc-internal-message", args));
+}
+
 void AtomRenderFrameObserver::EmitIPCEvent(blink::WebLocalFrame* frame,
                                            bool internal,
                                            const std::string& channel,
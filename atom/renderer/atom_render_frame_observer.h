@@ -62,6 +62,7 @@ class AtomRenderFrameObserver : public content::RenderFrameObserver {
                         int32_t sender_id);
   void OnTakeHeapSnapshot(IPC::PlatformFileForTransit file_handle,
                           const std::string& channel);
+  void OnGetMemoryUsage(const std::string& channel);
 
   content::RenderFrame* render_frame_;
   RendererClientBase* renderer_client_;
@@ -15,7 +15,11 @@
 #include "atom/renderer/api/atom_api_renderer_ipc.h"
 #include "atom/renderer/atom_render_frame_observer.h"
 #include "atom/renderer/web_worker_observer.h"
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_split.h"
+#include "base/task_scheduler/post_task.h"
 #include "content/public/common/web_preferences.h"
 #include "content/public/renderer/render_frame.h"
 #include "native_mate/dictionary.h"
@@ -30,6 +34,12 @@ namespace atom {
 
 namespace {
 
+#if defined(OS_WIN)
+const base::FilePath::CharType kPathDelimiter[] = FILE_PATH_LITERAL(";");
+#else
+const base::FilePath::CharType kPathDelimiter[] = FILE_PATH_LITERAL(":");
+#endif
+
 bool IsDevToolsExtension(content::RenderFrame* render_frame) {
   return static_cast<GURL>(render_frame->GetWebFrame()->GetDocument().Url())
       .SchemeIs("chrome-extension");
@@ -47,6 +57,16 @@ AtomRendererClient::~AtomRendererClient() {
 
 void AtomRendererClient::RenderThreadStarted() {
   RendererClientBase::RenderThreadStarted();
+
+  // A spare renderer has no frame to run scripts in until it is handed to a
+  // window, do the work that does not need a script context meanwhile.
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch(switches::kSpareRenderer) &&
+      command_line->GetSwitchValueASCII(switches::kNodeIntegration) ==
+          "true") {
+    InitializeNodeIntegration();
+    PrefetchPreloadScripts();
+  }
 }
 
 void AtomRendererClient::RenderFrameCreated(
@@ -98,17 +118,7 @@ void AtomRendererClient::DidCreateScriptContext(
 
   injected_frames_.insert(render_frame);
 
-  // Prepare the node bindings.
-  if (!node_integration_initialized_) {
-    node_integration_initialized_ = true;
-    node_bindings_->Initialize();
-    node_bindings_->PrepareMessageLoop();
-  }
-
-  // Setup node tracing controller.
-  if (!node::tracing::TraceEventHelper::GetTracingController())
-    node::tracing::TraceEventHelper::SetTracingController(
-        new v8::TracingController());
+  InitializeNodeIntegration();
 
   // Setup node environment for each window.
   node::Environment* env = node_bindings_->CreateEnvironment(context);
@@ -224,6 +234,51 @@ void AtomRendererClient::SetupMainWorldOverrides(
   ignore_result(func->Call(context, v8::Null(isolate), 1, args));
 }
 
+void AtomRendererClient::InitializeNodeIntegration() {
+  // Prepare the node bindings.
+  if (!node_integration_initialized_) {
+    node_integration_initialized_ = true;
+    node_bindings_->Initialize();
+    node_bindings_->PrepareMessageLoop();
+  }
+
+  // Setup node tracing controller.
+  if (!node::tracing::TraceEventHelper::GetTracingController())
+    node::tracing::TraceEventHelper::SetTracingController(
+        new v8::TracingController());
+}
+
+void AtomRendererClient::PrefetchPreloadScripts() {
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+  std::vector<base::FilePath::StringType> preloads = base::SplitString(
+      command_line->GetSwitchValueNative(switches::kPreloadScripts),
+      kPathDelimiter, base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (command_line->HasSwitch(switches::kPreloadScript))
+    preloads.push_back(
+        command_line->GetSwitchValueNative(switches::kPreloadScript));
+
+  for (const auto& preload : preloads) {
+    base::FilePath path(preload);
+    base::FilePath asar_path, relative_path;
+    if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+      // Archives are cached per thread, the preload scripts are read on this
+      // one.
+      asar::GetOrCreateAsarArchive(asar_path);
+    } else {
+      // Only warms the file cache of the system, the script is read again
+      // when the window loads it.
+      base::PostTaskWithTraits(
+          FROM_HERE, {base::MayBlock(), base::TaskPriority::BACKGROUND},
+          base::BindOnce(
+              [](const base::FilePath& path) {
+                std::string contents;
+                base::ReadFileToString(path, &contents);
+              },
+              path));
+    }
+  }
+}
+
 node::Environment* AtomRendererClient::GetEnvironment(
     content::RenderFrame* render_frame) const {
   if (injected_frames_.find(render_frame) == injected_frames_.end())
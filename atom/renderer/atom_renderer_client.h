@@ -58,6 +58,12 @@ class AtomRendererClient : public RendererClientBase {
   void WillDestroyWorkerContextOnWorkerThread(
       v8::Local<v8::Context> context) override;
 
+  // Initializes node once for all the environments of this process.
+  void InitializeNodeIntegration();
+
+  // Reads the preload scripts of a spare renderer ahead of its window.
+  void PrefetchPreloadScripts();
+
   node::Environment* GetEnvironment(content::RenderFrame* frame) const;
 
   // Whether the node integration has been initialized.
@@ -11,6 +11,7 @@
 #include "atom/common/color_util.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/sampling_profiler.h"
 #include "atom/renderer/atom_autofill_agent.h"
 #include "atom/renderer/atom_render_frame_observer.h"
 #include "atom/renderer/atom_render_view_observer.h"
@@ -179,6 +180,10 @@ void RendererClientBase::RenderThreadStarted() {
     SetCurrentProcessExplicitAppUserModelID(app_id.c_str());
   }
 #endif
+
+  // --sampling-profiler-dir, only passed when the window opted in.
+  sampling_profiler_ = SamplingProfiler::CreateFromCommandLine(
+      blink::MainThreadIsolate(), "renderer");
 }
 
 void RendererClientBase::RenderFrameCreated(
@@ -21,6 +21,7 @@
 namespace atom {
 
 class PreferencesManager;
+class SamplingProfiler;
 
 class RendererClientBase : public content::ContentRendererClient {
  public:
@@ -60,6 +61,7 @@ class RendererClientBase : public content::ContentRendererClient {
 
  private:
   std::unique_ptr<PreferencesManager> preferences_manager_;
+  std::unique_ptr<SamplingProfiler> sampling_profiler_;
 #if defined(WIDEVINE_CDM_AVAILABLE)
   ChromeKeySystemsProvider key_systems_provider_;
 #endif
@@ -0,0 +1,63 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/utility/api/atom_api_parent_port.h"
+
+#include <utility>
+
+#include "atom/common/node_message_serializer.h"
+#include "native_mate/arguments.h"
+#include "native_mate/object_template_builder.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace api {
+
+ParentPort::ParentPort(v8::Isolate* isolate,
+                       mojom::NodeMessagePortRequest request,
+                       mojom::NodeMessagePortPtr client)
+    : binding_(this, std::move(request)), client_(std::move(client)) {
+  Init(isolate);
+}
+
+ParentPort::~ParentPort() {}
+
+// static
+mate::Handle<ParentPort> ParentPort::Create(
+    v8::Isolate* isolate,
+    mojom::NodeMessagePortRequest request,
+    mojom::NodeMessagePortPtr client) {
+  return mate::CreateHandle(
+      isolate, new ParentPort(isolate, std::move(request), std::move(client)));
+}
+
+void ParentPort::PostMessage(mojom::NodeMessagePtr message) {
+  v8::HandleScope handle_scope(isolate());
+  v8::MicrotasksScope script_scope(isolate(),
+                                   v8::MicrotasksScope::kRunMicrotasks);
+  v8::Local<v8::Value> value;
+  if (!DeserializeNodeMessage(isolate(), *message).ToLocal(&value))
+    return;
+  Emit("message", value);
+}
+
+void ParentPort::PostMessageToParent(mate::Arguments* args) {
+  mojom::NodeMessagePtr message = SerializeNodeMessage(args);
+  if (message)
+    client_->PostMessage(std::move(message));
+}
+
+// static
+void ParentPort::BuildPrototype(v8::Isolate* isolate,
+                                v8::Local<v8::FunctionTemplate> prototype) {
+  prototype->SetClassName(mate::StringToV8(isolate, "ParentPort"));
+  mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("postMessage", &ParentPort::PostMessageToParent);
+}
+
+}  // namespace api
+
+}  // namespace atom
@@ -0,0 +1,56 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_UTILITY_API_ATOM_API_PARENT_PORT_H_
+#define ATOM_UTILITY_API_ATOM_API_PARENT_PORT_H_
+
+#include "atom/browser/api/event_emitter.h"
+#include "atom/common/node_service.mojom.h"
+#include "mojo/public/cpp/bindings/binding.h"
+#include "native_mate/handle.h"
+
+namespace mate {
+class Arguments;
+}
+
+namespace atom {
+
+namespace api {
+
+// The process.parentPort object of utility processes, messages posted by the
+// browser are emitted as "message" events.
+class ParentPort : public mate::EventEmitter<ParentPort>,
+                   public mojom::NodeMessagePort {
+ public:
+  static mate::Handle<ParentPort> Create(v8::Isolate* isolate,
+                                         mojom::NodeMessagePortRequest request,
+                                         mojom::NodeMessagePortPtr client);
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Local<v8::FunctionTemplate> prototype);
+
+  // mojom::NodeMessagePort:
+  void PostMessage(mojom::NodeMessagePtr message) override;
+
+ protected:
+  ParentPort(v8::Isolate* isolate,
+             mojom::NodeMessagePortRequest request,
+             mojom::NodeMessagePortPtr client);
+  ~ParentPort() override;
+
+ private:
+  // parentPort.postMessage(message[, transfer]).
+  void PostMessageToParent(mate::Arguments* args);
+
+  mojo::Binding<mojom::NodeMessagePort> binding_;
+  mojom::NodeMessagePortPtr client_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParentPort);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_UTILITY_API_ATOM_API_PARENT_PORT_H_
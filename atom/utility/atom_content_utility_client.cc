@@ -6,7 +6,10 @@
 
 #include <utility>
 
+#include "atom/common/node_service.mojom.h"
+#include "atom/utility/node_service.h"
 #include "base/command_line.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/public/child/child_thread.h"
 #include "content/public/common/service_manager_connection.h"
 #include "content/public/common/simple_connection_filter.h"
@@ -91,6 +94,12 @@ void AtomContentUtilityClient::RegisterServices(StaticServiceMap* services) {
   services->emplace(proxy_resolver::mojom::kProxyResolverServiceName,
                     proxy_resolver_info);
 
+  // Node environments run on the main thread of the utility process.
+  service_manager::EmbeddedServiceInfo node_info;
+  node_info.task_runner = base::ThreadTaskRunnerHandle::Get();
+  node_info.factory = base::BindRepeating(&NodeService::CreateService);
+  services->emplace(mojom::kNodeServiceName, node_info);
+
 #if BUILDFLAG(ENABLE_PRINTING)
   service_manager::EmbeddedServiceInfo printing_info;
   printing_info.factory =
@@ -0,0 +1,122 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/utility/node_service.h"
+
+#include <utility>
+
+#include "atom/browser/javascript_environment.h"
+#include "atom/common/api/atom_bindings.h"
+#include "atom/common/api/event_emitter_caller.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/node_bindings.h"
+#include "atom/utility/api/atom_api_parent_port.h"
+#include "base/bind.h"
+#include "gin/v8_initializer.h"
+#include "mojo/public/cpp/bindings/message.h"
+#include "native_mate/dictionary.h"
+#include "services/service_manager/public/cpp/service_context.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+NodeService::NodeService() : binding_(this) {}
+
+NodeService::~NodeService() {
+  if (!node_env_)
+    return;
+
+  {
+    v8::HandleScope handle_scope(js_env_->isolate());
+    node::Environment* env = node_bindings_->uv_env();
+    mate::EmitEvent(js_env_->isolate(), env->process_object(), "exit");
+  }
+  node_bindings_->set_uv_env(nullptr);
+
+  // The process is about to quit, leak the environments like the browser
+  // process does instead of waiting for V8's background tasks.
+  ignore_result(node_env_.release());
+  ignore_result(js_env_.release());
+}
+
+// static
+std::unique_ptr<service_manager::Service> NodeService::CreateService() {
+  return std::make_unique<NodeService>();
+}
+
+void NodeService::OnStart() {
+  ref_factory_ = std::make_unique<service_manager::ServiceContextRefFactory>(
+      base::BindRepeating(&service_manager::ServiceContext::RequestQuit,
+                          base::Unretained(context())));
+  registry_.AddInterface(base::BindRepeating(
+      &NodeService::BindNodeServiceRequest, base::Unretained(this)));
+}
+
+void NodeService::OnBindInterface(
+    const service_manager::BindSourceInfo& source_info,
+    const std::string& interface_name,
+    mojo::ScopedMessagePipeHandle interface_pipe) {
+  registry_.BindInterface(interface_name, std::move(interface_pipe));
+}
+
+void NodeService::Initialize(mojom::NodeServiceParamsPtr params,
+                             mojom::NodeMessagePortRequest port,
+                             mojom::NodeMessagePortPtr client) {
+  if (js_env_) {
+    mojo::ReportBadMessage("NodeService is already initialized");
+    return;
+  }
+
+  gin::V8Initializer::LoadV8Snapshot(
+      gin::V8Initializer::V8SnapshotFileType::kWithAdditionalContext);
+  gin::V8Initializer::LoadV8Natives();
+
+  node_bindings_.reset(NodeBindings::Create(NodeBindings::UTILITY));
+  atom_bindings_ = std::make_unique<AtomBindings>(node_bindings_->uv_loop());
+  js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
+
+  node_bindings_->Initialize();
+  node::Environment* env = node_bindings_->CreateEnvironment(
+      js_env_->context(), js_env_->platform());
+  node_env_ = std::make_unique<NodeEnvironment>(env);
+
+  // Add Electron extended APIs.
+  v8::Isolate* isolate = js_env_->isolate();
+  atom_bindings_->BindTo(isolate, env->process_object());
+
+  // Tell lib/utility/init.js what to load and how to reach the parent.
+  mate::Dictionary process(isolate, env->process_object());
+  process.Set("parentPort", api::ParentPort::Create(isolate, std::move(port),
+                                                    std::move(client)));
+  process.Set("_utilityModulePath", params->module_path);
+  process.Set("_utilityArgs", params->args);
+
+  // Load everything.
+  node_bindings_->LoadEnvironment(env);
+
+  // Wrap the uv loop with the environment.
+  node_bindings_->set_uv_env(env);
+
+  node_bindings_->PrepareMessageLoop();
+  node_bindings_->RunMessageLoop();
+}
+
+void NodeService::BindNodeServiceRequest(mojom::NodeServiceRequest request) {
+  // Every process runs a single environment.
+  if (binding_.is_bound())
+    return;
+
+  binding_.Bind(std::move(request));
+  binding_.set_connection_error_handler(base::BindOnce(
+      &NodeService::OnConnectionError, base::Unretained(this)));
+  service_ref_ = ref_factory_->CreateRef();
+}
+
+void NodeService::OnConnectionError() {
+  // Releasing the last reference quits the service and the process.
+  service_ref_.reset();
+}
+
+}  // namespace atom
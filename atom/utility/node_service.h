@@ -0,0 +1,64 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_UTILITY_NODE_SERVICE_H_
+#define ATOM_UTILITY_NODE_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "atom/common/node_service.mojom.h"
+#include "base/macros.h"
+#include "mojo/public/cpp/bindings/binding.h"
+#include "services/service_manager/public/cpp/binder_registry.h"
+#include "services/service_manager/public/cpp/service.h"
+#include "services/service_manager/public/cpp/service_context_ref.h"
+
+namespace atom {
+
+class AtomBindings;
+class JavascriptEnvironment;
+class NodeBindings;
+class NodeEnvironment;
+
+// Runs a Node environment in a utility process. Every instance of the
+// service gets its own process, which quits once the browser closes the pipe.
+class NodeService : public service_manager::Service, public mojom::NodeService {
+ public:
+  NodeService();
+  ~NodeService() override;
+
+  static std::unique_ptr<service_manager::Service> CreateService();
+
+  // service_manager::Service:
+  void OnStart() override;
+  void OnBindInterface(const service_manager::BindSourceInfo& source_info,
+                       const std::string& interface_name,
+                       mojo::ScopedMessagePipeHandle interface_pipe) override;
+
+  // mojom::NodeService:
+  void Initialize(mojom::NodeServiceParamsPtr params,
+                  mojom::NodeMessagePortRequest port,
+                  mojom::NodeMessagePortPtr client) override;
+
+ private:
+  void BindNodeServiceRequest(mojom::NodeServiceRequest request);
+  void OnConnectionError();
+
+  service_manager::BinderRegistry registry_;
+  std::unique_ptr<service_manager::ServiceContextRefFactory> ref_factory_;
+  std::unique_ptr<service_manager::ServiceContextRef> service_ref_;
+  mojo::Binding<mojom::NodeService> binding_;
+
+  std::unique_ptr<NodeBindings> node_bindings_;
+  std::unique_ptr<AtomBindings> atom_bindings_;
+  std::unique_ptr<JavascriptEnvironment> js_env_;
+  std::unique_ptr<NodeEnvironment> node_env_;
+
+  DISALLOW_COPY_AND_ASSIGN(NodeService);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_UTILITY_NODE_SERVICE_H_
@@ -8,7 +8,7 @@ const { app, App } = bindings
 module.exports = app
 
 const electron = require('electron')
-const { deprecate, Menu } = electron
+const { deprecate } = electron
 const { EventEmitter } = require('events')
 
 let dockMenu = null
@@ -19,10 +19,10 @@ EventEmitter.call(app)
 
 Object.assign(app, {
   setApplicationMenu (menu) {
-    return Menu.setApplicationMenu(menu)
+    return electron.Menu.setApplicationMenu(menu)
   },
   getApplicationMenu () {
-    return Menu.getApplicationMenu()
+    return electron.Menu.getApplicationMenu()
   },
   commandLine: {
     appendSwitch (...args) {
@@ -52,6 +52,21 @@ app.getAppMetrics = () => {
   return metrics
 }
 
+// The memory module is only loaded when it is used.
+const memoryInfo = () => require('@electron/internal/browser/memory-info')
+
+Object.assign(app, {
+  getProcessMemoryInfo () {
+    return memoryInfo().getProcessMemoryInfo(app)
+  },
+  startMemorySampler (filePath, options) {
+    memoryInfo().startMemorySampler(app, filePath, options)
+  },
+  stopMemorySampler () {
+    memoryInfo().stopMemorySampler()
+  }
+})
+
 app.isPackaged = (() => {
   const execFile = path.basename(process.execPath).toLowerCase()
   if (process.platform === 'win32') {
@@ -3,6 +3,10 @@
 const { EventEmitter } = require('events')
 const { BrowserView } = process.atomBinding('browser_view')
 
+// The native view creates a WebContents, whose prototype is only set up once
+// the webContents module is loaded.
+require('@electron/internal/browser/api/web-contents')
+
 Object.setPrototypeOf(BrowserView.prototype, EventEmitter.prototype)
 
 BrowserView.fromWebContents = (webContents) => {
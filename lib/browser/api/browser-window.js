@@ -6,6 +6,10 @@ const { BrowserWindow } = process.atomBinding('window')
 const v8Util = process.atomBinding('v8_util')
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
 
+// The native window creates a WebContents, whose prototype is only set up
+// once the webContents module is loaded.
+require('@electron/internal/browser/api/web-contents')
+
 Object.setPrototypeOf(BrowserWindow.prototype, TopLevelWindow.prototype)
 
 BrowserWindow.prototype._init = function () {
@@ -175,6 +179,19 @@ BrowserWindow.fromDevToolsWebContents = (webContents) => {
   }
 }
 
+// Extensions APIs, which can only be used after app is ready.
+const chromeExtension = require('@electron/internal/browser/chrome-extension')
+for (const method of [
+  'addExtension',
+  'removeExtension',
+  'getExtensions',
+  'addDevToolsExtension',
+  'removeDevToolsExtension',
+  'getDevToolsExtensions'
+]) {
+  BrowserWindow[method] = chromeExtension[method]
+}
+
 // Helpers.
 Object.assign(BrowserWindow.prototype, {
   loadURL (...args) {
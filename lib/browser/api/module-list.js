@@ -28,6 +28,7 @@ module.exports = [
   { name: 'TopLevelWindow', file: 'top-level-window' },
   { name: 'TouchBar', file: 'touch-bar' },
   { name: 'Tray', file: 'tray' },
+  { name: 'utilityProcess', file: 'utility-process' },
   { name: 'View', file: 'view' },
   { name: 'webContents', file: 'web-contents' },
   { name: 'WebContentsView', file: 'web-contents-view' },
@@ -8,6 +8,10 @@ const { Session } = process.atomBinding('session')
 const { net, Net } = process.atomBinding('net')
 const { URLRequest } = net
 
+// Requests may create a Session, whose prototype is only set up once the
+// session module is loaded.
+require('@electron/internal/browser/api/session')
+
 // Net is an EventEmitter.
 Object.setPrototypeOf(Net.prototype, EventEmitter.prototype)
 EventEmitter.call(net)
@@ -15,6 +19,7 @@ EventEmitter.call(net)
 Object.setPrototypeOf(URLRequest.prototype, EventEmitter.prototype)
 
 const kSupportedProtocols = new Set(['http:', 'https:'])
+const kRequestPriorities = new Set(['throttled', 'idle', 'lowest', 'low', 'medium', 'highest'])
 
 class IncomingMessage extends Readable {
   constructor (urlRequest) {
@@ -180,6 +185,21 @@ class ClientRequest extends EventEmitter {
       }
     }
 
+    if (options.priority != null) {
+      if (!kRequestPriorities.has(options.priority)) {
+        throw new Error('priority should be one of ' + [...kRequestPriorities].join(', '))
+      }
+      urlRequestOptions.priority = options.priority
+    }
+
+    let highWaterMark = Infinity
+    if (options.highWaterMark != null) {
+      if (typeof options.highWaterMark !== 'number' || options.highWaterMark < 0) {
+        throw new TypeError('`highWaterMark` should be a non-negative number.')
+      }
+      highWaterMark = options.highWaterMark
+    }
+
     const urlRequest = new URLRequest(urlRequestOptions)
 
     // Set back and forward links.
@@ -201,6 +221,21 @@ class ClientRequest extends EventEmitter {
     // to true only once and never set back to false.
     this.chunkedEncodingEnabled = false
 
+    // Number of chunked upload bytes handed to the network thread that have
+    // not been sent yet. Non-chunked bodies are held in full until end() is
+    // called, so they never apply back-pressure.
+    this.writableHighWaterMark = highWaterMark
+    this.writableLength = 0
+    this.needDrain = false
+
+    urlRequest.on('upload-data-consumed', (event, bytesConsumed) => {
+      this.writableLength = Math.max(0, this.writableLength - bytesConsumed)
+      if (this.needDrain && this.writableLength < this.writableHighWaterMark) {
+        this.needDrain = false
+        this.emit('drain')
+      }
+    })
+
     urlRequest.on('response', () => {
       const response = new IncomingMessage(urlRequest)
       urlRequest._response = response
@@ -258,6 +293,13 @@ class ClientRequest extends EventEmitter {
     this.urlRequest.setExtraHeader(name, value.toString())
   }
 
+  setPriority (priority) {
+    if (!kRequestPriorities.has(priority)) {
+      throw new Error('priority should be one of ' + [...kRequestPriorities].join(', '))
+    }
+    this.urlRequest.setPriority(priority)
+  }
+
   getHeader (name) {
     if (name == null) {
       throw new Error('`name` is required for getHeader(name).')
@@ -301,7 +343,10 @@ class ClientRequest extends EventEmitter {
     // assume that request headers are written after delivering the first
     // buffer to the network IO thread.
     if (this.urlRequest.notStarted) {
-      this.urlRequest.setChunkedUpload(this.chunkedEncoding)
+      // Only a finite highWaterMark needs the consumed bytes, other chunked
+      // bodies are kept so that they can be sent again after a redirect.
+      this.urlRequest.setChunkedUpload(this.chunkedEncoding,
+        this.writableHighWaterMark !== Infinity)
     }
 
     // Headers are assumed to be sent on first call to _writeBuffer,
@@ -313,7 +358,19 @@ class ClientRequest extends EventEmitter {
       process.nextTick(callback)
     }
 
-    return result
+    if (!result) {
+      return false
+    }
+
+    if (this.chunkedEncoding && this.writableHighWaterMark !== Infinity) {
+      this.writableLength += chunk.length
+      if (!isLast && this.writableLength >= this.writableHighWaterMark) {
+        this.needDrain = true
+        return false
+      }
+    }
+
+    return true
   }
 
   write (data, encoding, callback) {
@@ -345,6 +402,37 @@ class ClientRequest extends EventEmitter {
     return this._write(data, encoding, callback, true)
   }
 
+  writeFile (file, options) {
+    if (this.urlRequest.finished) {
+      throw new Error('Write after end.')
+    }
+    if (this.chunkedEncoding) {
+      throw new Error('writeFile can not be used with chunked encoding.')
+    }
+
+    options = options || {}
+    const offset = options.offset || 0
+    const length = options.length != null ? options.length : Number.MAX_SAFE_INTEGER
+    if (typeof offset !== 'number' || offset < 0) {
+      throw new TypeError('`offset` should be a non-negative number.')
+    }
+    if (typeof length !== 'number' || length < 0) {
+      throw new TypeError('`length` should be a non-negative number.')
+    }
+
+    if (this.urlRequest.notStarted) {
+      this.urlRequest.setChunkedUpload(false, false)
+    }
+
+    if (typeof file === 'string') {
+      return this.urlRequest.writeFile(file, offset, length)
+    } else if (typeof file === 'number') {
+      return this.urlRequest.writeFileDescriptor(file, offset, length)
+    } else {
+      throw new TypeError('First argument must be a file path or a file descriptor.')
+    }
+  }
+
   followRedirect () {
     this.urlRequest.followRedirect()
   }
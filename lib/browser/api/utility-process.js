@@ -0,0 +1,13 @@
+'use strict'
+
+const { EventEmitter } = require('events')
+const { fork, UtilityProcess } = process.atomBinding('utility_process')
+
+// UtilityProcess is an EventEmitter.
+Object.setPrototypeOf(UtilityProcess.prototype, EventEmitter.prototype)
+
+exports.fork = function (modulePath, args) {
+  const child = fork(modulePath, args || [])
+  EventEmitter.call(child)
+  return child
+}
@@ -1,8 +1,7 @@
 'use strict'
 
-const { app, webContents, BrowserWindow } = require('electron')
-const { getAllWebContents } = process.atomBinding('web_contents')
-const renderProcessPreferences = process.atomBinding('render_process_preferences').forAllWebContents()
+const electron = require('electron')
+const { app } = electron
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
 
 const { Buffer } = require('buffer')
@@ -86,7 +85,7 @@ const startBackgroundPages = function (manifest) {
     html = Buffer.from(`<html><body>${scripts}</body></html>`)
   }
 
-  const contents = webContents.create({
+  const contents = electron.webContents.create({
     partition: 'persist:__chrome_extension',
     isBackgroundPage: true,
     commandLineSwitches: ['--background-page']
@@ -186,7 +185,7 @@ ipcMain.on('CHROME_RUNTIME_SENDMESSAGE', function (event, extensionId, message,
 })
 
 ipcMain.on('CHROME_TABS_SEND_MESSAGE', function (event, tabId, extensionId, isBackgroundPage, message, originResultID) {
-  const contents = webContents.fromId(tabId)
+  const contents = electron.webContents.fromId(tabId)
   if (!contents) {
     console.error(`Sending message to unknown tab ${tabId}`)
     return
@@ -202,7 +201,7 @@ ipcMain.on('CHROME_TABS_SEND_MESSAGE', function (event, tabId, extensionId, isBa
 })
 
 ipcMain.on('CHROME_TABS_EXECUTESCRIPT', function (event, requestId, tabId, extensionId, details) {
-  const contents = webContents.fromId(tabId)
+  const contents = electron.webContents.fromId(tabId)
   if (!contents) {
     console.error(`Sending message to unknown tab ${tabId}`)
     return
@@ -224,6 +223,16 @@ ipcMain.on('CHROME_TABS_EXECUTESCRIPT', function (event, requestId, tabId, exten
 // Transfer the content scripts to renderer.
 const contentScripts = {}
 
+// Created on first use, so renderers are not checked for content scripts
+// until an extension is loaded.
+let renderProcessPreferences = null
+const getRenderProcessPreferences = function () {
+  if (renderProcessPreferences === null) {
+    renderProcessPreferences = process.atomBinding('render_process_preferences').forAllWebContents()
+  }
+  return renderProcessPreferences
+}
+
 const injectContentScripts = function (manifest) {
   if (contentScripts[manifest.name] || !manifest.content_scripts) return
 
@@ -248,7 +257,7 @@ const injectContentScripts = function (manifest) {
       extensionId: manifest.extensionId,
       contentScripts: manifest.content_scripts.map(contentScriptToEntry)
     }
-    contentScripts[manifest.name] = renderProcessPreferences.addEntry(entry)
+    contentScripts[manifest.name] = getRenderProcessPreferences().addEntry(entry)
   } catch (e) {
     console.error('Failed to read content scripts', e)
   }
@@ -257,7 +266,7 @@ const injectContentScripts = function (manifest) {
 const removeContentScripts = function (manifest) {
   if (!contentScripts[manifest.name]) return
 
-  renderProcessPreferences.removeEntry(contentScripts[manifest.name])
+  getRenderProcessPreferences().removeEntry(contentScripts[manifest.name])
   delete contentScripts[manifest.name]
 }
 
@@ -358,64 +367,65 @@ app.on('will-quit', function () {
   }
 })
 
-// We can not use protocol or BrowserWindow until app is ready.
-app.once('ready', function () {
-  // The public API to add/remove extensions.
-  BrowserWindow.addExtension = function (srcDirectory) {
-    const manifest = getManifestFromPath(srcDirectory)
-    if (manifest) {
-      loadExtension(manifest)
-      for (const webContents of getAllWebContents()) {
-        if (isWindowOrWebView(webContents)) {
-          loadDevToolsExtensions(webContents, [manifest])
-        }
+// The public API to add/remove extensions, exposed as static methods of
+// BrowserWindow so it is only loaded once windows are used.
+exports.addExtension = function (srcDirectory) {
+  const manifest = getManifestFromPath(srcDirectory)
+  if (manifest) {
+    loadExtension(manifest)
+    for (const webContents of electron.webContents.getAllWebContents()) {
+      if (isWindowOrWebView(webContents)) {
+        loadDevToolsExtensions(webContents, [manifest])
       }
-      return manifest.name
     }
+    return manifest.name
   }
+}
 
-  BrowserWindow.removeExtension = function (name) {
-    const manifest = manifestNameMap[name]
-    if (!manifest) return
+exports.removeExtension = function (name) {
+  const manifest = manifestNameMap[name]
+  if (!manifest) return
 
-    removeBackgroundPages(manifest)
-    removeContentScripts(manifest)
-    delete manifestMap[manifest.extensionId]
-    delete manifestNameMap[name]
-  }
+  removeBackgroundPages(manifest)
+  removeContentScripts(manifest)
+  delete manifestMap[manifest.extensionId]
+  delete manifestNameMap[name]
+}
 
-  BrowserWindow.getExtensions = function () {
-    const extensions = {}
-    Object.keys(manifestNameMap).forEach(function (name) {
-      const manifest = manifestNameMap[name]
-      extensions[name] = { name: manifest.name, version: manifest.version }
-    })
-    return extensions
-  }
+exports.getExtensions = function () {
+  const extensions = {}
+  Object.keys(manifestNameMap).forEach(function (name) {
+    const manifest = manifestNameMap[name]
+    extensions[name] = { name: manifest.name, version: manifest.version }
+  })
+  return extensions
+}
 
-  BrowserWindow.addDevToolsExtension = function (srcDirectory) {
-    const manifestName = BrowserWindow.addExtension(srcDirectory)
-    if (manifestName) {
-      devToolsExtensionNames.add(manifestName)
-    }
-    return manifestName
+exports.addDevToolsExtension = function (srcDirectory) {
+  const manifestName = exports.addExtension(srcDirectory)
+  if (manifestName) {
+    devToolsExtensionNames.add(manifestName)
   }
+  return manifestName
+}
 
-  BrowserWindow.removeDevToolsExtension = function (name) {
-    BrowserWindow.removeExtension(name)
-    devToolsExtensionNames.delete(name)
-  }
+exports.removeDevToolsExtension = function (name) {
+  exports.removeExtension(name)
+  devToolsExtensionNames.delete(name)
+}
 
-  BrowserWindow.getDevToolsExtensions = function () {
-    const extensions = BrowserWindow.getExtensions()
-    const devExtensions = {}
-    Array.from(devToolsExtensionNames).forEach(function (name) {
-      if (!extensions[name]) return
-      devExtensions[name] = extensions[name]
-    })
-    return devExtensions
-  }
+exports.getDevToolsExtensions = function () {
+  const extensions = exports.getExtensions()
+  const devExtensions = {}
+  Array.from(devToolsExtensionNames).forEach(function (name) {
+    if (!extensions[name]) return
+    devExtensions[name] = extensions[name]
+  })
+  return devExtensions
+}
 
+// We can not use protocol or BrowserWindow until app is ready.
+app.once('ready', function () {
   // Load persisted extensions.
   loadedDevToolsExtensionsPath = path.join(app.getPath('userData'), 'DevTools Extensions')
   try {
@@ -423,7 +433,7 @@ app.once('ready', function () {
     if (Array.isArray(loadedDevToolsExtensions)) {
       for (const srcDirectory of loadedDevToolsExtensions) {
         // Start background pages and set content scripts.
-        BrowserWindow.addDevToolsExtension(srcDirectory)
+        exports.addDevToolsExtension(srcDirectory)
       }
     }
   } catch (error) {
@@ -1,7 +1,16 @@
 'use strict'
 
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
-const { desktopCapturer } = process.atomBinding('desktop_capturer')
+
+// The native capturer is created on the first request.
+let desktopCapturer = null
+const getDesktopCapturer = function () {
+  if (desktopCapturer === null) {
+    desktopCapturer = process.atomBinding('desktop_capturer').desktopCapturer
+    desktopCapturer.emit = onSourcesCaptured
+  }
+  return desktopCapturer
+}
 
 const deepEqual = (a, b) => JSON.stringify(a) === JSON.stringify(b)
 
@@ -23,7 +32,7 @@ ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize,
   }
   requestsQueue.push(request)
   if (requestsQueue.length === 1) {
-    desktopCapturer.startHandling(captureWindow, captureScreen, thumbnailSize)
+    getDesktopCapturer().startHandling(captureWindow, captureScreen, thumbnailSize)
   }
 
   // If the WebContents is destroyed before receiving result, just remove the
@@ -33,7 +42,7 @@ ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize,
   })
 })
 
-desktopCapturer.emit = (event, name, sources) => {
+const onSourcesCaptured = (event, name, sources) => {
   // Receiving sources result from main process, now send them back to renderer.
   const handledRequest = requestsQueue.shift()
   const handledWebContents = handledRequest.webContents
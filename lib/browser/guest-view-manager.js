@@ -1,6 +1,6 @@
 'use strict'
 
-const { webContents } = require('electron')
+const electron = require('electron')
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
 const parseFeaturesString = require('@electron/internal/common/parse-features-string')
 
@@ -60,7 +60,7 @@ const createGuest = function (embedder, params) {
   }
 
   const guestInstanceId = getNextGuestInstanceId(embedder)
-  const guest = webContents.create({
+  const guest = electron.webContents.create({
     isGuest: true,
     partition: params.partition,
     embedder: embedder
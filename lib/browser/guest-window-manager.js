@@ -1,6 +1,6 @@
 'use strict'
 
-const { BrowserWindow, webContents } = require('electron')
+const electron = require('electron')
 const { isSameOrigin } = process.atomBinding('v8_util')
 const ipcMain = require('@electron/internal/browser/ipc-main-internal')
 const parseFeaturesString = require('@electron/internal/common/parse-features-string')
@@ -52,7 +52,7 @@ const mergeBrowserWindowOptions = function (embedder, options) {
     let parentOptions = embedder.browserWindowOptions
 
     // if parent's visibility is available, that overrides 'show' flag (#12125)
-    const win = BrowserWindow.fromWebContents(embedder.webContents)
+    const win = electron.BrowserWindow.fromWebContents(embedder.webContents)
     if (win != null) {
       parentOptions = { ...embedder.browserWindowOptions, show: win.isVisible() }
     }
@@ -117,7 +117,7 @@ const createGuest = function (embedder, url, referrer, frameName, options, postD
     options.webPreferences = {}
   }
 
-  guest = new BrowserWindow(options)
+  guest = new electron.BrowserWindow(options)
   if (!options.webContents || url !== 'about:blank') {
     // We should not call `loadURL` if the window was constructed from an
     // existing webContents(window.open in a sandboxed renderer) and if the url
@@ -161,11 +161,11 @@ const createGuest = function (embedder, url, referrer, frameName, options, postD
 }
 
 const getGuestWindow = function (guestContents) {
-  let guestWindow = BrowserWindow.fromWebContents(guestContents)
+  let guestWindow = electron.BrowserWindow.fromWebContents(guestContents)
   if (guestWindow == null) {
     const hostContents = guestContents.hostWebContents
     if (hostContents != null) {
-      guestWindow = BrowserWindow.fromWebContents(hostContents)
+      guestWindow = electron.BrowserWindow.fromWebContents(hostContents)
     }
   }
   return guestWindow
@@ -276,7 +276,7 @@ ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_INTERNAL_WINDOW_OPEN', function (event
 })
 
 ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_CLOSE', function (event, guestId) {
-  const guestContents = webContents.fromId(guestId)
+  const guestContents = electron.webContents.fromId(guestId)
   if (guestContents == null) return
 
   if (!canAccessWindow(event.sender, guestContents)) {
@@ -289,7 +289,7 @@ ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_CLOSE', function (event, guestI
 })
 
 ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_METHOD', function (event, guestId, method, ...args) {
-  const guestContents = webContents.fromId(guestId)
+  const guestContents = electron.webContents.fromId(guestId)
   if (guestContents == null) {
     event.returnValue = null
     return
@@ -314,7 +314,7 @@ ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_POSTMESSAGE', function (event,
     targetOrigin = '*'
   }
 
-  const guestContents = webContents.fromId(guestId)
+  const guestContents = electron.webContents.fromId(guestId)
   if (guestContents == null) return
 
   // The W3C does not seem to have word on how postMessage should work when the
@@ -327,7 +327,7 @@ ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WINDOW_POSTMESSAGE', function (event,
 })
 
 ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WEB_CONTENTS_METHOD', function (event, guestId, method, ...args) {
-  const guestContents = webContents.fromId(guestId)
+  const guestContents = electron.webContents.fromId(guestId)
   if (guestContents == null) return
 
   if (canAccessWindow(event.sender, guestContents)) {
@@ -338,7 +338,7 @@ ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WEB_CONTENTS_METHOD', function (event,
 })
 
 ipcMain.on('ELECTRON_GUEST_WINDOW_MANAGER_WEB_CONTENTS_METHOD_SYNC', function (event, guestId, method, ...args) {
-  const guestContents = webContents.fromId(guestId)
+  const guestContents = electron.webContents.fromId(guestId)
   if (guestContents == null) {
     event.returnValue = null
     return
@@ -158,9 +158,6 @@ if (features.isDesktopCapturerEnabled()) {
   require('@electron/internal/browser/desktop-capturer')
 }
 
-// Load protocol module to ensure it is populated on app ready
-require('@electron/internal/browser/api/protocol')
-
 // Set main startup script of the app.
 const mainStartupScript = packageJson.main || 'index.js'
 
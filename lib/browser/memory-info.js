@@ -0,0 +1,152 @@
+'use strict'
+
+const electron = require('electron')
+const fs = require('fs')
+const ipcMainInternal = require('@electron/internal/browser/ipc-main-internal')
+
+// A hung renderer should not keep the memory of the other processes from
+// being reported.
+const RENDERER_TIMEOUT = 5000
+
+// The columns of the rows written by the sampler, sizes are in kilobytes.
+const COLUMNS = [
+  'time',
+  'pid',
+  'type',
+  'residentSet',
+  'private',
+  'shared',
+  'swapped',
+  'v8TotalHeapSize',
+  'v8UsedHeapSize',
+  'v8ExternalMemory',
+  'blinkPartitionAlloc',
+  'blinkGC',
+  'blinkCache'
+]
+
+let nextId = 0
+
+const getRendererMemoryUsage = function (contents) {
+  return new Promise((resolve) => {
+    const channel = `ELECTRON_GET_MEMORY_USAGE_RESULT_${++nextId}`
+    const timeout = setTimeout(() => {
+      ipcMainInternal.removeAllListeners(channel)
+      resolve(null)
+    }, RENDERER_TIMEOUT)
+    ipcMainInternal.once(channel, (event, usage) => {
+      clearTimeout(timeout)
+      resolve(usage)
+    })
+    if (!contents._getMemoryUsage(channel)) {
+      ipcMainInternal.emit(channel, null, null)
+    }
+  })
+}
+
+const getProcessMemoryInfo = function (app) {
+  // The frames of a renderer process share its isolate, asking one of them is
+  // enough.
+  const renderers = new Map()
+  for (const contents of electron.webContents.getAllWebContents()) {
+    const pid = contents.getOSProcessId()
+    if (pid && !renderers.has(pid) && !contents.isCrashed()) {
+      renderers.set(pid, contents)
+    }
+  }
+
+  return Promise.all([
+    app._getProcessMemoryInfo(),
+    ...Array.from(renderers.values(), getRendererMemoryUsage)
+  ]).then(([processes, ...usages]) => {
+    const pids = Array.from(renderers.keys())
+    for (const info of processes) {
+      const usage = usages[pids.indexOf(info.pid)]
+      if (usage) Object.assign(info, usage)
+    }
+    return processes
+  })
+}
+
+const toRow = function (time, { pid, type, memory, v8, blink }) {
+  const value = (object, key) => (object && key in object) ? object[key] : null
+  let cache = null
+  if (blink) {
+    cache = Object.keys(blink.cache).reduce((sum, key) => sum + blink.cache[key], 0)
+  }
+  return [
+    time,
+    pid,
+    type,
+    value(memory, 'residentSet'),
+    value(memory, 'private'),
+    value(memory, 'shared'),
+    value(memory, 'swapped'),
+    value(v8, 'totalHeapSize'),
+    value(v8, 'usedHeapSize'),
+    value(v8, 'externalMemory'),
+    value(blink, 'partitionAlloc'),
+    value(blink, 'blinkGC'),
+    cache
+  ]
+}
+
+// Appends the memory of every process to a file at a fixed interval. The
+// file starts with a line listing the columns, followed by one JSON array per
+// process and sample.
+class MemorySampler {
+  constructor (app, filePath, interval) {
+    this.app = app
+    this.pending = false
+    this.stream = fs.createWriteStream(filePath, { flags: 'a' })
+    this.stream.on('error', () => this.stop())
+    this.stream.write(`${JSON.stringify({ columns: COLUMNS })}\n`)
+    this.timer = setInterval(() => this.sample(), interval)
+    this.sample()
+  }
+
+  sample () {
+    // Skip the sample while a slow renderer holds up the previous one.
+    if (this.pending) return
+    this.pending = true
+    getProcessMemoryInfo(this.app).then((processes) => {
+      this.pending = false
+      if (this.timer === null) return
+      const time = Date.now()
+      const rows = processes.map((info) => JSON.stringify(toRow(time, info)))
+      this.stream.write(`${rows.join('\n')}\n`)
+    }, () => {
+      this.pending = false
+    })
+  }
+
+  stop () {
+    if (this.timer === null) return
+    clearInterval(this.timer)
+    this.timer = null
+    this.stream.end()
+  }
+}
+
+let sampler = null
+
+exports.getProcessMemoryInfo = getProcessMemoryInfo
+
+exports.startMemorySampler = function (app, filePath, options = {}) {
+  const { interval = 60000 } = options
+  if (typeof filePath !== 'string') {
+    throw new TypeError('path must be a string')
+  }
+  if (typeof interval !== 'number' || !(interval > 0)) {
+    throw new TypeError('interval must be a positive number')
+  }
+  exports.stopMemorySampler()
+  sampler = new MemorySampler(app, filePath, interval)
+}
+
+exports.stopMemorySampler = function () {
+  if (sampler) {
+    sampler.stop()
+    sampler = null
+  }
+}
@@ -1,15 +1,21 @@
 'use strict'
 
 module.exports = function atomBindingSetup (binding, processType) {
+  // Bindings are only initialized on their first request, remember which name
+  // they resolved to so common modules don't throw on every later request.
+  const cache = Object.create(null)
+
   return function atomBinding (name) {
+    if (name in cache) return cache[name]
     try {
-      return binding(`atom_${processType}_${name}`)
+      cache[name] = binding(`atom_${processType}_${name}`)
     } catch (error) {
       if (/No such module/.test(error.message)) {
-        return binding(`atom_common_${name}`)
+        cache[name] = binding(`atom_common_${name}`)
       } else {
         throw error
       }
     }
+    return cache[name]
   }
 }
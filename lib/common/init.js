@@ -33,11 +33,11 @@ process.nextTick = wrapWithActivateUvLoop(process.nextTick)
 global.setImmediate = wrapWithActivateUvLoop(timers.setImmediate)
 global.clearImmediate = timers.clearImmediate
 
-if (process.type === 'browser') {
+if (process.type === 'browser' || process.type === 'utility') {
   // setTimeout needs to update the polling timeout of the event loop, when
   // called under Chromium's event loop the node's event loop won't get a chance
   // to update the timeout, so we have to force the node's event loop to
-  // recalculate the timeout in browser process.
+  // recalculate the timeout in browser and utility processes.
   global.setTimeout = wrapWithActivateUvLoop(timers.setTimeout)
   global.setInterval = wrapWithActivateUvLoop(timers.setInterval)
 }
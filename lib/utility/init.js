@@ -0,0 +1,39 @@
+'use strict'
+
+const { EventEmitter } = require('events')
+const path = require('path')
+const Module = require('module')
+
+// We modified the original process.argv to let node.js load the
+// init.js, we need to restore it here.
+process.argv.splice(1, 1)
+
+// Clear search paths.
+require('../common/reset-search-paths')
+
+// Import common settings.
+require('@electron/internal/common/init')
+
+// The parentPort is an EventEmitter.
+Object.setPrototypeOf(Object.getPrototypeOf(process.parentPort), EventEmitter.prototype)
+EventEmitter.call(process.parentPort)
+
+// Quit on fatal error like node does.
+process.on('uncaughtException', function (error) {
+  // Do nothing if the user has a custom uncaught exception handler.
+  if (process.listeners('uncaughtException').length > 1) {
+    return
+  }
+
+  console.error(error.stack ? error.stack : `${error.name}: ${error.message}`)
+  process.exit(1)
+})
+
+// Expose the module path and the arguments like node does for scripts.
+const modulePath = path.resolve(process._utilityModulePath)
+process.argv = [process.execPath, modulePath, ...process._utilityArgs]
+delete process._utilityModulePath
+delete process._utilityArgs
+
+// Finally load the module.
+Module._load(modulePath, Module, true)
@@ -0,0 +1,52 @@
+#!/usr/bin/env node
+
+// Converts frames of common resolutions with nativeImage.toBitmap and prints
+// the throughput of each conversion.
+//
+// Usage: node script/benchmark-pixel-pipeline.js [--iterations=10]
+
+const childProcess = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const BASE = path.resolve(__dirname, '../..')
+const APP = path.join(__dirname, 'pixel-pipeline-benchmark-app')
+
+function parseArgs (argv) {
+  const args = { iterations: 10 }
+  for (const arg of argv) {
+    const [key, value] = arg.replace(/^--/, '').split('=')
+    if (key === 'iterations') {
+      args[key] = parseInt(value, 10)
+    } else {
+      throw new Error(`Unknown argument ${arg}`)
+    }
+  }
+  if (!(args.iterations > 0)) throw new Error('--iterations must be a positive number')
+  return args
+}
+
+function run (exe, iterations) {
+  const { status, stdout } = childProcess.spawnSync(exe, [
+    APP, String(iterations)
+  ], { stdio: ['ignore', 'pipe', 'inherit'], encoding: 'utf8' })
+  if (status !== 0) {
+    throw new Error(`Benchmark app exited with code ${status}`)
+  }
+  const lines = stdout.trim().split('\n')
+  return JSON.parse(lines[lines.length - 1])
+}
+
+function main () {
+  const args = parseArgs(process.argv.slice(2))
+  const exe = path.resolve(BASE, utils.getElectronExec())
+
+  console.log(`${args.iterations} conversions per frame, MB/s`)
+  console.log(`${'resolution'.padEnd(12)}${'conversion'.padEnd(24)}${'MB/s'.padStart(9)}`)
+  for (const result of run(exe, args.iterations)) {
+    console.log(`${result.resolution.padEnd(12)}${result.conversion.padEnd(24)}${result.throughput.toFixed(0).padStart(9)}`)
+  }
+}
+
+main()
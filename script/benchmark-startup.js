@@ -0,0 +1,169 @@
+#!/usr/bin/env node
+
+// Launches an app several times with --startup-timeline-file and prints the
+// percentiles of every startup mark.
+//
+// Usage: node script/benchmark-startup.js [--runs=20] [--app=path|minimal]
+//          [--budget=first-paint:1500] [--baseline=path/to/electron]
+//
+// With --budget the script fails when the median of the mark is slower than
+// the given number of milliseconds, so it can gate releases.
+//
+// With --baseline the runs alternate between the built executable and the
+// given one, and the medians of both are printed side by side. Use it with
+// --app=minimal, which quits on ready, to compare the time to ready.
+//
+// The benchmark apps also print a marker on ready, and the time from
+// spawning the process to reading it is reported as the "ready (outside
+// process)" mark. Builds without --startup-timeline-file, like baselines from
+// before the startup timeline existed, only report that mark.
+
+const childProcess = require('child_process')
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const BASE = path.resolve(__dirname, '../..')
+
+// Printed by the benchmark apps once the app is ready.
+const READY_MARKER = 'startup-benchmark-ready'
+const OUTSIDE_READY_MARK = 'ready (outside process)'
+
+function parseArgs (argv) {
+  const args = {
+    runs: 20,
+    app: path.join(__dirname, 'startup-benchmark-app'),
+    budgets: {},
+    baseline: null
+  }
+  for (const arg of argv) {
+    const [key, value] = arg.replace(/^--/, '').split('=')
+    if (key === 'runs') {
+      args.runs = parseInt(value, 10)
+    } else if (key === 'app') {
+      args.app = value === 'minimal'
+        ? path.join(__dirname, 'startup-benchmark-minimal-app')
+        : path.resolve(value)
+    } else if (key === 'baseline') {
+      args.baseline = path.resolve(value)
+    } else if (key === 'budget') {
+      const [mark, ms] = value.split(':')
+      args.budgets[mark] = parseFloat(ms)
+    } else {
+      throw new Error(`Unknown argument ${arg}`)
+    }
+  }
+  if (!(args.runs > 0)) throw new Error('--runs must be a positive number')
+  return args
+}
+
+async function runOnce (exe, app, run) {
+  const traceFile = path.join(os.tmpdir(), `electron-startup-${process.pid}-${run}.json`)
+  const start = process.hrtime()
+  const child = childProcess.spawn(exe, [
+    `--startup-timeline-file=${traceFile}`,
+    app
+  ], { stdio: ['ignore', 'pipe', 'inherit'] })
+
+  const marks = {}
+  let output = ''
+  child.stdout.on('data', (data) => {
+    process.stdout.write(data)
+    output += data
+    if (!(OUTSIDE_READY_MARK in marks) && output.includes(READY_MARKER)) {
+      const [seconds, nanoseconds] = process.hrtime(start)
+      marks[OUTSIDE_READY_MARK] = seconds * 1000 + nanoseconds / 1e6
+    }
+  })
+  const status = await new Promise((resolve, reject) => {
+    child.on('error', reject)
+    child.on('close', resolve)
+  })
+  if (status !== 0) {
+    throw new Error(`Run ${run} exited with code ${status}`)
+  }
+
+  // Executables without --startup-timeline-file ignore it.
+  if (!fs.existsSync(traceFile)) {
+    if (!(OUTSIDE_READY_MARK in marks)) {
+      throw new Error(`Run ${run} wrote no startup timeline and printed no ready marker`)
+    }
+    return marks
+  }
+  const trace = JSON.parse(fs.readFileSync(traceFile, 'utf8'))
+  fs.unlinkSync(traceFile)
+
+  // Only the first occurrence of repeated marks counts.
+  for (const event of trace.traceEvents) {
+    if (!(event.name in marks)) marks[event.name] = event.ts / 1000
+  }
+  return marks
+}
+
+function percentile (sorted, p) {
+  const index = Math.min(sorted.length - 1, Math.ceil(p / 100 * sorted.length) - 1)
+  return sorted[Math.max(0, index)]
+}
+
+function collect (samples, marks) {
+  for (const name of Object.keys(marks)) {
+    if (!samples[name]) samples[name] = []
+    samples[name].push(marks[name])
+  }
+}
+
+async function main () {
+  const args = parseArgs(process.argv.slice(2))
+  const exe = path.resolve(BASE, utils.getElectronExec())
+
+  const samples = {}
+  const baselineSamples = {}
+  for (let run = 0; run < args.runs; run++) {
+    collect(samples, await runOnce(exe, args.app, run))
+    if (args.baseline) {
+      collect(baselineSamples, await runOnce(args.baseline, args.app, run))
+    }
+  }
+
+  const format = (ms) => ms.toFixed(1).padStart(9)
+  console.log(`${args.runs} runs of ${args.app}, milliseconds since launch`)
+  const medians = {}
+  if (args.baseline) {
+    console.log(`${'mark'.padEnd(28)}${'p50'.padStart(9)}${'baseline'.padStart(9)}${'delta'.padStart(9)}`)
+  } else {
+    console.log(`${'mark'.padEnd(28)}${'p50'.padStart(9)}${'p90'.padStart(9)}${'p99'.padStart(9)}`)
+  }
+  for (const name of Object.keys(samples)) {
+    const sorted = samples[name].sort((a, b) => a - b)
+    medians[name] = percentile(sorted, 50)
+    if (args.baseline) {
+      if (!baselineSamples[name]) {
+        console.log(`${name.padEnd(28)}${format(medians[name])}${'-'.padStart(9)}${'-'.padStart(9)}`)
+        continue
+      }
+      const baseline = percentile(baselineSamples[name].sort((a, b) => a - b), 50)
+      console.log(`${name.padEnd(28)}${format(medians[name])}${format(baseline)}${format(medians[name] - baseline)}`)
+    } else {
+      console.log(`${name.padEnd(28)}${format(medians[name])}${format(percentile(sorted, 90))}${format(percentile(sorted, 99))}`)
+    }
+  }
+
+  let failed = false
+  for (const name of Object.keys(args.budgets)) {
+    if (!(name in medians)) {
+      console.error(`Mark ${name} was never recorded`)
+      failed = true
+    } else if (medians[name] > args.budgets[name]) {
+      console.error(`Mark ${name} took ${medians[name].toFixed(1)} ms, the budget is ${args.budgets[name]} ms`)
+      failed = true
+    }
+  }
+  if (failed) process.exit(1)
+}
+
+main().catch((error) => {
+  console.error(error)
+  process.exit(1)
+})
@@ -0,0 +1,60 @@
+#!/usr/bin/env node
+
+// Opens windows with and without spare renderers and prints the percentiles
+// of the time from `new BrowserWindow` to 'ready-to-show'.
+//
+// Usage: node script/benchmark-window-open.js [--windows=20] [--spares=1]
+
+const childProcess = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const BASE = path.resolve(__dirname, '../..')
+const APP = path.join(__dirname, 'window-open-benchmark-app')
+
+function parseArgs (argv) {
+  const args = { windows: 20, spares: 1 }
+  for (const arg of argv) {
+    const [key, value] = arg.replace(/^--/, '').split('=')
+    if (key === 'windows' || key === 'spares') {
+      args[key] = parseInt(value, 10)
+    } else {
+      throw new Error(`Unknown argument ${arg}`)
+    }
+  }
+  if (!(args.windows > 0)) throw new Error('--windows must be a positive number')
+  if (!(args.spares > 0)) throw new Error('--spares must be a positive number')
+  return args
+}
+
+function run (exe, windows, spares) {
+  const { status, stdout } = childProcess.spawnSync(exe, [
+    APP, String(windows), String(spares)
+  ], { stdio: ['ignore', 'pipe', 'inherit'], encoding: 'utf8' })
+  if (status !== 0) {
+    throw new Error(`Benchmark app exited with code ${status}`)
+  }
+  const lines = stdout.trim().split('\n')
+  return JSON.parse(lines[lines.length - 1]).sort((a, b) => a - b)
+}
+
+function percentile (sorted, p) {
+  const index = Math.min(sorted.length - 1, Math.ceil(p / 100 * sorted.length) - 1)
+  return sorted[Math.max(0, index)]
+}
+
+function main () {
+  const args = parseArgs(process.argv.slice(2))
+  const exe = path.resolve(BASE, utils.getElectronExec())
+
+  const format = (ms) => ms.toFixed(1).padStart(9)
+  console.log(`${args.windows} windows, milliseconds to 'ready-to-show'`)
+  console.log(`${'spares'.padEnd(10)}${'p50'.padStart(9)}${'p90'.padStart(9)}${'p99'.padStart(9)}`)
+  for (const spares of [0, args.spares]) {
+    const sorted = run(exe, args.windows, spares)
+    console.log(`${String(spares).padEnd(10)}${format(percentile(sorted, 50))}${format(percentile(sorted, 90))}${format(percentile(sorted, 99))}`)
+  }
+}
+
+main()
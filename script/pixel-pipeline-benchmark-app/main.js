@@ -0,0 +1,44 @@
+const { app, nativeImage } = require('electron')
+
+// Converts frames of common resolutions with nativeImage.toBitmap and prints
+// the throughput of each conversion in MB/s as JSON.
+const iterations = parseInt(process.argv[2], 10)
+
+const resolutions = [
+  { name: '720p', width: 1280, height: 720 },
+  { name: '1080p', width: 1920, height: 1080 },
+  { name: '4K', width: 3840, height: 2160 }
+]
+const conversions = [
+  { name: 'copy', options: {} },
+  { name: 'rgba', options: { format: 'rgba' } },
+  { name: 'unpremultiplied rgba', options: { format: 'rgba', premultiplied: false } },
+  { name: 'half size rgba', options: { format: 'rgba' }, scale: 0.5 }
+]
+
+app.on('ready', () => {
+  const results = []
+  for (const { name, width, height } of resolutions) {
+    const frame = nativeImage.createFromBuffer(
+      Buffer.alloc(width * height * 4, 0xc0), { width, height })
+    for (const conversion of conversions) {
+      const options = Object.assign({}, conversion.options)
+      if (conversion.scale) options.width = width * conversion.scale
+
+      // Warm up the allocator and the caches.
+      frame.toBitmap(options)
+      const start = process.hrtime()
+      for (let i = 0; i < iterations; i++) frame.toBitmap(options)
+      const [seconds, nanoseconds] = process.hrtime(start)
+
+      const megabytes = width * height * 4 * iterations / (1024 * 1024)
+      results.push({
+        resolution: name,
+        conversion: conversion.name,
+        throughput: megabytes / (seconds + nanoseconds / 1e9)
+      })
+    }
+  }
+  console.log(JSON.stringify(results))
+  app.quit()
+})
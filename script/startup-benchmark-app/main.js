@@ -0,0 +1,11 @@
+const { app, BrowserWindow } = require('electron')
+const path = require('path')
+
+// Quit as soon as the window is painted, the timeline is complete by then.
+app.on('ready', () => {
+  // Lets the benchmark time ready from outside the process.
+  process.stdout.write('startup-benchmark-ready\n')
+  const window = new BrowserWindow({ show: false })
+  window.once('ready-to-show', () => app.quit())
+  window.loadFile(path.join(__dirname, 'index.html'))
+})
@@ -0,0 +1,9 @@
+const { app } = require('electron')
+
+// Quit as soon as the app is ready, so only the cost of getting there and of
+// the built-in modules loaded on the way is measured.
+app.on('ready', () => {
+  // Lets the benchmark time ready from outside the process.
+  process.stdout.write('startup-benchmark-ready\n')
+  app.quit()
+})
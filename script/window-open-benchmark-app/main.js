@@ -0,0 +1,37 @@
+const { app, BrowserWindow, session } = require('electron')
+const path = require('path')
+
+// Opens windows one after the other and prints the milliseconds each of them
+// took from construction to 'ready-to-show' as JSON.
+const [windows, spares] = process.argv.slice(2).map((arg) => parseInt(arg, 10))
+const webPreferences = { nodeIntegration: true }
+
+// Leaves time to the spare renderers to launch, like an app would between two
+// windows opened by the user.
+const pause = () => new Promise((resolve) => setTimeout(resolve, 1500))
+
+const openWindow = () => new Promise((resolve) => {
+  const start = process.hrtime()
+  const window = new BrowserWindow({ show: false, webPreferences })
+  window.once('ready-to-show', () => {
+    const [seconds, nanoseconds] = process.hrtime(start)
+    window.destroy()
+    resolve(seconds * 1000 + nanoseconds / 1e6)
+  })
+  window.loadFile(path.join(__dirname, 'index.html'))
+})
+
+app.on('window-all-closed', () => {})
+
+app.on('ready', async () => {
+  if (spares > 0) {
+    session.defaultSession.setSpareRendererCount(spares, webPreferences)
+  }
+  const timings = []
+  for (let i = 0; i < windows; i++) {
+    await pause()
+    timings.push(await openWindow())
+  }
+  console.log(JSON.stringify(timings))
+  app.quit()
+})
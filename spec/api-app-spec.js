@@ -831,6 +831,176 @@ describe('app module', () => {
     })
   })
 
+  describe('getProcessMemoryInfo() API', () => {
+    it('returns the memory of all running electron processes', async () => {
+      const processes = await app.getProcessMemoryInfo()
+      expect(processes).to.be.an('array').and.have.lengthOf.at.least(2)
+
+      for (const { pid, type, memory } of processes) {
+        expect(pid).to.be.above(0, 'pid is not > 0')
+        expect(type).to.be.a('string').that.is.not.empty()
+        expect(memory).to.have.own.property('private').that.is.a('number')
+        expect(memory).to.have.own.property('shared').that.is.a('number')
+      }
+
+      const browser = processes.find(({ type }) => type === 'Browser')
+      expect(browser.v8.usedHeapSize).to.be.above(0)
+      expect(browser).to.not.have.own.property('blink')
+
+      const renderer = processes.find(({ pid }) => pid === process.pid)
+      expect(renderer.type).to.equal('Tab')
+      expect(renderer.v8.spaces).to.have.own.property('new_space')
+      expect(renderer.v8.externalMemory).to.be.a('number')
+      expect(renderer.blink.partitionAlloc).to.be.above(0)
+      expect(renderer.blink.cache).to.have.own.property('images')
+    })
+  })
+
+  describe('startMemorySampler() API', () => {
+    const samplesPath = path.join(app.getPath('temp'), `electron-memory-samples-${process.pid}.json`)
+
+    afterEach(() => {
+      app.stopMemorySampler()
+      if (fs.existsSync(samplesPath)) fs.unlinkSync(samplesPath)
+    })
+
+    it('throws for an invalid interval', () => {
+      expect(() => {
+        app.startMemorySampler(samplesPath, { interval: 0 })
+      }).to.throw(/interval must be a positive number/)
+    })
+
+    it('appends the memory of the processes to the file', async () => {
+      app.startMemorySampler(samplesPath, { interval: 100 })
+      await new Promise((resolve) => setTimeout(resolve, 1000))
+      app.stopMemorySampler()
+      await new Promise((resolve) => setTimeout(resolve, 100))
+
+      const [header, ...rows] = fs.readFileSync(samplesPath, 'utf8').trim().split('\n').map((line) => JSON.parse(line))
+      expect(header.columns).to.include.members(['time', 'pid', 'type', 'private'])
+      expect(rows).to.have.lengthOf.at.least(2)
+      for (const row of rows) {
+        expect(row).to.have.lengthOf(header.columns.length)
+      }
+      const pid = header.columns.indexOf('pid')
+      expect(rows.map((row) => row[pid])).to.include(process.pid)
+    })
+  })
+
+  describe('--sampling-profiler-dir switch', () => {
+    const profileDir = path.join(app.getPath('temp'), `electron-sampling-profiler-${process.pid}`)
+
+    afterEach(() => {
+      if (fs.existsSync(profileDir)) {
+        for (const file of fs.readdirSync(profileDir)) {
+          fs.unlinkSync(path.join(profileDir, file))
+        }
+        fs.rmdirSync(profileDir)
+      }
+    })
+
+    const runApp = async (mode) => {
+      const appPath = path.join(__dirname, 'fixtures', 'api', 'sampling-profiler-app')
+      const electronPath = remote.getGlobal('process').execPath
+
+      const appProcess = ChildProcess.spawn(electronPath, [
+        `--sampling-profiler-dir=${profileDir}`,
+        appPath,
+        mode
+      ])
+      const [code] = await emittedOnce(appProcess, 'close')
+      expect(code).to.equal(0)
+
+      const files = fs.readdirSync(profileDir)
+      expect(files).to.have.lengthOf(1)
+      expect(files[0]).to.match(/^browser-\d+-\d+\.cpuprofile$/)
+      return JSON.parse(fs.readFileSync(path.join(profileDir, files[0]), 'utf8'))
+    }
+
+    it('writes a profile after a long task of the main process', async () => {
+      const profile = await runApp('task')
+      expect(profile.samples).to.have.lengthOf(profile.timeDeltas.length)
+      expect(profile.endTime).to.be.at.least(profile.startTime)
+      const functionNames = profile.nodes.map((node) => node.callFrame.functionName)
+      expect(functionNames).to.include('blockMainThread')
+    })
+
+    it('writes a profile after a long fs callback', async () => {
+      const profile = await runApp('fs')
+      const functionNames = profile.nodes.map((node) => node.callFrame.functionName)
+      expect(functionNames).to.include('blockMainThread')
+    })
+
+    it('writes a profile while the main process is hanging', async () => {
+      const profile = await runApp('hang')
+      const functionNames = profile.nodes.map((node) => node.callFrame.functionName)
+      expect(functionNames).to.include('hangMainThread')
+    })
+
+    it('merges the nodes of the same function', async () => {
+      const profile = await runApp('task')
+      const ids = new Set()
+      const children = profile.nodes.map((node) => node.children || [])
+      for (const child of [].concat(...children)) {
+        expect(ids.has(child)).to.be.false()
+        ids.add(child)
+      }
+      for (const node of profile.nodes) {
+        const names = (node.children || []).map((id) => {
+          const { callFrame } = profile.nodes.find((child) => child.id === id)
+          return JSON.stringify(callFrame)
+        })
+        expect(new Set(names).size).to.equal(names.length)
+      }
+    })
+  })
+
+  describe('startMainThreadWatchdog() API', () => {
+    afterEach(() => {
+      app.stopMainThreadWatchdog()
+    })
+
+    it('throws for an invalid threshold', () => {
+      expect(() => {
+        app.startMainThreadWatchdog({ threshold: 0 })
+      }).to.throw(/Thresholds must be positive/)
+    })
+
+    const runApp = async (mode) => {
+      const appPath = path.join(__dirname, 'fixtures', 'api', 'main-thread-watchdog-app')
+      const electronPath = remote.getGlobal('process').execPath
+
+      const appProcess = ChildProcess.spawn(electronPath, [appPath, mode])
+      let output = ''
+      appProcess.stdout.on('data', (data) => { output += data })
+      const [code] = await emittedOnce(appProcess, 'close')
+      expect(code).to.equal(0)
+      return JSON.parse(output)
+    }
+
+    it('emits main-thread-long-task with the JavaScript stack', async () => {
+      const details = await runApp('task')
+      expect(details.duration).to.be.at.least(500)
+      expect(details.postedFrom).to.have.own.property('fileName').that.is.a('string')
+      expect(details.postedFrom).to.have.own.property('lineNumber').that.is.a('number')
+      expect(details.stack).to.include('blockMainThread')
+      expect(details.crashDumped).to.be.false()
+    })
+
+    it('emits main-thread-long-task for a long fs callback', async () => {
+      const details = await runApp('fs')
+      expect(details.duration).to.be.at.least(500)
+      expect(details.postedFrom.functionName).to.equal('uv_run')
+      expect(details.stack).to.include('blockMainThread')
+    })
+
+    it('writes a minidump after crashDumpThreshold', async () => {
+      const details = await runApp('dump')
+      expect(details.duration).to.be.at.least(1000)
+      expect(details.crashDumped).to.be.true()
+    })
+  })
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus()
@@ -2439,6 +2439,41 @@ describe('BrowserWindow module', () => {
         done()
       }
     })
+    it('reuses pooled buffers and drops frames when they run out', (done) => {
+      const frames = []
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+      w.webContents.on('dom-ready', () => {
+        w.webContents.beginFrameSubscription({ bufferPoolSize: 1 }, (data) => {
+          frames.push(data)
+          if (frames.length > 1) return
+
+          expect(data).to.be.an.instanceOf(Uint8Array)
+          expect(data.length).to.not.equal(0)
+          // Keep the only buffer until another frame was dropped.
+          const waitForDrop = () => {
+            const metrics = w.webContents.getFrameSubscriptionMetrics()
+            if (metrics.droppedFrames === 0) {
+              w.webContents.invalidate()
+              return setTimeout(waitForDrop, 50)
+            }
+            expect(frames).to.have.lengthOf(1)
+            expect(metrics.freeBuffers).to.equal(0)
+            expect(w.webContents.releaseFrameBuffer(data)).to.be.true()
+            expect(w.webContents.releaseFrameBuffer(data)).to.be.false()
+            expect(w.webContents.getFrameSubscriptionMetrics().freeBuffers).to.equal(1)
+            w.webContents.endFrameSubscription()
+            expect(w.webContents.getFrameSubscriptionMetrics()).to.be.null()
+            done()
+          }
+          waitForDrop()
+        })
+      })
+    })
+    it('throws error when the options are invalid', () => {
+      expect(() => {
+        w.webContents.beginFrameSubscription({ frameRate: -1 }, () => {})
+      }).to.throw(/frameRate/)
+    })
   })
 
   describe('savePage method', () => {
@@ -3582,6 +3617,236 @@ describe('BrowserWindow module', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
       })
     })
+
+    describe('window.webContents.getPaintMetrics()', () => {
+      it('returns null for regular window', () => {
+        const c = new BrowserWindow({ show: false })
+        assert.strictEqual(c.webContents.getPaintMetrics(), null)
+        c.destroy()
+      })
+
+      it('only copies the damaged pixels of a frame', async () => {
+        const frameSize = 100 * 100 * 4
+        // Images handed back with their acknowledgement are released, so the
+        // bitmaps are reused without depending on the garbage collector.
+        w.webContents.setFramePacing({ mode: 'adaptive', maxPendingFrames: 1 })
+        w.webContents.on('paint', (event, rect, image) => {
+          w.webContents.acknowledgeFrame(image)
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        await emittedOnce(w.webContents, 'dom-ready')
+
+        const sample = async () => {
+          await new Promise(resolve => setTimeout(resolve, 500))
+          return w.webContents.getPaintMetrics()
+        }
+        const before = await sample()
+        const after = await sample()
+        w.webContents.removeAllListeners('paint')
+
+        const frames = after.frames - before.frames
+        const bytesPerFrame = (after.bytesCopied - before.bytesCopied) / frames
+        expect(frames).to.be.above(0)
+        expect(after.allocations).to.equal(before.allocations)
+        expect(bytesPerFrame).to.be.below(frameSize / 4)
+      })
+    })
+
+    describe('window.webContents.setPaintTileSize(tileSize)', () => {
+      it('reports the dirty rects and tiles of a frame', (done) => {
+        w.webContents.setPaintTileSize(25)
+        assert.strictEqual(w.webContents.getPaintTileSize(), 25)
+        w.webContents.once('paint', (event, rect, data, details) => {
+          expect(details.dirtyRects).to.be.an('array').that.is.not.empty()
+          for (const dirty of details.dirtyRects) {
+            expect(dirty.x).to.be.at.least(rect.x)
+            expect(dirty.y).to.be.at.least(rect.y)
+            expect(dirty.x + dirty.width).to.be.at.most(rect.x + rect.width)
+            expect(dirty.y + dirty.height).to.be.at.most(rect.y + rect.height)
+          }
+          const { tileSize, columns, rows, dirty } = details.dirtyTiles
+          const size = data.getSize()
+          expect(tileSize).to.equal(25)
+          expect(columns).to.equal(Math.ceil(size.width / 25))
+          expect(rows).to.equal(Math.ceil(size.height / 25))
+          expect(dirty.length).to.equal(columns * rows)
+          expect(dirty.includes(1)).to.be.true()
+          done()
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+      })
+
+      it('reports disjoint updates as separate rects', (done) => {
+        w.webContents.setPaintTileSize(16)
+        w.webContents.on('paint', (event, rect, data, details) => {
+          // The first frames repaint the whole page.
+          if (details.dirtyRects.length < 2) return
+          w.webContents.removeAllListeners('paint')
+          const [first, second] = details.dirtyRects
+          expect(first.x + first.width <= second.x ||
+                 first.y + first.height <= second.y).to.be.true()
+          for (const dirty of details.dirtyRects) {
+            expect(dirty.width * dirty.height).to.be.below(rect.width * rect.height)
+          }
+          done()
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering-corners.html'))
+      })
+
+      it('reports the redrawn rect as it is without tiles', (done) => {
+        w.webContents.on('paint', (event, rect, data, details) => {
+          expect(details).to.not.have.property('dirtyTiles')
+          expect(details.dirtyRects).to.deep.equal([rect])
+          w.webContents.removeAllListeners('paint')
+          done()
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering-corners.html'))
+      })
+
+      it('throws for a negative tile size', () => {
+        expect(() => {
+          w.webContents.setPaintTileSize(-1)
+        }).to.throw('tileSize must be a non-negative integer')
+      })
+    })
+
+    describe('window.webContents.setFramePacing(options)', () => {
+      it('throws for an invalid mode', () => {
+        expect(() => {
+          w.webContents.setFramePacing({ mode: 'bogus' })
+        }).to.throw("mode must be either 'fixed' or 'adaptive'")
+      })
+
+      it('waits for frames to be acknowledged', async () => {
+        w.webContents.setFramePacing({ mode: 'adaptive', maxPendingFrames: 1 })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        await emittedOnce(w.webContents, 'paint')
+        await new Promise(resolve => setTimeout(resolve, 300))
+
+        const metrics = w.webContents.getFramePacingMetrics()
+        expect(metrics.pendingFrames).to.equal(1)
+        expect(metrics.droppedFrames).to.be.above(0)
+
+        const paint = emittedOnce(w.webContents, 'paint')
+        w.webContents.acknowledgeFrame()
+        await paint
+        expect(w.webContents.getFramePacingMetrics().paintedFrames)
+          .to.be.above(metrics.paintedFrames)
+      })
+
+      it('only releases the image that is handed back', async () => {
+        w.webContents.setFramePacing({ mode: 'adaptive', maxPendingFrames: 2 })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        const [, , first] = await emittedOnce(w.webContents, 'paint')
+        const [, , second] = await emittedOnce(w.webContents, 'paint')
+        const other = remote.nativeImage.createFromBuffer(first.toBitmap(), first.getSize())
+
+        w.webContents.acknowledgeFrame()
+        expect(first.isEmpty()).to.be.false()
+        w.webContents.acknowledgeFrame(other)
+        expect(other.isEmpty()).to.be.false()
+        w.webContents.acknowledgeFrame(second)
+        expect(second.isEmpty()).to.be.true()
+        expect(first.isEmpty()).to.be.false()
+      })
+    })
+
+    describe('window.webContents.beginSharedMemoryPainting()', () => {
+      afterEach(() => {
+        if (w != null && !w.isDestroyed()) {
+          w.webContents.endSharedMemoryPainting()
+        }
+      })
+
+      it('throws for an invalid buffer count', () => {
+        expect(() => {
+          w.webContents.beginSharedMemoryPainting({ bufferCount: 0 })
+        }).to.throw('bufferCount must be between 1 and 16')
+      })
+
+      it('writes frames to shared memory buffers', (done) => {
+        w.webContents.beginSharedMemoryPainting({ bufferCount: 2 })
+        const frames = []
+        w.webContents.on('paint', () => {
+          done(new Error('paint should not be emitted'))
+        })
+        w.webContents.on('shared-memory-paint', (event, frame) => {
+          frames.push(frame)
+          if (frames.length === 1) {
+            expect(frame.buffersChanged).to.be.true()
+            const buffers = w.webContents.getSharedMemoryBuffers()
+            expect(buffers).to.have.lengthOf(2)
+            expect(buffers[0].width).to.equal(frame.size.width)
+            expect(buffers[0].stride).to.equal(frame.size.width * 4)
+            expect(buffers[0].buffer.length).to.equal(
+              buffers[0].stride * frame.size.height)
+          } else if (frames.length === 2) {
+            expect(frame.sequence).to.equal(frames[0].sequence + 1)
+            expect(frame.bufferIndex).to.not.equal(frames[0].bufferIndex)
+            // Both buffers are held now, so nothing is emitted until one
+            // of them is released.
+            setTimeout(() => {
+              expect(frames).to.have.lengthOf(2)
+              w.webContents.releaseSharedMemoryBuffer(frames[0].bufferIndex)
+            }, 200)
+          } else {
+            expect(frame.bufferIndex).to.equal(frames[0].bufferIndex)
+            w.webContents.removeAllListeners('paint')
+            w.webContents.removeAllListeners('shared-memory-paint')
+            done()
+          }
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+      })
+    })
+
+    describe('window.webContents.startRecording(options)', () => {
+      it('throws for an invalid codec', () => {
+        expect(() => {
+          w.webContents.startRecording({ codec: 'h264' })
+        }).to.throw("codec must be either 'vp8' or 'vp9'")
+      })
+
+      it('encodes the painted frames to a WebM file', async () => {
+        const file = path.join(os.tmpdir(), `electron-recording-${Date.now()}.webm`)
+        w.webContents.startRecording({ path: file, codec: 'vp8', bitrate: 500 })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        await emittedOnce(w.webContents, 'paint')
+        await new Promise(resolve => setTimeout(resolve, 300))
+
+        const stats = w.webContents.getRecordingStats()
+        expect(stats.encodedFrames).to.be.above(0)
+        expect(stats.keyframes).to.be.at.least(1)
+        expect(stats.averageLatency).to.be.at.least(0)
+
+        await new Promise(resolve => w.webContents.stopRecording(resolve))
+        expect(w.webContents.getRecordingStats()).to.be.null()
+        const header = fs.readFileSync(file).slice(0, 4)
+        fs.unlinkSync(file)
+        // EBML magic number of a WebM file.
+        expect(header.toString('hex')).to.equal('1a45dfa3')
+      })
+
+      it('does not encode more frames than the frame rate', async () => {
+        w.webContents.startRecording({ frameRate: 5 })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering-corners.html'))
+        await emittedOnce(w.webContents, 'paint')
+        await new Promise(resolve => setTimeout(resolve, 1000))
+
+        const stats = w.webContents.getRecordingStats()
+        expect(stats.encodedFrames + stats.queuedFrames).to.be.at.most(7)
+        await new Promise(resolve => w.webContents.stopRecording(resolve))
+      })
+
+      it('streams the WebM data when no path is given', async () => {
+        w.webContents.startRecording({ codec: 'vp9' })
+        const chunk = emittedOnce(w.webContents, 'recording-data')
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        const [, data] = await chunk
+        expect(data.slice(0, 4).toString('hex')).to.equal('1a45dfa3')
+        await new Promise(resolve => w.webContents.stopRecording(resolve))
+      })
+    })
   })
 })
 
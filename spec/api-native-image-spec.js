@@ -165,6 +165,79 @@ describe('nativeImage module', () => {
         { width: 538, height: 190, scaleFactor: 2.0 })
       expect(imageI.getSize()).to.deep.equal({ width: 269, height: 95 })
     })
+
+    it('copies the pixels of a bitmap buffer', () => {
+      const bitmap = Buffer.alloc(2 * 2 * 4, 0xff)
+      const image = nativeImage.createFromBuffer(bitmap, { width: 2, height: 2 })
+      bitmap.fill(0)
+      expect(image.toBitmap().equals(Buffer.alloc(2 * 2 * 4, 0xff))).to.be.true()
+    })
+
+    it('returns an empty image when the bitmap buffer is too small', () => {
+      const image = nativeImage.createFromBuffer(Buffer.alloc(2 * 2 * 4 - 1),
+        { width: 2, height: 2 })
+      expect(image.isEmpty()).to.be.true()
+    })
+  })
+
+  describe('createFromBuffer(buffer, { maxSize, rect })', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('decodes a scaled down image', () => {
+      const buffer = nativeImage.createFromPath(logoPath).toPNG()
+      const image = nativeImage.createFromBuffer(buffer, { maxSize: { width: 100, height: 100 } })
+      expect(image.getSize()).to.deep.equal({ width: 100, height: 35 })
+    })
+
+    it('decodes a region of the image', () => {
+      const buffer = nativeImage.createFromPath(logoPath).toPNG()
+      const rect = { x: 10, y: 20, width: 200, height: 100 }
+      const image = nativeImage.createFromBuffer(buffer, { rect })
+      expect(image.getSize()).to.deep.equal({ width: 200, height: 100 })
+    })
+
+    it('decodes exactly the region of JPEG images', () => {
+      const buffer = nativeImage.createFromPath(logoPath).toJPEG(90)
+      const rect = { x: 13, y: 7, width: 101, height: 53 }
+      const image = nativeImage.createFromBuffer(buffer, { rect })
+      expect(image.getSize()).to.deep.equal({ width: 101, height: 53 })
+      const full = nativeImage.createFromBuffer(buffer)
+      const expected = full.toBitmap({ rect })
+      const actual = image.toBitmap()
+      for (let i = 0; i < expected.length; i++) {
+        expect(Math.abs(actual[i] - expected[i])).to.be.at.most(8)
+      }
+    })
+
+    it('returns an empty image when the region can not be decoded', () => {
+      const buffer = nativeImage.createFromPath(logoPath).toPNG()
+      const rect = { x: 500, y: 0, width: 100, height: 100 }
+      expect(nativeImage.createFromBuffer(buffer, { rect }).isEmpty()).to.be.true()
+      const bitmap = Buffer.alloc(4 * 4 * 4)
+      const maxSize = { width: 2, height: 2 }
+      expect(nativeImage.createFromBuffer(bitmap, { width: 4, height: 4, maxSize }).isEmpty()).to.be.true()
+    })
+
+    it('scales JPEG images while decoding', () => {
+      const buffer = nativeImage.createFromPath(logoPath).toJPEG(90)
+      const image = nativeImage.createFromBuffer(buffer, { maxSize: { width: 67, height: 67 } })
+      expect(image.getSize()).to.deep.equal({ width: 67, height: 24 })
+    })
+  })
+
+  describe('createThumbnailFromPath(path, options)', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('resolves a thumbnail fitting in maxSize', async () => {
+      const image = await nativeImage.createThumbnailFromPath(logoPath, { maxSize: { width: 269, height: 269 } })
+      expect(image.getSize()).to.deep.equal({ width: 269, height: 95 })
+    })
+
+    it('resolves an empty image for invalid paths and regions', async () => {
+      expect((await nativeImage.createThumbnailFromPath('does-not-exist.png')).isEmpty()).to.be.true()
+      const rect = { x: 500, y: 0, width: 100, height: 100 }
+      expect((await nativeImage.createThumbnailFromPath(logoPath, { rect })).isEmpty()).to.be.true()
+    })
   })
 
   describe('createFromDataURL(dataURL)', () => {
@@ -270,6 +343,131 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('toBitmap(options)', () => {
+    // 2x2 opaque BGRA pixels followed by a half transparent row.
+    const pixels = Buffer.from([
+      10, 20, 30, 255, 50, 60, 70, 255,
+      90, 100, 110, 255, 130, 140, 150, 255,
+      64, 32, 16, 128, 64, 32, 16, 128
+    ])
+    const image = nativeImage.createFromBuffer(pixels, { width: 2, height: 3 })
+
+    it('converts between BGRA and RGBA', () => {
+      const bgra = image.toBitmap({ format: 'bgra' })
+      const rgba = image.toBitmap({ format: 'rgba' })
+      expect(rgba).to.have.lengthOf(bgra.length)
+      for (let i = 0; i < bgra.length; i += 4) {
+        expect(rgba[i]).to.equal(bgra[i + 2])
+        expect(rgba[i + 1]).to.equal(bgra[i + 1])
+        expect(rgba[i + 2]).to.equal(bgra[i])
+        expect(rgba[i + 3]).to.equal(bgra[i + 3])
+      }
+    })
+
+    it('unpremultiplies the pixels', () => {
+      const bitmap = image.toBitmap({ format: 'bgra', premultiplied: false })
+      expect(bitmap.slice(0, 16).equals(pixels.slice(0, 16))).to.be.true()
+      expect(bitmap[16]).to.be.within(127, 128)
+      expect(bitmap[17]).to.be.within(63, 64)
+      expect(bitmap[18]).to.be.within(31, 32)
+      expect(bitmap[19]).to.equal(128)
+    })
+
+    it('crops and downscales the pixels', () => {
+      const cropped = image.toBitmap({
+        format: 'bgra',
+        rect: { x: 1, y: 1, width: 1, height: 1 }
+      })
+      expect(cropped.equals(pixels.slice(12, 16))).to.be.true()
+
+      const scaled = image.toBitmap({
+        format: 'bgra',
+        rect: { x: 0, y: 0, width: 2, height: 2 },
+        width: 1
+      })
+      expect([...scaled]).to.deep.equal([70, 80, 90, 255])
+    })
+
+    it('throws for invalid options', () => {
+      expect(() => image.toBitmap({ format: 'argb' })).to.throw(/format/)
+      expect(() => {
+        image.toBitmap({ rect: { x: 1, y: 1, width: 2, height: 2 } })
+      }).to.throw(/rect/)
+      expect(() => image.toBitmap({ width: 4, height: 6 })).to.throw(/size/)
+    })
+
+    describe('on frames wider than a vector', () => {
+      // Odd sizes leave a remainder after the vector blocks of every row.
+      const width = 37
+      const height = 5
+      const frame = Buffer.alloc(width * height * 4)
+      let seed = 1
+      const random = (max) => {
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        return seed % (max + 1)
+      }
+      for (let i = 0; i < frame.length; i += 4) {
+        // Some blocks are opaque, the others premultiplied.
+        const alpha = (i / 4) % 8 < 4 ? 255 : random(255)
+        frame[i] = random(alpha)
+        frame[i + 1] = random(alpha)
+        frame[i + 2] = random(alpha)
+        frame[i + 3] = alpha
+      }
+      const image = nativeImage.createFromBuffer(frame, { width, height })
+
+      it('converts every pixel', () => {
+        const rgba = image.toBitmap({ format: 'rgba' })
+        for (let i = 0; i < frame.length; i += 4) {
+          expect([...rgba.slice(i, i + 4)]).to.deep.equal(
+            [frame[i + 2], frame[i + 1], frame[i], frame[i + 3]])
+        }
+
+        const unpremultiplied = image.toBitmap({ format: 'bgra', premultiplied: false })
+        for (let i = 0; i < frame.length; i += 4) {
+          const alpha = frame[i + 3]
+          for (let channel = 0; channel < 3; channel++) {
+            const expected = alpha === 0 ? 0
+              : Math.min(255, Math.floor(frame[i + channel] * 255 / alpha + 0.5))
+            expect(unpremultiplied[i + channel]).to.be.within(expected - 1, expected + 1)
+          }
+          expect(unpremultiplied[i + 3]).to.equal(alpha)
+        }
+      })
+
+      it('averages the pixels covered by each output pixel', () => {
+        const rect = { x: 1, y: 1, width: 35, height: 4 }
+        const outputWidth = 11
+        const outputHeight = 2
+        const scaled = image.toBitmap({
+          format: 'bgra', rect, width: outputWidth, height: outputHeight
+        })
+        expect(scaled).to.have.lengthOf(outputWidth * outputHeight * 4)
+
+        for (let y = 0; y < outputHeight; y++) {
+          const firstRow = Math.floor(y * rect.height / outputHeight)
+          const lastRow = Math.floor((y + 1) * rect.height / outputHeight)
+          for (let x = 0; x < outputWidth; x++) {
+            const firstColumn = Math.floor(x * rect.width / outputWidth)
+            const lastColumn = Math.floor((x + 1) * rect.width / outputWidth)
+            const count = (lastRow - firstRow) * (lastColumn - firstColumn)
+            for (let channel = 0; channel < 4; channel++) {
+              let sum = 0
+              for (let row = firstRow; row < lastRow; row++) {
+                for (let column = firstColumn; column < lastColumn; column++) {
+                  const offset = ((rect.y + row) * width + rect.x + column) * 4
+                  sum += frame[offset + channel]
+                }
+              }
+              const expected = Math.floor((sum + Math.floor(count / 2)) / count)
+              expect(scaled[(y * outputWidth + x) * 4 + channel]).to.equal(expected)
+            }
+          }
+        }
+      })
+    })
+  })
+
   describe('createFromPath(path)', () => {
     it('returns an empty image for invalid paths', () => {
       expect(nativeImage.createFromPath('').isEmpty())
@@ -332,6 +530,52 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('image cache', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    afterEach(() => {
+      nativeImage.setCacheLimit(32 * 1024 * 1024)
+      nativeImage.clearCache()
+    })
+
+    it('serves repeated loads of a path from the cache', () => {
+      nativeImage.clearCache()
+      const image = nativeImage.createFromPath(logoPath)
+      const before = nativeImage.getCacheStats()
+      expect(before.count).to.be.above(0)
+      expect(before.size).to.be.at.least(538 * 190 * 4)
+
+      const cached = nativeImage.createFromPath(logoPath)
+      const after = nativeImage.getCacheStats()
+      expect(after.hits).to.be.above(before.hits)
+      expect(after.misses).to.equal(before.misses)
+      expect(after.size).to.equal(before.size)
+      expect(cached.toBitmap()).to.deep.equal(image.toBitmap())
+    })
+
+    it('does not share the bitmap of cached images', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const cached = nativeImage.createFromPath(logoPath)
+      const original = cached.getBitmap()
+      image.getBitmap().fill(0)
+      expect(cached.getBitmap()).to.deep.equal(original)
+      expect(image.getBitmap()).to.deep.equal(original)
+    })
+
+    it('evicts entries to stay within the limit', () => {
+      nativeImage.createFromPath(logoPath)
+      nativeImage.setCacheLimit(1)
+      const stats = nativeImage.getCacheStats()
+      expect(stats.size).to.be.at.most(1)
+      expect(stats.limit).to.equal(1)
+      expect(nativeImage.createFromPath(logoPath).getSize()).to.deep.equal({ width: 538, height: 190 })
+    })
+
+    it('throws for a negative limit', () => {
+      expect(() => nativeImage.setCacheLimit(-1)).to.throw(/non-negative/)
+    })
+  })
+
   describe('createFromNamedImage(name)', () => {
     it('returns empty for invalid options', () => {
       const image = nativeImage.createFromNamedImage('totally_not_real')
@@ -407,6 +651,75 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('async methods', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('createFromPathAsync() matches createFromPath()', async () => {
+      const image = await nativeImage.createFromPathAsync(logoPath)
+      expect(image.isEmpty()).to.be.false()
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+      expect(image.toBitmap()).to.deep.equal(nativeImage.createFromPath(logoPath).toBitmap())
+    })
+
+    it('createFromPathAsync() resolves an empty image for invalid paths', async () => {
+      const image = await nativeImage.createFromPathAsync('does-not-exist.png')
+      expect(image.isEmpty()).to.be.true()
+    })
+
+    it('createFromBufferAsync() decodes encoded and bitmap buffers', async () => {
+      const source = nativeImage.createFromPath(logoPath)
+      const fromPNG = await nativeImage.createFromBufferAsync(source.toPNG())
+      expect(fromPNG.getSize()).to.deep.equal(source.getSize())
+
+      const bitmap = source.toBitmap()
+      const fromBitmap = await nativeImage.createFromBufferAsync(bitmap, source.getSize())
+      bitmap.fill(0)
+      expect(fromBitmap.toBitmap()).to.deep.equal(source.toBitmap())
+    })
+
+    it('toPNGAsync() and toJPEGAsync() encode the image', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const png = await image.toPNGAsync()
+      expect(nativeImage.createFromBuffer(png).getSize()).to.deep.equal(image.getSize())
+      const jpeg = await image.toJPEGAsync(80)
+      expect(nativeImage.createFromBuffer(jpeg).getSize()).to.deep.equal(image.getSize())
+    })
+
+    it('toPNGAsync() does not read the buffer of a bitmap image', async () => {
+      const source = nativeImage.createFromPath(logoPath)
+      const bitmap = source.toBitmap()
+      const image = nativeImage.createFromBuffer(bitmap, source.getSize())
+      const expected = nativeImage.createFromBuffer(image.toPNG()).toBitmap()
+
+      const png = image.toPNGAsync()
+      bitmap.fill(0)
+      const encoded = nativeImage.createFromBuffer(await png).toBitmap()
+      expect(encoded.equals(expected)).to.be.true()
+    })
+
+    it('resizeAsync() matches the size of resize()', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      for (const options of [{ width: 269 }, { height: 200 }, { width: 80, height: 65 }]) {
+        const resized = await image.resizeAsync(options)
+        expect(resized.getSize()).to.deep.equal(image.resize(options).getSize())
+      }
+      const empty = await image.resizeAsync({ width: 0, height: 0 })
+      expect(empty.isEmpty()).to.be.true()
+    })
+
+    it('createFromPathsAsync() resolves the images in order', async () => {
+      const paths = getImages({}).map(image => image.path)
+      const loaded = await nativeImage.createFromPathsAsync(paths)
+      expect(loaded.map(image => image.getSize())).to.deep.equal(
+        getImages({}).map(({ width, height }) => ({ width, height })))
+
+      const resized = await nativeImage.createFromPathsAsync([logoPath, logoPath], { width: 269 })
+      for (const image of resized) {
+        expect(image.getSize()).to.deep.equal({ width: 269, height: 95 })
+      }
+    })
+  })
+
   describe('crop(bounds)', () => {
     it('returns an empty image when called on an empty image', () => {
       expect(nativeImage.createEmpty().crop({ width: 1, height: 2, x: 0, y: 0 }).isEmpty())
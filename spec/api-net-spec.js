@@ -1,7 +1,9 @@
 const assert = require('assert')
 const { remote } = require('electron')
 const { ipcRenderer } = require('electron')
+const fs = require('fs')
 const http = require('http')
+const path = require('path')
 const url = require('url')
 const { net } = remote
 const { session } = remote
@@ -235,6 +237,152 @@ describe('net module', () => {
       }
       urlRequest.end()
     })
+
+    it('should apply back-pressure to chunked uploads', (done) => {
+      const requestUrl = '/requestUrl'
+      const bodyData = randomBuffer(kOneMegaByte)
+      server.on('request', (request, response) => {
+        const receivedChunks = []
+        switch (request.url) {
+          case requestUrl:
+            request.on('data', (chunk) => {
+              receivedChunks.push(chunk)
+            })
+            request.on('end', () => {
+              assert(Buffer.concat(receivedChunks).equals(bodyData))
+              response.end()
+            })
+            break
+          default:
+            handleUnexpectedURL(request, response)
+        }
+      })
+      const urlRequest = net.request({
+        method: 'POST',
+        url: `${server.url}${requestUrl}`,
+        highWaterMark: 16 * kOneKiloByte
+      })
+      assert.strictEqual(urlRequest.writableHighWaterMark, 16 * kOneKiloByte)
+      urlRequest.on('response', (response) => {
+        assert.strictEqual(response.statusCode, 200)
+        response.on('data', () => {})
+        response.on('end', () => {
+          assert(drainCount > 0)
+          done()
+        })
+        response.resume()
+      })
+      urlRequest.chunkedEncoding = true
+
+      let offset = 0
+      let drainCount = 0
+      const writeChunks = () => {
+        while (offset < bodyData.length) {
+          const chunk = bodyData.slice(offset, offset + kOneKiloByte)
+          offset += chunk.length
+          if (!urlRequest.write(chunk)) {
+            assert(urlRequest.writableLength >= 16 * kOneKiloByte)
+            urlRequest.once('drain', () => {
+              drainCount += 1
+              writeChunks()
+            })
+            return
+          }
+        }
+        urlRequest.end()
+      }
+      writeChunks()
+    })
+
+    it('should send a chunked upload again after a 307 redirect', (done) => {
+      const requestUrl = '/307'
+      const bodyData = randomBuffer(kOneKiloByte * 4)
+      server.on('request', (request, response) => {
+        const receivedChunks = []
+        request.on('data', (chunk) => {
+          receivedChunks.push(chunk)
+        })
+        switch (request.url) {
+          case '/307':
+            request.on('end', () => {
+              response.statusCode = '307'
+              response.setHeader('Location', '/200')
+              response.end()
+            })
+            break
+          case '/200':
+            assert.strictEqual(request.method, 'POST')
+            request.on('end', () => {
+              response.end(Buffer.concat(receivedChunks))
+            })
+            break
+          default:
+            handleUnexpectedURL(request, response)
+        }
+      })
+      const urlRequest = net.request({
+        method: 'POST',
+        url: `${server.url}${requestUrl}`
+      })
+      urlRequest.on('response', (response) => {
+        assert.strictEqual(response.statusCode, 200)
+        const receivedChunks = []
+        response.on('data', (chunk) => {
+          receivedChunks.push(chunk)
+        })
+        response.on('end', () => {
+          assert(Buffer.concat(receivedChunks).equals(bodyData))
+          done()
+        })
+        response.resume()
+      })
+      urlRequest.chunkedEncoding = true
+      for (let offset = 0; offset < bodyData.length; offset += kOneKiloByte) {
+        assert(urlRequest.write(bodyData.slice(offset, offset + kOneKiloByte)))
+      }
+      urlRequest.end()
+    })
+
+    it('should upload a file with writeFile', (done) => {
+      const requestUrl = '/requestUrl'
+      const filePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+      const fileData = fs.readFileSync(filePath)
+      server.on('request', (request, response) => {
+        const receivedChunks = []
+        switch (request.url) {
+          case requestUrl:
+            assert.strictEqual(request.headers['content-length'],
+              String(fileData.length + 4))
+            request.on('data', (chunk) => {
+              receivedChunks.push(chunk)
+            })
+            request.on('end', () => {
+              const receivedData = Buffer.concat(receivedChunks)
+              assert.strictEqual(receivedData.slice(0, 4).toString(), 'head')
+              assert(receivedData.slice(4).equals(fileData))
+              response.end()
+            })
+            break
+          default:
+            handleUnexpectedURL(request, response)
+        }
+      })
+      const urlRequest = net.request({
+        method: 'POST',
+        url: `${server.url}${requestUrl}`
+      })
+      urlRequest.on('response', (response) => {
+        assert.strictEqual(response.statusCode, 200)
+        response.on('data', () => {})
+        response.on('end', () => {
+          done()
+        })
+        response.resume()
+      })
+      urlRequest.write('head')
+      assert(urlRequest.writeFile(filePath))
+      urlRequest.end()
+    })
   })
 
   describe('ClientRequest API', () => {
@@ -1240,6 +1388,85 @@ describe('net module', () => {
       }
     })
 
+    it('should throw if given an invalid priority option', () => {
+      assert.throws(() => {
+        net.request({
+          url: `${server.url}/requestUrl`,
+          priority: 'urgent'
+        })
+      }, /priority should be one of/)
+    })
+
+    it('should limit the number of concurrent requests per host', (done) => {
+      const customSession = session.fromPartition('request-limits-per-host')
+      customSession.setRequestLimits({ maxRequestsPerHost: 1 })
+      let activeRequests = 0
+      let maxActiveRequests = 0
+      server.on('request', (request, response) => {
+        activeRequests++
+        maxActiveRequests = Math.max(maxActiveRequests, activeRequests)
+        setTimeout(() => {
+          activeRequests--
+          response.end()
+        }, 50)
+      })
+      let pendingResponses = 3
+      for (let i = 0; i < pendingResponses; ++i) {
+        const urlRequest = net.request({
+          url: `${server.url}/request${i}`,
+          session: customSession
+        })
+        urlRequest.on('response', (response) => {
+          response.on('data', () => {})
+          response.on('end', () => {
+            if (--pendingResponses > 0) return
+            assert.strictEqual(maxActiveRequests, 1)
+            customSession.getRequestQueueMetrics((metrics) => {
+              assert.strictEqual(metrics.activeRequests, 0)
+              assert.strictEqual(metrics.queuedRequests, 0)
+              assert.strictEqual(metrics.startedRequests, 3)
+              assert.strictEqual(metrics.delayedRequests, 2)
+              assert(metrics.maxQueueTime > 0)
+              assert(metrics.totalQueueTime >= metrics.maxQueueTime)
+              done()
+            })
+          })
+          response.resume()
+        })
+        urlRequest.end()
+      }
+    })
+
+    it('should start queued requests by order of priority', (done) => {
+      const customSession = session.fromPartition('request-limits-priority')
+      customSession.setRequestLimits({ maxRequests: 1 })
+      const receivedUrls = []
+      server.on('request', (request, response) => {
+        receivedUrls.push(request.url)
+        setTimeout(() => response.end(), 50)
+      })
+      const priorities = ['lowest', 'idle', 'low', 'highest']
+      let pendingResponses = priorities.length
+      for (const priority of priorities) {
+        const urlRequest = net.request({
+          url: `${server.url}/${priority}`,
+          session: customSession,
+          priority
+        })
+        urlRequest.on('response', (response) => {
+          response.on('data', () => {})
+          response.on('end', () => {
+            if (--pendingResponses > 0) return
+            assert.deepStrictEqual(receivedUrls,
+              ['/lowest', '/highest', '/low', '/idle'])
+            done()
+          })
+          response.resume()
+        })
+        urlRequest.end()
+      }
+    })
+
     it('should be able to create a request with options', (done) => {
       const requestUrl = '/'
       const customHeaderName = 'Some-Custom-Header-Name'
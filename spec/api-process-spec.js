@@ -12,6 +12,23 @@ describe('process module', () => {
     })
   })
 
+  describe('process.getStartupTimeline()', () => {
+    it('returns the startup marks of the renderer process', () => {
+      const names = process.getStartupTimeline().map(mark => mark.name)
+      expect(names).to.include.members(['load-environment', 'environment-loaded'])
+    })
+
+    it('returns the startup marks of the main process in order', () => {
+      const timeline = remote.process.getStartupTimeline()
+      const names = timeline.map(mark => mark.name)
+      expect(names).to.include.members(['main-delegate', 'ready', 'first-window-created'])
+      for (let i = 1; i < timeline.length; i++) {
+        expect(timeline[i].time).to.be.at.least(timeline[i - 1].time)
+      }
+      expect(names.indexOf('ready')).to.be.above(names.indexOf('environment-loaded'))
+    })
+  })
+
   describe('process.getCPUUsage()', () => {
     it('returns a cpu usage object', () => {
       const cpuUsage = process.getCPUUsage()
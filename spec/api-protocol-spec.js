@@ -206,6 +206,110 @@ describe('protocol module', () => {
     })
   })
 
+  describe('protocol response cache', () => {
+    function request (url, type = 'GET') {
+      return new Promise((resolve, reject) => {
+        $.ajax({
+          url,
+          type,
+          success: (data, status, request) => resolve({ data, request }),
+          error: (xhr, errorType, error) => reject(error)
+        })
+      })
+    }
+
+    it('serves responses with a max-age without calling the handler', (done) => {
+      let handlerCalls = 0
+      const handler = (request, callback) => {
+        handlerCalls += 1
+        callback({
+          data: text,
+          headers: { 'Cache-Control': 'max-age=60' }
+        })
+      }
+      protocol.registerStringProtocol(protocolName, handler, async (error) => {
+        if (error) return done(error)
+        try {
+          const first = await request(protocolName + '://fake-host/cached')
+          assert.strictEqual(first.data, text)
+          assert.strictEqual(first.request.getResponseHeader('Cache-Control'), 'max-age=60')
+          const second = await request(protocolName + '://fake-host/cached')
+          assert.strictEqual(second.data, text)
+          assert.strictEqual(handlerCalls, 1)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+
+    it('does not cache responses without Cache-Control', (done) => {
+      let handlerCalls = 0
+      const handler = (request, callback) => {
+        handlerCalls += 1
+        callback({ data: text })
+      }
+      protocol.registerStringProtocol(protocolName, handler, async (error) => {
+        if (error) return done(error)
+        try {
+          await request(protocolName + '://fake-host/uncached')
+          await request(protocolName + '://fake-host/uncached')
+          assert.strictEqual(handlerCalls, 2)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+
+    it('does not cache responses with no-store', (done) => {
+      let handlerCalls = 0
+      const handler = (request, callback) => {
+        handlerCalls += 1
+        callback({
+          data: Buffer.from(text),
+          headers: { 'Cache-Control': 'max-age=60, no-store' }
+        })
+      }
+      protocol.registerBufferProtocol(protocolName, handler, async (error) => {
+        if (error) return done(error)
+        try {
+          await request(protocolName + '://fake-host/no-store')
+          await request(protocolName + '://fake-host/no-store')
+          assert.strictEqual(handlerCalls, 2)
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+
+    it('only caches GET requests', (done) => {
+      const methods = []
+      const handler = (request, callback) => {
+        methods.push(request.method)
+        callback({
+          data: request.method,
+          headers: { 'Cache-Control': 'max-age=60' }
+        })
+      }
+      protocol.registerStringProtocol(protocolName, handler, async (error) => {
+        if (error) return done(error)
+        try {
+          const url = protocolName + '://fake-host/methods'
+          assert.strictEqual((await request(url, 'POST')).data, 'POST')
+          assert.strictEqual((await request(url, 'GET')).data, 'GET')
+          assert.strictEqual((await request(url, 'POST')).data, 'POST')
+          assert.strictEqual((await request(url, 'GET')).data, 'GET')
+          assert.deepStrictEqual(methods, ['POST', 'GET', 'POST'])
+          done()
+        } catch (e) {
+          done(e)
+        }
+      })
+    })
+  })
+
   describe('protocol.registerBufferProtocol', () => {
     const buffer = Buffer.from(text)
     it('sends Buffer as response', (done) => {
@@ -386,6 +490,74 @@ describe('protocol module', () => {
     })
   })
 
+  describe('protocol.registerDirectoryProtocol', () => {
+    const fixtures = path.resolve(__dirname, 'fixtures')
+    const filePath = path.join(fixtures, 'asar', 'a.asar', 'file1')
+    const fileContent = require('fs').readFileSync(filePath)
+
+    it('throws when root is not an absolute path', () => {
+      assert.throws(() => {
+        protocol.registerDirectoryProtocol(protocolName, { root: 'relative' })
+      }, /root must be an absolute path/)
+    })
+
+    it('serves files from an asar archive', (done) => {
+      const options = { root: path.join(fixtures, 'asar', 'a.asar') }
+      protocol.registerDirectoryProtocol(protocolName, options, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host/file1',
+          cache: false,
+          success: (data, status, request) => {
+            assert.strictEqual(data, String(fileContent))
+            assert(request.getResponseHeader('ETag'))
+            assert.strictEqual(request.getResponseHeader('Access-Control-Allow-Origin'), '*')
+            done()
+          },
+          error: (xhr, errorType, error) => done(error)
+        })
+      })
+    })
+
+    it('applies rewrites and mime type overrides', (done) => {
+      const options = {
+        root: path.join(fixtures, 'pages'),
+        rewrites: [{ from: '/renamed/', to: '/' }],
+        mimeTypes: { '.html': 'text/plain' }
+      }
+      protocol.registerDirectoryProtocol(protocolName, options, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host/renamed/a.html',
+          cache: false,
+          success: (data, status, request) => {
+            const content = require('fs').readFileSync(path.join(fixtures, 'pages', 'a.html'))
+            assert.strictEqual(data, String(content))
+            assert.strictEqual(request.getResponseHeader('Content-Type'), 'text/plain')
+            done()
+          },
+          error: (xhr, errorType, error) => done(error)
+        })
+      })
+    })
+
+    it('does not serve files outside of the root', (done) => {
+      const options = { root: path.join(fixtures, 'asar') }
+      protocol.registerDirectoryProtocol(protocolName, options, (error) => {
+        if (error) return done(error)
+        $.ajax({
+          url: protocolName + '://fake-host/%2E%2E/api-protocol-spec.js',
+          cache: false,
+          success: () => done('request succeeded but it should not'),
+          error: (xhr, errorType) => {
+            assert.strictEqual(errorType, 'error')
+            done()
+          }
+        })
+      })
+    })
+  })
+
   describe('protocol.registerHttpProtocol', () => {
     it('sends url as response', (done) => {
       const server = http.createServer((req, res) => {
@@ -786,6 +786,83 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.getNetworkMetrics(callback)', () => {
+    let server = null
+
+    beforeEach((done) => {
+      server = http.createServer((req, res) => {
+        res.end('metrics')
+      })
+      server.listen(0, '127.0.0.1', done)
+    })
+
+    afterEach(() => {
+      server.close()
+      server = null
+    })
+
+    function issueRequest (ses, callback) {
+      const request = net.request({
+        url: `${url}:${server.address().port}`,
+        session: ses
+      })
+      request.on('response', (response) => {
+        response.on('data', () => {})
+        response.on('end', callback)
+        response.resume()
+      })
+      request.end()
+    }
+
+    it('returns null when metrics are not enabled', (done) => {
+      const ses = session.fromPartition('network-metrics-disabled')
+      ses.getNetworkMetrics((metrics) => {
+        assert.strictEqual(metrics, null)
+        done()
+      })
+    })
+
+    it('aggregates the timing of completed requests', (done) => {
+      const ses = session.fromPartition('network-metrics')
+      ses.enableNetworkMetrics()
+      issueRequest(ses, () => {
+        ses.getNetworkMetrics((metrics) => {
+          assert.strictEqual(metrics.total.requests, 1)
+          assert.strictEqual(metrics.total.errors, 0)
+          assert.strictEqual(metrics.total.decodedBytes, 'metrics'.length)
+          assert.strictEqual(metrics.total.duration.count, 1)
+          assert.strictEqual(metrics.total.duration.histogram.length,
+            metrics.bucketLimits.length + 1)
+          assert.strictEqual(metrics.hosts['127.0.0.1'].requests, 1)
+          ses.disableNetworkMetrics()
+          done()
+        })
+      })
+    })
+
+    it('keeps binary records of the last requests', (done) => {
+      const ses = session.fromPartition('network-metrics-records')
+      ses.enableNetworkMetrics({ recordBufferSize: 1 })
+      issueRequest(ses, () => {
+        issueRequest(ses, () => {
+          ses.getNetworkMetrics((metrics) => {
+            assert.strictEqual(metrics.bufferedRecords, 1)
+            assert.strictEqual(metrics.droppedRecords, 1)
+            ses.takeNetworkMetricsRecords((records) => {
+              assert.strictEqual(records.length, 56)
+              assert.strictEqual(records.readUInt32LE(8),
+                metrics.hosts['127.0.0.1'].hash)
+              assert.strictEqual(records.readUInt16LE(16), 200)
+              assert.strictEqual(records.readUInt32LE(52), 'metrics'.length)
+              ses.disableNetworkMetrics()
+              done()
+            })
+          })
+        })
+      })
+    })
+  })
+
   describe('ses.setPermissionRequestHandler(handler)', () => {
     it('cancels any pending requests when cleared', (done) => {
       const ses = session.fromPartition('permissionTest')
@@ -805,4 +882,65 @@ describe('session module', () => {
       document.body.appendChild(webview)
     })
   })
+
+  describe('ses.setSpareRendererCount(count[, webPreferences])', () => {
+    const partition = 'spare-renderer'
+    const webPreferences = { nodeIntegration: true }
+    let ses = null
+    let spareWindow = null
+
+    beforeEach(() => {
+      ses = session.fromPartition(partition)
+    })
+
+    afterEach(() => {
+      ses.setSpareRendererCount(0)
+      return closeWindow(spareWindow, { assertSingleWindow: false }).then(() => { spareWindow = null })
+    })
+
+    const isSpareRenderer = (options) => {
+      spareWindow = new BrowserWindow({
+        show: false,
+        webPreferences: Object.assign({ partition }, options)
+      })
+      return new Promise((resolve) => {
+        spareWindow.webContents.once('did-finish-load', resolve)
+        spareWindow.loadFile(path.join(fixtures, 'api', 'blank.html'))
+      }).then(() => {
+        return spareWindow.webContents.executeJavaScript(`process.argv.includes('--spare-renderer')`)
+      })
+    }
+
+    it('launches and shuts down the spare renderers', () => {
+      ses.setSpareRendererCount(1, webPreferences)
+      assert.strictEqual(ses.getSpareRendererCount(), 1)
+      ses.setSpareRendererCount(0)
+      assert.strictEqual(ses.getSpareRendererCount(), 0)
+    })
+
+    it('throws for a negative count', () => {
+      assert.throws(() => ses.setSpareRendererCount(-1), /count/)
+    })
+
+    it('uses a spare renderer for windows with the same preferences', () => {
+      ses.setSpareRendererCount(1, webPreferences)
+      return isSpareRenderer(webPreferences).then((result) => {
+        assert.strictEqual(result, true)
+      })
+    })
+
+    it('does not use a spare renderer for windows with other preferences', () => {
+      ses.setSpareRendererCount(1, webPreferences)
+      return isSpareRenderer({ nodeIntegration: true, contextIsolation: true }).then((result) => {
+        assert.strictEqual(result, false)
+      })
+    })
+
+    it('does not use a spare renderer when preferences without switches differ', () => {
+      ses.setSpareRendererCount(1, webPreferences)
+      return isSpareRenderer({ nodeIntegration: true, disablePopups: true }).then((result) => {
+        assert.strictEqual(result, false)
+      })
+    })
+  })
 })
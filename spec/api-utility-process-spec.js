@@ -0,0 +1,92 @@
+const chai = require('chai')
+const dirtyChai = require('dirty-chai')
+const path = require('path')
+const { remote } = require('electron')
+const { utilityProcess } = remote
+
+const { expect } = chai
+chai.use(dirtyChai)
+
+describe('utilityProcess module', () => {
+  const fixture = path.join(__dirname, 'fixtures', 'api', 'utility-process', 'echo.js')
+  let child = null
+
+  afterEach(() => {
+    if (child) child.kill()
+    child = null
+  })
+
+  describe('utilityProcess.fork', () => {
+    it('throws when the module path is not absolute', () => {
+      expect(() => {
+        utilityProcess.fork('echo.js')
+      }).to.throw(/modulePath must be an absolute path/)
+    })
+
+    it('runs the module in a utility process', (done) => {
+      child = utilityProcess.fork(fixture)
+      child.once('message', (event, type) => {
+        expect(type).to.equal('utility')
+        done()
+      })
+      child.postMessage('type')
+    })
+
+    it('passes the arguments to the module', (done) => {
+      child = utilityProcess.fork(fixture, ['--foo', 'bar'])
+      child.once('message', (event, argv) => {
+        expect(argv).to.deep.equal(['--foo', 'bar'])
+        done()
+      })
+      child.postMessage('argv')
+    })
+  })
+
+  describe('UtilityProcess.postMessage', () => {
+    it('clones structured values', (done) => {
+      const message = { a: [1, 2, 3], b: { c: 'd' }, e: null }
+      child = utilityProcess.fork(fixture)
+      child.once('message', (event, echoed) => {
+        expect(echoed).to.deep.equal(message)
+        done()
+      })
+      child.postMessage(message)
+    })
+
+    it('transfers ArrayBuffers', (done) => {
+      const { echoArrayBuffer } = remote.require(path.join(__dirname, 'fixtures', 'api', 'utility-process', 'transfer.js'))
+      child = utilityProcess.fork(fixture)
+      // Large enough to be passed in shared memory.
+      echoArrayBuffer(child, 1024 * 1024, ({ detachedLength, matches }) => {
+        expect(detachedLength).to.equal(0)
+        expect(matches).to.be.true()
+        done()
+      })
+    })
+
+    it('throws when the value can not be cloned', () => {
+      child = utilityProcess.fork(fixture)
+      expect(() => {
+        child.postMessage(() => {})
+      }).to.throw()
+    })
+  })
+
+  describe('UtilityProcess.kill', () => {
+    it('emits exit', (done) => {
+      child = utilityProcess.fork(fixture)
+      expect(child.isRunning()).to.be.true()
+      child.once('exit', () => {
+        expect(child.isRunning()).to.be.false()
+        done()
+      })
+      child.kill()
+    })
+
+    it('emits exit when the module exits', (done) => {
+      child = utilityProcess.fork(fixture)
+      child.once('exit', () => done())
+      child.postMessage('exit')
+    })
+  })
+})
@@ -0,0 +1,10 @@
+const { app } = require('electron')
+
+// Print the Electron bindings that were initialized before the app is ready.
+app.on('ready', function () {
+  const bindings = process.moduleLoadList
+    .filter(name => name.startsWith('Binding atom_'))
+    .map(name => name.substr('Binding '.length))
+  console.log(JSON.stringify(bindings))
+  app.quit()
+})
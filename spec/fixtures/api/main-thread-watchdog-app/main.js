@@ -0,0 +1,34 @@
+const { app, crashReporter } = require('electron')
+const fs = require('fs')
+
+const mode = process.argv[process.argv.length - 1]
+
+const blockMainThread = (duration) => {
+  const end = Date.now() + duration
+  while (Date.now() < end) {}
+}
+
+app.on('main-thread-long-task', (event, details) => {
+  process.stdout.write(JSON.stringify(details))
+  app.quit()
+})
+
+app.on('ready', () => {
+  if (mode === 'fs') {
+    app.startMainThreadWatchdog({ threshold: 300 })
+    fs.readFile(__filename, () => blockMainThread(500))
+  } else if (mode === 'dump') {
+    crashReporter.start({
+      productName: 'Zombies',
+      companyName: 'Umbrella Corporation',
+      submitURL: 'http://127.0.0.1',
+      uploadToServer: false,
+      ignoreSystemCrashHandler: true
+    })
+    app.startMainThreadWatchdog({ threshold: 300, crashDumpThreshold: 400 })
+    setTimeout(() => blockMainThread(1000), 100)
+  } else {
+    app.startMainThreadWatchdog({ threshold: 300 })
+    setTimeout(() => blockMainThread(500), 100)
+  }
+})
@@ -0,0 +1,44 @@
+const { app } = require('electron')
+const fs = require('fs')
+
+const profileDir = process.argv
+  .find((arg) => arg.startsWith('--sampling-profiler-dir='))
+  .split('=')[1]
+const mode = process.argv[process.argv.length - 1]
+
+const blockMainThread = (duration) => {
+  const end = Date.now() + duration
+  while (Date.now() < end) {}
+}
+
+// Only returns once the profile was written while the task is running.
+const hangMainThread = () => {
+  const end = Date.now() + 10000
+  while (Date.now() < end) {
+    if (fs.existsSync(profileDir) && fs.readdirSync(profileDir).length > 0) {
+      return
+    }
+  }
+  app.exit(1)
+}
+
+app.on('ready', () => {
+  if (mode === 'fs') {
+    fs.readFile(__filename, () => {
+      blockMainThread(800)
+      // Leave time to write the profile.
+      setTimeout(() => app.quit(), 1000)
+    })
+  } else if (mode === 'hang') {
+    setTimeout(() => {
+      hangMainThread()
+      app.quit()
+    }, 100)
+  } else {
+    setTimeout(() => {
+      blockMainThread(800)
+      // Leave time to write the profile.
+      setTimeout(() => app.quit(), 1000)
+    }, 100)
+  }
+})
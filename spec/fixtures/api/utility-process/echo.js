@@ -0,0 +1,13 @@
+process.parentPort.on('message', (event, message) => {
+  if (message === 'argv') {
+    process.parentPort.postMessage(process.argv.slice(2))
+  } else if (message === 'type') {
+    process.parentPort.postMessage(process.type)
+  } else if (message === 'exit') {
+    process.exit(0)
+  } else if (message instanceof ArrayBuffer) {
+    process.parentPort.postMessage(message, [message])
+  } else {
+    process.parentPort.postMessage(message)
+  }
+})
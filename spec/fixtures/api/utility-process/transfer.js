@@ -0,0 +1,16 @@
+// Runs in the main process, so the transferred ArrayBuffer is created and
+// detached there rather than copied through the remote module.
+exports.echoArrayBuffer = (child, byteLength, callback) => {
+  const buffer = new ArrayBuffer(byteLength)
+  const bytes = new Uint8Array(buffer)
+  for (let i = 0; i < byteLength; i++) bytes[i] = i % 251
+  child.once('message', (event, echoed) => {
+    const echoedBytes = new Uint8Array(echoed)
+    let matches = echoed instanceof ArrayBuffer && echoed.byteLength === byteLength
+    for (let i = 0; matches && i < byteLength; i++) {
+      matches = echoedBytes[i] === i % 251
+    }
+    callback({ detachedLength: buffer.byteLength, matches })
+  })
+  child.postMessage(buffer, [buffer])
+}
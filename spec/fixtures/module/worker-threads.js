@@ -0,0 +1,15 @@
+/* global Atomics */
+
+const { parentPort, workerData } = require('worker_threads')
+
+if (workerData && workerData.buffer) {
+  // Add to the shared counter and wake up the parent.
+  const counter = new Int32Array(workerData.buffer)
+  Atomics.add(counter, 0, workerData.value)
+  Atomics.notify(counter, 0)
+  parentPort.postMessage('done')
+} else {
+  parentPort.once('message', (message) => {
+    parentPort.postMessage({ echo: message, type: process.type || null })
+  })
+}
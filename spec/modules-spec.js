@@ -1,4 +1,5 @@
 const assert = require('assert')
+const ChildProcess = require('child_process')
 const Module = require('module')
 const path = require('path')
 const fs = require('fs')
@@ -177,4 +178,35 @@ describe('modules support', () => {
       })
     })
   })
+
+  describe('built-in modules', () => {
+    it('are only initialized when the app uses them', function (done) {
+      // Console output of GUI apps is not captured on Windows.
+      if (process.platform === 'win32') return this.skip()
+
+      const appPath = path.join(fixtures, 'api', 'lazy-modules-app')
+      const appProcess = ChildProcess.spawn(remote.process.execPath, [appPath])
+      let output = ''
+      appProcess.stdout.on('data', data => { output += data })
+      appProcess.on('close', () => {
+        const bindings = JSON.parse(output)
+        assert(bindings.includes('atom_browser_app'))
+        for (const name of [
+          'atom_browser_desktop_capturer',
+          'atom_browser_global_shortcut',
+          'atom_browser_menu',
+          'atom_browser_protocol',
+          'atom_browser_render_process_preferences',
+          'atom_browser_session',
+          'atom_browser_system_preferences',
+          'atom_browser_tray',
+          'atom_browser_web_contents',
+          'atom_browser_window'
+        ]) {
+          assert(!bindings.includes(name), `${name} was initialized`)
+        }
+        done()
+      })
+    })
+  })
 })
@@ -1,3 +1,5 @@
+/* global Atomics, SharedArrayBuffer */
+
 const assert = require('assert')
 const ChildProcess = require('child_process')
 const { expect } = require('chai')
@@ -184,6 +186,32 @@ describe('node feature', () => {
       it('can be promisified', (done) => {
         remote.getGlobal('setTimeoutPromisified')(0).then(done)
       })
+
+      it('runs before a longer timer started earlier', (done) => {
+        const longTimer = remote.getGlobal('setTimeout')(() => {}, 60000)
+        const start = Date.now()
+        remote.getGlobal('setTimeout')(() => {
+          remote.getGlobal('clearTimeout')(longTimer)
+          const elapsed = Date.now() - start
+          done(elapsed < 1000 ? undefined : new Error(`Timer ran after ${elapsed}ms`))
+        }, 50)
+      })
+    })
+
+    describe('I/O started under Chromium event loop in browser process', () => {
+      it('is dispatched without waiting for other events', (done) => {
+        const server = remote.require('net').createServer()
+        let client = null
+        server.once('connection', (socket) => {
+          socket.destroy()
+          client.destroy()
+          server.close()
+          done()
+        })
+        server.listen(0, '127.0.0.1', () => {
+          client = require('net').connect(server.address().port, '127.0.0.1')
+        })
+      })
     })
 
     describe('setInterval called under Chromium event loop in browser process', () => {
@@ -206,6 +234,47 @@ describe('node feature', () => {
     })
   })
 
+  describe('worker_threads', () => {
+    const workerPath = path.join(fixtures, 'module', 'worker-threads.js')
+
+    it('runs workers in the renderer process', (done) => {
+      const { Worker } = require('worker_threads')
+      const worker = new Worker(workerPath)
+      worker.once('message', (message) => {
+        expect(message).to.deep.equal({ echo: 'hello', type: null })
+        worker.terminate(() => done())
+      })
+      worker.postMessage('hello')
+    })
+
+    it('shares memory with workers in the renderer process', (done) => {
+      const { Worker } = require('worker_threads')
+      const buffer = new SharedArrayBuffer(4)
+      const counter = new Int32Array(buffer)
+      let finished = 0
+      for (let i = 1; i <= 4; i++) {
+        const worker = new Worker(workerPath, { workerData: { buffer, value: i } })
+        worker.once('message', () => {
+          if (++finished === 4) {
+            expect(Atomics.load(counter, 0)).to.equal(10)
+            done()
+          }
+        })
+      }
+    })
+
+    it('runs workers in the main process', (done) => {
+      const { Worker } = remote.require('worker_threads')
+      const worker = new Worker(workerPath)
+      worker.once('message', (message) => {
+        expect(message.echo).to.equal('hello')
+        worker.terminate()
+        done()
+      })
+      worker.postMessage('hello')
+    })
+  })
+
   describe('inspector', () => {
     let child = null
 